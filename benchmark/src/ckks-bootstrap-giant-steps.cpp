@@ -0,0 +1,128 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+
+/*
+ * Compares the CKKS bootstrapping time with the giant steps of the linear
+ * transforms accumulated in the extended basis Q_l*P (one ModDown per giant
+ * step) against the single-hoisted giant steps of earlier releases, which bring
+ * both elements of every inner sum down to Q_l. Build the library with
+ * BOOTSTRAPTIMING defined to also get the encoding and decoding times.
+ */
+
+#include "openfhe.h"
+
+#include "benchmark/benchmark.h"
+
+#include <complex>
+#include <vector>
+
+using namespace lbcrypto;
+
+struct BootstrapSetting {
+    uint32_t ringDim;
+    uint32_t slots;
+    std::vector<uint32_t> levelBudget;
+};
+
+// add {1 << 16, 1 << 15, {3, 3}} for timings at a realistic ring dimension; it takes much longer
+static std::vector<BootstrapSetting> settings({{1 << 12, 1 << 11, {4, 4}}, {1 << 12, 1 << 11, {1, 1}}});
+
+static void GiantStepArguments(benchmark::internal::Benchmark* b) {
+    for (size_t setting = 0; setting < settings.size(); ++setting) {
+        b->ArgNames({"setting", "extended"})->Args({int64_t(setting), 0});
+        b->ArgNames({"setting", "extended"})->Args({int64_t(setting), 1});
+    }
+}
+
+void CKKSrns_EvalBootstrap(benchmark::State& state) {
+    const BootstrapSetting& setting = settings[state.range(0)];
+    // switches between the two implementations of the giant steps
+    FHECKKSRNS::SetGiantStepsInExtendedBasis(state.range(1) != 0);
+
+#if NATIVEINT == 128 && !defined(__EMSCRIPTEN__)
+    ScalingTechnique rescaleTech = FIXEDMANUAL;
+    usint dcrtBits               = 78;
+    usint firstMod               = 89;
+#else
+    ScalingTechnique rescaleTech = FLEXIBLEAUTO;
+    usint dcrtBits               = 59;
+    usint firstMod               = 60;
+#endif
+
+    usint depth = 10 + FHECKKSRNS::GetBootstrapDepth(9, setting.levelBudget, UNIFORM_TERNARY);
+
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(depth);
+    parameters.SetScalingModSize(dcrtBits);
+    parameters.SetScalingTechnique(rescaleTech);
+    parameters.SetRingDim(setting.ringDim);
+    parameters.SetSecretKeyDist(UNIFORM_TERNARY);
+    parameters.SetNumLargeDigits(3);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetFirstModSize(firstMod);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    cc->Enable(ADVANCEDSHE);
+    cc->Enable(FHE);
+
+    cc->EvalBootstrapSetup(setting.levelBudget, {0, 0}, setting.slots);
+
+    auto keyPair = cc->KeyGen();
+    cc->EvalBootstrapKeyGen(keyPair.secretKey, setting.slots);
+    cc->EvalMultKeyGen(keyPair.secretKey);
+
+    std::vector<std::complex<double>> input(
+        Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, setting.slots));
+    Plaintext plaintext = cc->MakeCKKSPackedPlaintext(input, 1, depth - 1, nullptr, setting.slots);
+    auto ciphertext     = cc->Encrypt(keyPair.publicKey, plaintext);
+
+    // warm-up run, not timed
+    auto ciphertextAfter = cc->EvalBootstrap(ciphertext);
+
+    for (auto _ : state) {
+        ciphertextAfter = cc->EvalBootstrap(ciphertext);
+        benchmark::DoNotOptimize(ciphertextAfter);
+    }
+
+    FHECKKSRNS::SetGiantStepsInExtendedBasis(true);
+    cc->ClearEvalMultKeys();
+    cc->ClearEvalAutomorphismKeys();
+    CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+}
+
+BENCHMARK(CKKSrns_EvalBootstrap)->Unit(benchmark::kMillisecond)->Apply(GiantStepArguments);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,152 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+ * Compares the throughput of relinearizing a batch of ciphertexts one at a time
+ * with KeySwitchInPlace against a single KeySwitchBatchInPlace call for CKKS
+ * with HYBRID key switching, with and without the Montgomery form of the key.
+ */
+
+#include "scheme/ckksrns/gen-cryptocontext-ckksrns.h"
+#include "gen-cryptocontext.h"
+
+#include "benchmark/benchmark.h"
+
+#include <iostream>
+#include <vector>
+
+using namespace lbcrypto;
+
+static std::vector<usint> batchSizes({1, 4, 16, 64});
+
+CryptoContext<DCRTPoly> GenerateCKKSContext() {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetScalingModSize(50);
+    parameters.SetMultiplicativeDepth(8);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetNumLargeDigits(3);
+    parameters.SetRingDim(1 << 14);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    return cc;
+}
+
+static void BatchArguments(benchmark::internal::Benchmark* b) {
+    for (usint n : batchSizes) {
+        b->ArgName("batch")->Arg(n);
+    }
+}
+
+/*
+ * Builds n degree-2 ciphertexts (products without relinearization) that share
+ * the relinearization key
+ */
+std::vector<Ciphertext<DCRTPoly>> MakeBatch(CryptoContext<DCRTPoly>& cc, const KeyPair<DCRTPoly>& keyPair, usint n) {
+    std::vector<double> vectorOfDoubles = {1.0, 0.5, 0.25, 0.125, 2.0, 3.0, 4.0, 5.0};
+    Plaintext plaintext                 = cc->MakeCKKSPackedPlaintext(vectorOfDoubles);
+    Ciphertext<DCRTPoly> ciphertext     = cc->Encrypt(keyPair.publicKey, plaintext);
+
+    std::vector<Ciphertext<DCRTPoly>> batch(n);
+    for (usint i = 0; i < n; ++i) {
+        batch[i] = cc->EvalMultNoRelin(ciphertext, ciphertext);
+        // KeySwitch operates on the evaluation representation
+        for (auto& element : batch[i]->GetElements())
+            element.SetFormat(Format::EVALUATION);
+    }
+    return batch;
+}
+
+/*
+ * Relinearizes n ciphertexts either one at a time or with a single batched
+ * call, optionally with the relinearization key kept in Montgomery form
+ */
+static void KeySwitchBenchmark(benchmark::State& state, bool batched, bool montgomery) {
+    usint n                    = state.range(0);
+    CryptoContext<DCRTPoly> cc = GenerateCKKSContext();
+
+    KeyPair<DCRTPoly> keyPair = cc->KeyGen();
+    cc->EvalMultKeyGen(keyPair.secretKey);
+    const auto evalKey = cc->GetEvalMultKeyVector(keyPair.secretKey->GetKeyTag())[0];
+    if (montgomery)
+        evalKey->EnableMontgomeryForm();
+
+    const std::vector<Ciphertext<DCRTPoly>> batch = MakeBatch(cc, keyPair, n);
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        std::vector<Ciphertext<DCRTPoly>> ciphertexts;
+        ciphertexts.reserve(n);
+        for (const auto& ct : batch)
+            ciphertexts.push_back(ct->Clone());
+        state.ResumeTiming();
+
+        if (batched) {
+            cc->KeySwitchBatchInPlace(ciphertexts, evalKey);
+        }
+        else {
+            for (auto& ct : ciphertexts)
+                cc->KeySwitchInPlace(ct, evalKey);
+        }
+        benchmark::DoNotOptimize(ciphertexts);
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+void CKKSrns_KeySwitchLoop(benchmark::State& state) {
+    KeySwitchBenchmark(state, false, false);
+}
+
+BENCHMARK(CKKSrns_KeySwitchLoop)->Unit(benchmark::kMillisecond)->Apply(BatchArguments);
+
+void CKKSrns_KeySwitchBatch(benchmark::State& state) {
+    KeySwitchBenchmark(state, true, false);
+}
+
+BENCHMARK(CKKSrns_KeySwitchBatch)->Unit(benchmark::kMillisecond)->Apply(BatchArguments);
+
+void CKKSrns_KeySwitchLoopMontgomery(benchmark::State& state) {
+    KeySwitchBenchmark(state, false, true);
+}
+
+BENCHMARK(CKKSrns_KeySwitchLoopMontgomery)->Unit(benchmark::kMillisecond)->Apply(BatchArguments);
+
+void CKKSrns_KeySwitchBatchMontgomery(benchmark::State& state) {
+    KeySwitchBenchmark(state, true, true);
+}
+
+BENCHMARK(CKKSrns_KeySwitchBatchMontgomery)->Unit(benchmark::kMillisecond)->Apply(BatchArguments);
+
+BENCHMARK_MAIN();
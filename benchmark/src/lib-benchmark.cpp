@@ -185,11 +185,29 @@ using namespace lbcrypto;
     state.SetComplexityN(state.range(0));
 }
 
+// same as NativeNTTInPlace/NativeINTTInPlace, but forces the scalar kernels to measure the gain of the
+// vectorized (AVX2/AVX-512) backend selected at runtime
+[[maybe_unused]] static void NativeNTTInPlaceScalar(benchmark::State& state) {
+    auto backend = intnat::GetNTTSimdBackend();
+    intnat::SetNTTSimdBackend(intnat::NTT_SIMD_SCALAR);
+    NativeNTTInPlace(state);
+    intnat::SetNTTSimdBackend(backend);
+}
+
+[[maybe_unused]] static void NativeINTTInPlaceScalar(benchmark::State& state) {
+    auto backend = intnat::GetNTTSimdBackend();
+    intnat::SetNTTSimdBackend(intnat::NTT_SIMD_SCALAR);
+    NativeINTTInPlace(state);
+    intnat::SetNTTSimdBackend(backend);
+}
+
 // BENCHMARK(NativeNTT)->Unit(benchmark::kMicrosecond)->RangeMultiplier(2)->Range(1<<10, 1<<16)->Complexity(benchmark::oAuto);
 BENCHMARK(NativeNTT)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);          // ->Complexity(benchmark::oAuto);
 BENCHMARK(NativeINTT)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);         // ->Complexity(benchmark::oAuto);
 BENCHMARK(NativeNTTInPlace)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);   // ->Complexity(benchmark::oAuto);
 BENCHMARK(NativeINTTInPlace)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);  // ->Complexity(benchmark::oAuto);
+BENCHMARK(NativeNTTInPlaceScalar)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);
+BENCHMARK(NativeINTTInPlaceScalar)->Unit(benchmark::kMicrosecond)->Apply(RingArgs);
 
 /*
  * BFVrns benchmarks
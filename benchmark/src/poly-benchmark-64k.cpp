@@ -50,4 +50,49 @@ public:
     }
 } TestParameters;
 
+// compares the radix-2 kernel with the cache-blocked kernel selected automatically at this ring dimension;
+// the argument picks the kernel: 0 - radix-2, 1 - cache-blocked
+static void NTTKernelArguments(benchmark::internal::Benchmark* b) {
+    b->ArgName("blocked")->Arg(0)->Arg(1);
+}
+
+[[maybe_unused]] static void Native_ntt_kernel(benchmark::State& state) {
+    std::shared_ptr<std::vector<NativePoly>> polys = NativepolysCoef;
+    const auto& tables{*(*polys)[0].GetParams()->GetNTTTables()};
+    intnat::NumberTheoreticTransformNat<NativeVector> ntt;
+    NativeVector v;
+    size_t i{POLY_NUM_M1};
+    while (state.KeepRunning()) {
+        v = (*polys)[(i = (i + 1) & POLY_NUM_M1)].GetValues();
+        if (state.range(0) == 0)
+            ntt.ForwardTransformToBitReverseInPlaceLazy(tables.rootOfUnityReverseTable,
+                                                        tables.rootOfUnityPreconReverseTable, &v);
+        else
+            ntt.ForwardTransformToBitReverseInPlaceBlocked(tables.rootOfUnityReverseTable,
+                                                           tables.rootOfUnityPreconReverseTable, &v);
+    }
+}
+
+[[maybe_unused]] static void Native_intt_kernel(benchmark::State& state) {
+    std::shared_ptr<std::vector<NativePoly>> polys = NativepolysEval;
+    const auto& tables{*(*polys)[0].GetParams()->GetNTTTables()};
+    intnat::NumberTheoreticTransformNat<NativeVector> ntt;
+    NativeVector v;
+    size_t i{POLY_NUM_M1};
+    while (state.KeepRunning()) {
+        v = (*polys)[(i = (i + 1) & POLY_NUM_M1)].GetValues();
+        if (state.range(0) == 0)
+            ntt.InverseTransformFromBitReverseInPlaceLazy(
+                tables.rootOfUnityInverseReverseTable, tables.rootOfUnityInversePreconReverseTable,
+                tables.cycloOrderInv, tables.cycloOrderInvPrecon, &v);
+        else
+            ntt.InverseTransformFromBitReverseInPlaceBlocked(
+                tables.rootOfUnityInverseReverseTable, tables.rootOfUnityInversePreconReverseTable,
+                tables.cycloOrderInv, tables.cycloOrderInvPrecon, &v);
+    }
+}
+
+BENCHMARK(Native_ntt_kernel)->Unit(benchmark::kMicrosecond)->Apply(NTTKernelArguments);
+BENCHMARK(Native_intt_kernel)->Unit(benchmark::kMicrosecond)->Apply(NTTKernelArguments);
+
 BENCHMARK_MAIN();
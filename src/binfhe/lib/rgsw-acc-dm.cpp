@@ -127,19 +127,10 @@ void RingGSWAccumulatorDM::AddToAccDM(const std::shared_ptr<RingGSWCryptoParams>
 
     SignedDigitDecompose(params, ct, dct);
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG2))
-    for (uint32_t j = 0; j < digitsG2; ++j)
-        dct[j].SetFormat(Format::EVALUATION);
-
-    // acc = dct * ek (matrix product);
-    // uses in-place * operators for the last call to dct[i] to gain performance improvement
-    const std::vector<std::vector<NativePoly>>& ev = ek->GetElements();
-    acc->GetElements()[0]                          = (dct[0] * ev[0][0]);
-    for (uint32_t l = 1; l < digitsG2; ++l)
-        acc->GetElements()[0] += (dct[l] * ev[l][0]);
-    acc->GetElements()[1] = (dct[0] *= ev[0][1]);
-    for (uint32_t l = 1; l < digitsG2; ++l)
-        acc->GetElements()[1] += (dct[l] *= ev[l][1]);
+    // acc = dct * ek (matrix product); the digits are transformed on the fly
+    acc->GetElements()[0].SetValuesToZero();
+    acc->GetElements()[1].SetValuesToZero();
+    NativePoly::MultiplyAccumulate(dct, ek->GetElements(), acc->GetElements());
 }
 
 };  // namespace lbcrypto
@@ -238,19 +238,10 @@ void RingGSWAccumulatorLMKCDEY::AddToAccLMKCDEY(const std::shared_ptr<RingGSWCry
 
     SignedDigitDecompose(params, ct, dct);
 
-    // calls digitsG2 NTTs
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG2))
-    for (uint32_t d = 0; d < digitsG2; ++d)
-        dct[d].SetFormat(Format::EVALUATION);
-
-    // acc = dct * ek (matrix product);
-    const std::vector<std::vector<NativePoly>>& ev = ek->GetElements();
-    acc->GetElements()[0]                          = (dct[0] * ev[0][0]);
-    for (uint32_t d = 1; d < digitsG2; ++d)
-        acc->GetElements()[0] += (dct[d] * ev[d][0]);
-    acc->GetElements()[1] = (dct[0] *= ev[0][1]);
-    for (uint32_t d = 1; d < digitsG2; ++d)
-        acc->GetElements()[1] += (dct[d] *= ev[d][1]);
+    // acc = dct * ek (matrix product); the digits are transformed on the fly
+    acc->GetElements()[0].SetValuesToZero();
+    acc->GetElements()[1].SetValuesToZero();
+    NativePoly::MultiplyAccumulate(dct, ek->GetElements(), acc->GetElements());
 }
 
 // Automorphism
@@ -274,16 +265,8 @@ void RingGSWAccumulatorLMKCDEY::Automorphism(const std::shared_ptr<RingGSWCrypto
 
     SignedDigitDecompose(params, cta, dcta);
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(digitsG))
-    for (uint32_t d = 0; d < digitsG; ++d)
-        dcta[d].SetFormat(Format::EVALUATION);
-
-    // acc = dct * input (matrix product);
-    const std::vector<std::vector<NativePoly>>& ev = ak->GetElements();
-    for (uint32_t d = 0; d < digitsG; ++d)
-        acc->GetElements()[0] += (dcta[d] * ev[d][0]);
-    for (uint32_t d = 0; d < digitsG; ++d)
-        acc->GetElements()[1] += (dcta[d] *= ev[d][1]);
+    // acc += dct * input (matrix product); the digits are transformed on the fly
+    NativePoly::MultiplyAccumulate(dcta, ak->GetElements(), acc->GetElements());
 }
 
 };  // namespace lbcrypto
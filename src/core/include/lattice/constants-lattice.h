@@ -45,7 +45,10 @@ enum SecretKeyDist {
     GAUSSIAN        = 0,
     UNIFORM_TERNARY = 1,  // Default value, all schemes support this key distribution
     SPARSE_TERNARY  = 2,
-    // BINARY = 3, // Future implementation
+    // Uniform ternary secret; CKKS bootstrapping switches to an ephemeral sparse secret for the
+    // modulus raising (sparse-secret encapsulation). Other schemes treat it as UNIFORM_TERNARY
+    SPARSE_ENCAPSULATED = 3,
+    // BINARY = 4, // Future implementation
 };
 SecretKeyDist convertToSecretKeyDist(const std::string& str);
 SecretKeyDist convertToSecretKeyDist(uint32_t num);
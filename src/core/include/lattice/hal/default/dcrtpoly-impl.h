@@ -46,6 +46,7 @@
 #include "utils/parallel.h"
 #include "utils/utilities.h"
 #include "utils/utilities-int.h"
+#include "utils/vectorpool.h"
 
 #include <algorithm>
 #include <ostream>
@@ -641,6 +642,69 @@ DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::operator*=(const NativeInteger& rh
     return *this;
 }
 
+template <typename VecType>
+DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::ToMontgomeryEq() {
+    size_t size{m_vectors.size()};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i)
+        m_vectors[i].ToMontgomeryEq();
+    return *this;
+}
+
+template <typename VecType>
+DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::FromMontgomeryEq() {
+    size_t size{m_vectors.size()};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i)
+        m_vectors[i].FromMontgomeryEq();
+    return *this;
+}
+
+template <typename VecType>
+DCRTPolyImpl<VecType>& DCRTPolyImpl<VecType>::TimesMontgomeryEq(const DCRTPolyType& rhs) {
+    size_t size{m_vectors.size()};
+    if (rhs.m_vectors.size() != size)
+        OPENFHE_THROW("TimesMontgomeryEq: tower count mismatch");
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i)
+        m_vectors[i].TimesMontgomeryEq(rhs.m_vectors[i]);
+    return *this;
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::MakeContiguous() {
+    if (!IsContiguous())
+        m_vectors = CopyTowersContiguous(m_vectors);
+}
+
+template <typename VecType>
+bool DCRTPolyImpl<VecType>::IsContiguous() const {
+    if (m_vectors.empty())
+        return false;
+    const auto* arena = m_vectors[0].GetArena();
+    for (const auto& v : m_vectors) {
+        if (!v.IsInArena(arena))
+            return false;
+    }
+    return true;
+}
+
+template <typename VecType>
+std::vector<typename DCRTPolyImpl<VecType>::PolyType> DCRTPolyImpl<VecType>::CopyTowersContiguous(
+    const std::vector<PolyType>& towers) {
+    size_t bytes{0};
+    for (const auto& v : towers) {
+        if (!v.IsEmpty())
+            bytes += ContiguousArena::RoundUp(v.GetLength() * sizeof(NativeInteger));
+    }
+    auto arena{std::make_shared<ContiguousArena>(bytes)};
+    std::vector<PolyType> result;
+    result.reserve(towers.size());
+    for (const auto& v : towers)
+        result.emplace_back(v, arena);
+    return result;
+}
+
 template <typename VecType>
 void DCRTPolyImpl<VecType>::SetValuesToZero() {
     size_t size{m_vectors.size()};
@@ -714,6 +778,7 @@ void DCRTPolyImpl<VecType>::DropLastElements(size_t i) {
 template <typename VecType>
 void DCRTPolyImpl<VecType>::DropLastElementAndScale(const std::vector<NativeInteger>& QlQlInvModqlDivqlModq,
                                                     const std::vector<NativeInteger>& qlInvModq) {
+    VectorPoolScope poolScope;
     auto lastPoly(m_vectors.back());
     lastPoly.SetFormat(Format::COEFFICIENT);
     this->DropLastElement();
@@ -805,7 +870,7 @@ typename DCRTPolyImpl<VecType>::PolyLargeType DCRTPolyImpl<VecType>::CRTInterpol
 
     VecType V(r, qt);
 
-#pragma omp parallel for private(tmp1) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+#pragma omp parallel for private(tmp1) num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::BASIS_CONVERSION, r))
     for (uint32_t j = 0; j < r; ++j) {
         for (uint32_t i = 0; i < t; ++i)
             V[j] += (tmp1 = m_vectors[i].GetValues()[j].ConvertToInt()) * multiplier[i];
@@ -915,25 +980,20 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
     uint32_t sizeQ = (m_vectors.size() > paramsQ->GetParams().size()) ? paramsQ->GetParams().size() : m_vectors.size();
     uint32_t sizeP = ans.m_vectors.size();
 #if defined(HAVE_INT128) && NATIVEINT == 64
-    uint32_t ringDim = m_params->GetRingDimension();
-    std::vector<DoubleNativeInt> sum(sizeP);
-    #pragma omp parallel for firstprivate(sum) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
-    for (uint32_t ri = 0; ri < ringDim; ++ri) {
-        std::fill(sum.begin(), sum.end(), 0);
-        for (uint32_t i = 0; i < sizeQ; ++i) {
-            const auto& qi        = m_vectors[i].GetModulus();
-            const auto& xi        = m_vectors[i][ri];
-            const auto& QHatModpi = QHatModp[i];
-            const auto xQHatInvModqi =
-                xi.ModMulFastConst(QHatInvModq[i], qi, QHatInvModqPrecon[i]).template ConvertToInt<uint64_t>();
-            for (uint32_t j = 0; j < sizeP; ++j)
-                sum[j] += Mul128(xQHatInvModqi, QHatModpi[j].ConvertToInt<uint64_t>());
-        }
-        for (uint32_t j = 0; j < sizeP; ++j) {
-            const auto& pj       = ans.m_vectors[j].GetModulus();
-            ans.m_vectors[j][ri] = BarrettUint128ModUint64(sum[j], pj.ConvertToInt(), modpBarrettMu[j]);
-        }
+    std::vector<const NativeInteger*> in(sizeQ);
+    std::vector<NativeInteger> moduliQ(sizeQ);
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        in[i]      = &m_vectors[i][0];
+        moduliQ[i] = m_vectors[i].GetModulus();
     }
+    std::vector<NativeInteger*> out(sizeP);
+    std::vector<NativeInteger> moduliP(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        out[j]     = &ans.m_vectors[j][0];
+        moduliP[j] = ans.m_vectors[j].GetModulus();
+    }
+    BaseConvMatrixProduct(m_params->GetRingDimension(), in, moduliQ, QHatInvModq.data(), QHatInvModqPrecon.data(),
+                          QHatModp, out, moduliP, modpBarrettMu);
 #else
     for (uint32_t i = 0; i < sizeQ; ++i) {
         auto xQHatInvModqi = m_vectors[i] * QHatInvModq[i];
@@ -947,6 +1007,85 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxSwitchCRTBasis(
     return ans;
 }
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+template <typename VecType>
+void DCRTPolyImpl<VecType>::BaseConvMatrixProduct(uint32_t n, const std::vector<const NativeInteger*>& in,
+                                                  const std::vector<NativeInteger>& moduliIn,
+                                                  const NativeInteger* scale, const NativeInteger* scalePrecon,
+                                                  const std::vector<std::vector<NativeInteger>>& M,
+                                                  const std::vector<NativeInteger*>& out,
+                                                  const std::vector<NativeInteger>& moduliOut,
+                                                  const std::vector<DoubleNativeInt>& modOutBarrettMu) {
+    constexpr uint32_t B{BASE_CONV_BLOCK_SIZE};
+    const uint32_t sizeQ = in.size();
+    const uint32_t sizeP = out.size();
+
+    // transposed matrix, so that the kernel reads the column of every output tower contiguously
+    std::vector<uint64_t> MT(sizeP * sizeQ);
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        for (uint32_t j = 0; j < sizeP; ++j)
+            MT[j * sizeQ + i] = M[i][j].ConvertToInt<uint64_t>();
+    }
+    std::vector<uint64_t> p(sizeP);
+    for (uint32_t j = 0; j < sizeP; ++j)
+        p[j] = moduliOut[j].ConvertToInt<uint64_t>();
+
+    const uint32_t nBlocks = (n + B - 1) / B;
+    std::vector<uint64_t> y(sizeQ * B);
+#pragma omp parallel for firstprivate(y) num_threads(std::min<int>(nBlocks, OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::BASIS_CONVERSION, n)))
+    for (uint32_t b = 0; b < nBlocks; ++b) {
+        const uint32_t k0  = b * B;
+        const uint32_t len = std::min(B, n - k0);
+
+        // gather (and scale) the block of every input tower
+        for (uint32_t i = 0; i < sizeQ; ++i) {
+            uint64_t* yi            = &y[i * B];
+            const NativeInteger* xi = in[i] + k0;
+            if (scale != nullptr) {
+                for (uint32_t k = 0; k < len; ++k)
+                    yi[k] = xi[k].ModMulFastConst(scale[i], moduliIn[i], scalePrecon[i]).ConvertToInt<uint64_t>();
+            }
+            else {
+                for (uint32_t k = 0; k < len; ++k)
+                    yi[k] = xi[k].template ConvertToInt<uint64_t>();
+            }
+        }
+
+        // four output towers per pass keep the accumulators in registers and reuse every load of y
+        uint32_t j = 0;
+        for (; j + 4 <= sizeP; j += 4) {
+            const uint64_t* c0 = &MT[j * sizeQ];
+            const uint64_t* c1 = c0 + sizeQ;
+            const uint64_t* c2 = c1 + sizeQ;
+            const uint64_t* c3 = c2 + sizeQ;
+            for (uint32_t k = 0; k < len; ++k) {
+                DoubleNativeInt a0{0}, a1{0}, a2{0}, a3{0};
+                for (uint32_t i = 0; i < sizeQ; ++i) {
+                    const uint64_t yik = y[i * B + k];
+                    a0 += Mul128(yik, c0[i]);
+                    a1 += Mul128(yik, c1[i]);
+                    a2 += Mul128(yik, c2[i]);
+                    a3 += Mul128(yik, c3[i]);
+                }
+                out[j][k0 + k]     = BarrettUint128ModUint64(a0, p[j], modOutBarrettMu[j]);
+                out[j + 1][k0 + k] = BarrettUint128ModUint64(a1, p[j + 1], modOutBarrettMu[j + 1]);
+                out[j + 2][k0 + k] = BarrettUint128ModUint64(a2, p[j + 2], modOutBarrettMu[j + 2]);
+                out[j + 3][k0 + k] = BarrettUint128ModUint64(a3, p[j + 3], modOutBarrettMu[j + 3]);
+            }
+        }
+        for (; j < sizeP; ++j) {
+            const uint64_t* c0 = &MT[j * sizeQ];
+            for (uint32_t k = 0; k < len; ++k) {
+                DoubleNativeInt a0{0};
+                for (uint32_t i = 0; i < sizeQ; ++i)
+                    a0 += Mul128(y[i * B + k], c0[i]);
+                out[j][k0 + k] = BarrettUint128ModUint64(a0, p[j], modOutBarrettMu[j]);
+            }
+        }
+    }
+}
+#endif
+
 template <typename VecType>
 void DCRTPolyImpl<VecType>::ApproxModUp(const std::shared_ptr<Params>& paramsQ, const std::shared_ptr<Params>& paramsP,
                                         const std::shared_ptr<Params>& paramsQP,
@@ -986,6 +1125,7 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxModDown(
     const std::vector<std::vector<NativeInteger>>& PHatModq, const std::vector<DoubleNativeInt>& modqBarrettMu,
     const std::vector<NativeInteger>& tInvModp, const std::vector<NativeInteger>& tInvModpPrecon,
     const NativeInteger& t, const std::vector<NativeInteger>& tModqPrecon) const {
+    VectorPoolScope poolScope;
     DCRTPolyImpl<VecType> partP(paramsP, m_format, true);
     size_t sizeP = paramsP->GetParams().size();
     size_t sizeQ = m_vectors.size() - sizeP;
@@ -1067,7 +1207,7 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::SwitchCRTBasis(const std::shared_pt
     DCRTPolyImpl<VecType> ans(paramsP, m_format, true);
     uint32_t ringDim = m_params->GetRingDimension();
 
-#pragma omp parallel for firstprivate(xQHatInvModq) num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+#pragma omp parallel for firstprivate(xQHatInvModq) num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::BASIS_CONVERSION, ringDim))
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
         double nu{0.5};
         for (size_t i = 0; i < sizeQ; ++i) {
@@ -1188,7 +1328,7 @@ void DCRTPolyImpl<VecType>::FastExpandCRTBasisPloverQ(const Precomputations& pre
         mu.push_back(p->GetModulus().ComputeMu());
 
     uint32_t ringDim = m_params->GetRingDimension();
-        #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::BASIS_CONVERSION, ringDim))
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
         for (size_t i = 0; i < sizeQ; ++i) {
             const auto& qInvModpi = precomputed.qInvModp[i];
@@ -1268,7 +1408,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // we fit in 63 bits, so we can do multiplications and
                 // additions without modulo reduction, and do modulo reduction
                 // only once
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.5;
                     NativeInteger intSum = 0, tmp;
@@ -1296,7 +1436,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // is bounded by 2^{-53}. Thus the floating point error is bounded by
                 // sizeQ * 2^30 * 2^{-53}. We always have sizeQ < 2^11, which means the
                 // error is bounded by 1/4, and the rounding will be correct.
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.5;
                     NativeInteger intSum = 0, tmp;
@@ -1321,7 +1461,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // we fit in 62 bits, so we can do multiplications and
                 // additions without modulo reduction, and do modulo reduction
                 // only once
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.5;
                     NativeInteger intSum = 0;
@@ -1346,7 +1486,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 }
             }
             else {
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.5;
                     NativeInteger intSum = 0;
@@ -1387,7 +1527,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // we fit in 52 bits, so we can do multiplications and
                 // additions without modulo reduction, and do modulo reduction
                 // only once using floating point techniques
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.0;
                     NativeInteger intSum = 0, tmp;
@@ -1419,7 +1559,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // is bounded by 2^{-53}. Thus the floating point error is bounded by
                 // sizeQ * 2^30 * 2^{-53}. We always have sizeQ < 2^11, which means the
                 // error is bounded by 1/4, and the rounding will be correct.
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum{0.0};
                     NativeInteger intSum{0};
@@ -1446,7 +1586,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 // we fit in 52 bits, so we can do multiplications and
                 // additions without modulo reduction, and do modulo reduction
                 // only once using floating point techniques
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.0;
                     NativeInteger intSum = 0;
@@ -1475,7 +1615,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
                 }
             }
             else {
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(4))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
                 for (usint ri = 0; ri < ringDim; ri++) {
                     double floatSum      = 0.0;
                     NativeInteger intSum = 0;
@@ -1530,7 +1670,7 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ApproxScaleAndRound(
         mu.push_back(p->GetModulus().ComputeMu());
 
     uint32_t ringDim = m_params->GetRingDimension();
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
         for (size_t j = 0; j < sizeP; ++j) {
             const auto& pj                     = ans.m_vectors[j].GetModulus();
@@ -1587,7 +1727,7 @@ DCRTPolyImpl<VecType> DCRTPolyImpl<VecType>::ScaleAndRound(
     for (const auto& p : paramsOutput->GetParams())
         mu.push_back(p->GetModulus().ComputeMu());
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
     for (uint32_t ri = 0; ri < ringDim; ++ri) {
         double nu = 0.5;
         for (size_t i = 0; i < sizeI; ++i) {
@@ -1688,7 +1828,7 @@ typename DCRTPolyImpl<VecType>::PolyType DCRTPolyImpl<VecType>::ScaleAndRound(
     uint32_t sizeQ   = m_vectors.size();
     DCRTPolyImpl::PolyType::Vector coefficients(ringDim, t.ConvertToInt());
 
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(8))
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, ringDim))
     for (uint32_t k = 0; k < ringDim; ++k) {
         // TODO: use 64 bit words in case NativeInteger uses smaller word size
         NativeInteger s = 0;
@@ -1794,6 +1934,18 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
         result_mtilde[k] &= mtilde_minus_1;
     }
 
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    {
+        std::vector<const NativeInteger*> in(numQ);
+        for (uint32_t i = 0; i < numQ; ++i)
+            in[i] = &ximtildeQHatModqi[i * n];
+        std::vector<NativeInteger*> out(numBsk);
+        for (uint32_t j = 0; j < numBsk; ++j)
+            out[j] = &m_vectors[numQ + j][0];
+        BaseConvMatrixProduct(n, in, moduliQ, nullptr, nullptr, QHatModbsk, out, moduliBsk, modbskBarrettMu);
+    }
+#endif
+
 #pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(numBsk))
     for (uint32_t j = 0; j < numBsk; ++j) {
         const auto& moduliBskj             = moduliBsk[j];
@@ -1802,13 +1954,7 @@ void DCRTPolyImpl<VecType>::FastBaseConvqToBskMontgomery(
         const auto& qModBskj               = QModbsk[j];
         const auto& qModBskjPrecon         = QModbskPrecon[j];
         for (uint32_t k = 0; k < n; ++k) {
-#if defined(HAVE_INT128) && NATIVEINT == 64
-            DoubleNativeInt result = 0;
-            for (uint32_t i = 0; i < numQ; ++i)
-                result += Mul128(ximtildeQHatModqi[i * n + k].ConvertToInt<uint64_t>(),
-                                 QHatModbsk[i][j].ConvertToInt<uint64_t>());
-            m_vectors[numQ + j][k] = BarrettUint128ModUint64(result, moduliBskj.ConvertToInt(), modbskBarrettMu[j]);
-#else
+#if !defined(HAVE_INT128) || NATIVEINT != 64
             for (uint32_t i = 0; i < numQ; ++i)
                 m_vectors[numQ + j][k].ModAddFastEq(
                     ximtildeQHatModqi[i * n + k].ModMul(QHatModbsk[i][j], moduliBskj, mu[j]), moduliBskj);
@@ -1980,11 +2126,85 @@ void DCRTPolyImpl<VecType>::FastBaseConvSK(
 
 template <typename VecType>
 void DCRTPolyImpl<VecType>::SwitchFormat() {
-    m_format = (m_format == Format::COEFFICIENT) ? Format::EVALUATION : Format::COEFFICIENT;
-    size_t size{m_vectors.size()};
-#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
-    for (size_t i = 0; i < size; ++i)
-        m_vectors[i].SwitchFormat();
+    DCRTPolyImpl<VecType>::SwitchFormat(std::vector<DCRTPolyImpl*>{this});
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::SwitchFormat(const std::vector<DCRTPolyImpl*>& polys) {
+    std::vector<PolyType*> towers;
+    for (auto p : polys) {
+        p->m_format = (p->m_format == Format::COEFFICIENT) ? Format::EVALUATION : Format::COEFFICIENT;
+        for (auto& v : p->m_vectors)
+            towers.push_back(&v);
+    }
+    PolyType::SwitchFormat(towers);
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::MultiplyAccumulate(const std::vector<DCRTPolyImpl>& operands,
+                                               const std::vector<std::vector<DCRTPolyImpl>>& keys,
+                                               std::vector<DCRTPolyImpl>& results) {
+    std::vector<const DCRTPolyImpl*> operandPtrs;
+    operandPtrs.reserve(operands.size());
+    for (const auto& p : operands)
+        operandPtrs.push_back(&p);
+    std::vector<std::vector<const DCRTPolyImpl*>> keyPtrs(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keyPtrs[i].reserve(keys[i].size());
+        for (const auto& p : keys[i])
+            keyPtrs[i].push_back(&p);
+    }
+    std::vector<DCRTPolyImpl*> resultPtrs;
+    resultPtrs.reserve(results.size());
+    for (auto& p : results)
+        resultPtrs.push_back(&p);
+    MultiplyAccumulate(operandPtrs, keyPtrs, resultPtrs);
+}
+
+template <typename VecType>
+void DCRTPolyImpl<VecType>::MultiplyAccumulate(const std::vector<const DCRTPolyImpl*>& operands,
+                                               const std::vector<std::vector<const DCRTPolyImpl*>>& keys,
+                                               const std::vector<DCRTPolyImpl*>& results) {
+    if (keys.size() != operands.size())
+        OPENFHE_THROW("the number of key rows must be equal to the number of operands");
+    if (results.empty() || operands.empty())
+        return;
+
+    const size_t towers{results[0]->m_vectors.size()};
+    auto checkTowers = [towers](const DCRTPolyImpl* p) {
+        if (p->m_vectors.size() != towers)
+            OPENFHE_THROW("all polynomials must have the same number of towers");
+    };
+    for (auto p : operands)
+        checkTowers(p);
+    for (const auto& row : keys) {
+        if (row.size() != results.size())
+            OPENFHE_THROW("the number of keys in a row must be equal to the number of results");
+        for (auto p : row)
+            checkTowers(p);
+    }
+    for (auto p : results)
+        checkTowers(p);
+
+    // the towers are independent, so each thread runs the fused single-buffer kernel on its own tower
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(towers))
+    for (size_t t = 0; t < towers; ++t) {
+        std::vector<const PolyType*> towerOperands;
+        towerOperands.reserve(operands.size());
+        for (auto p : operands)
+            towerOperands.push_back(&p->m_vectors[t]);
+        std::vector<std::vector<const PolyType*>> towerKeys(keys.size());
+        for (size_t i = 0; i < keys.size(); ++i) {
+            towerKeys[i].reserve(keys[i].size());
+            for (auto p : keys[i])
+                towerKeys[i].push_back(&p->m_vectors[t]);
+        }
+        std::vector<PolyType*> towerResults;
+        towerResults.reserve(results.size());
+        for (auto p : results)
+            towerResults.push_back(&p->m_vectors[t]);
+        PolyType::MultiplyAccumulate(towerOperands, towerKeys, towerResults, 1);
+    }
 }
 
 template <typename VecType>
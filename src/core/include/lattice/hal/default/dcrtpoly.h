@@ -73,11 +73,19 @@ public:
 
     DCRTPolyImpl() = default;
 
-    DCRTPolyImpl(const DCRTPolyType& e) noexcept : m_params{e.m_params}, m_format{e.m_format}, m_vectors{e.m_vectors} {}
+    DCRTPolyImpl(const DCRTPolyType& e) noexcept : m_params{e.m_params}, m_format{e.m_format} {
+        if (e.IsContiguous())
+            m_vectors = CopyTowersContiguous(e.m_vectors);
+        else
+            m_vectors = e.m_vectors;
+    }
     DCRTPolyType& operator=(const DCRTPolyType& rhs) noexcept override {
-        m_params  = rhs.m_params;
-        m_format  = rhs.m_format;
-        m_vectors = rhs.m_vectors;
+        m_params = rhs.m_params;
+        m_format = rhs.m_format;
+        if (rhs.IsContiguous())
+            m_vectors = CopyTowersContiguous(rhs.m_vectors);
+        else
+            m_vectors = rhs.m_vectors;
         return *this;
     }
 
@@ -106,6 +114,18 @@ public:
             m_vectors.emplace_back(p, m_format, initializeElementToZero);
     }
 
+    /**
+     * @brief Creates a contiguous DCRTPoly whose towers are consecutive 64-byte aligned slices of
+     * the given arena. When the arena is a view of existing memory (e.g. a memory-mapped key
+     * store), the towers use the values stored there in place; the memory must be writable.
+     */
+    DCRTPolyImpl(const std::shared_ptr<Params>& params, Format format, const std::shared_ptr<ContiguousArena>& arena)
+        : m_params{params}, m_format{format} {
+        m_vectors.reserve(m_params->GetParams().size());
+        for (const auto& p : m_params->GetParams())
+            m_vectors.emplace_back(p, m_format, arena);
+    }
+
     DCRTPolyImpl(const DggType& dgg, const std::shared_ptr<Params>& p, Format f = Format::EVALUATION);
     DCRTPolyImpl(const BugType& bug, const std::shared_ptr<Params>& p, Format f = Format::EVALUATION);
     DCRTPolyImpl(const TugType& tug, const std::shared_ptr<Params>& p, Format f = Format::EVALUATION, uint32_t h = 0);
@@ -138,6 +158,22 @@ public:
     DCRTPolyType& operator*=(const Integer& rhs) override;
     DCRTPolyType& operator*=(const NativeInteger& rhs) override;
 
+    /**
+     * @brief Converts every tower to Montgomery form (see PolyImpl::ToMontgomeryEq()).
+     */
+    DCRTPolyType& ToMontgomeryEq();
+
+    /**
+     * @brief Converts every tower from Montgomery form back to the standard representation.
+     */
+    DCRTPolyType& FromMontgomeryEq();
+
+    /**
+     * @brief Tower-wise Montgomery product; with rhs in Montgomery form the result equals
+     * operator*=() on the standard form of rhs, without Barrett reductions.
+     */
+    DCRTPolyType& TimesMontgomeryEq(const DCRTPolyType& rhs);
+
     DCRTPolyType Negate() const override;
     DCRTPolyType operator-() const override;
 
@@ -331,6 +367,49 @@ public:
 
     void SwitchFormat() override;
 
+    /**
+     * @brief Switches the format of all towers of several DCRTPolys with one call to the
+     * batched NTT, so that the work is split into (tower, block) items rather than towers.
+     *
+     * @param polys the polynomials to switch; each one switches from its own format
+     */
+    static void SwitchFormat(const std::vector<DCRTPolyImpl*>& polys);
+
+    /**
+     * @brief Fused multiply-accumulate results[j] += sum_i operands[i] * keys[i][j]
+     * computed tower by tower with PolyImpl::MultiplyAccumulate(), so that only one
+     * tower of every polynomial is touched at a time. Operands in COEFFICIENT format
+     * are transformed on the fly and results keep their format.
+     *
+     * @param operands the polynomials to multiply; they are not modified
+     * @param keys the key polynomials in EVALUATION format, one row per operand and one column per result
+     * @param results the accumulators; all polynomials must have the same towers
+     */
+    static void MultiplyAccumulate(const std::vector<DCRTPolyImpl>& operands,
+                                   const std::vector<std::vector<DCRTPolyImpl>>& keys,
+                                   std::vector<DCRTPolyImpl>& results);
+
+    /**
+     * @brief Pointer-based variant of MultiplyAccumulate() above, for operands and keys that are
+     * parts of other objects (e.g., ciphertext elements) and would otherwise have to be copied.
+     */
+    static void MultiplyAccumulate(const std::vector<const DCRTPolyImpl*>& operands,
+                                   const std::vector<std::vector<const DCRTPolyImpl*>>& keys,
+                                   const std::vector<DCRTPolyImpl*>& results);
+
+    /**
+     * @brief Moves all towers into one 64-byte aligned allocation, each tower being a view of its
+     * own aligned slice. Copies of a contiguous DCRTPoly are contiguous as well. Operations that
+     * replace the values of a tower (rather than updating them in place) move that tower back to
+     * the heap, after which IsContiguous() returns false until MakeContiguous() is called again.
+     */
+    void MakeContiguous();
+
+    /**
+     * @brief Checks whether all towers are stored in a single contiguous allocation.
+     */
+    bool IsContiguous() const;
+
     void SwitchModulusAtIndex(size_t index, const Integer& modulus, const Integer& rootOfUnity) override;
 
     template <class Archive>
@@ -392,6 +471,40 @@ public:
     }
 
 protected:
+    // copies the towers into a new arena sized for all of them
+    static std::vector<PolyType> CopyTowersContiguous(const std::vector<PolyType>& towers);
+
+#if defined(HAVE_INT128) && NATIVEINT == 64
+    /**
+     * @brief Modular matrix product at the core of the fast basis conversions: for every
+     * coefficient k, out[j][k] = sum_i y_i[k] * M[i][j] mod p_j, where y_i[k] = in[i][k] * scale[i]
+     * mod q_i if scale is given (scalePrecon holds its Shoup precomputations) and y_i = in[i]
+     * otherwise. The ring dimension is processed in cache-sized blocks split across all threads;
+     * within a block, a register-blocked kernel produces several output towers per pass.
+     * At most 256 input towers are supported, as the sums are accumulated in 128 bits.
+     *
+     * @param n the number of coefficients
+     * @param in pointers to the coefficients of the input towers
+     * @param moduliIn the moduli q_i; only used if scale is given
+     * @param scale per-tower factors, or nullptr
+     * @param scalePrecon Shoup precomputations of the factors, or nullptr
+     * @param M the conversion matrix with (at least) in.size() rows and out.size() columns
+     * @param out pointers to the coefficients of the output towers
+     * @param moduliOut the moduli p_j
+     * @param modOutBarrettMu Barrett constants of the moduli p_j
+     */
+    static void BaseConvMatrixProduct(uint32_t n, const std::vector<const NativeInteger*>& in,
+                                      const std::vector<NativeInteger>& moduliIn, const NativeInteger* scale,
+                                      const NativeInteger* scalePrecon,
+                                      const std::vector<std::vector<NativeInteger>>& M,
+                                      const std::vector<NativeInteger*>& out,
+                                      const std::vector<NativeInteger>& moduliOut,
+                                      const std::vector<DoubleNativeInt>& modOutBarrettMu);
+
+    // number of coefficients per block of BaseConvMatrixProduct()
+    static constexpr uint32_t BASE_CONV_BLOCK_SIZE{64};
+#endif
+
     std::shared_ptr<Params> m_params{std::make_shared<DCRTPolyImpl::Params>()};
     Format m_format{Format::EVALUATION};
     std::vector<PolyType> m_vectors;
@@ -45,7 +45,9 @@
 #include "utils/exception.h"
 #include "utils/inttypes.h"
 
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace lbcrypto {
@@ -59,7 +61,8 @@ namespace lbcrypto {
 template <typename IntType>
 class ILParamsImpl final : public ElemParams<IntType> {
 public:
-    using Integer = IntType;
+    using Integer   = IntType;
+    using NTTTables = intnat::NTTTablesNat<NativeVector>;
 
     constexpr ILParamsImpl() : ElemParams<IntType>() {}
     ~ILParamsImpl() override = default;
@@ -79,21 +82,27 @@ public:
         : ILParamsImpl<IntType>(order, LastPrime<IntType>(bits, order)) {}
 
     explicit ILParamsImpl(uint32_t order, const IntType& modulus)
-        : ElemParams<IntType>(order, modulus, RootOfUnity<IntType>(order, modulus)) {}
+        : ElemParams<IntType>(order, modulus, RootOfUnity<IntType>(order, modulus)) {
+        SetNTTTables();
+    }
 
     ILParamsImpl(uint32_t order, const IntType& modulus, const IntType& rootOfUnity)
-        : ElemParams<IntType>(order, modulus, rootOfUnity) {}
+        : ElemParams<IntType>(order, modulus, rootOfUnity) {
+        SetNTTTables();
+    }
 
     ILParamsImpl(uint32_t order, const IntType& modulus, const IntType& rootOfUnity, const IntType& bigModulus,
                  const IntType& bigRootOfUnity)
-        : ElemParams<IntType>(order, modulus, rootOfUnity, bigModulus, bigRootOfUnity) {}
+        : ElemParams<IntType>(order, modulus, rootOfUnity, bigModulus, bigRootOfUnity) {
+        SetNTTTables();
+    }
 
     /**
    * @brief Copy constructor.
    *
    * @param &rhs the input set of parameters which is copied.
    */
-    ILParamsImpl(const ILParamsImpl& rhs) : ElemParams<IntType>(rhs) {}
+    ILParamsImpl(const ILParamsImpl& rhs) : ElemParams<IntType>(rhs), m_nttTables(rhs.m_nttTables) {}
 
     /**
    * @brief Copy Assignment Operator.
@@ -103,6 +112,7 @@ public:
    */
     ILParamsImpl& operator=(const ILParamsImpl& rhs) {
         ElemParams<IntType>::operator=(rhs);
+        m_nttTables = rhs.m_nttTables;
         return *this;
     }
 
@@ -111,13 +121,26 @@ public:
    *
    * @param &rhs the input set of parameters which is copied.
    */
-    ILParamsImpl(ILParamsImpl&& rhs) noexcept : ElemParams<IntType>(std::move(rhs)) {}
+    ILParamsImpl(ILParamsImpl&& rhs) noexcept
+        : ElemParams<IntType>(std::move(rhs)), m_nttTables(std::move(rhs.m_nttTables)) {}
 
     ILParamsImpl& operator=(ILParamsImpl&& rhs) noexcept {
         ElemParams<IntType>::operator=(std::move(rhs));
+        m_nttTables = std::move(rhs.m_nttTables);
         return *this;
     }
 
+    /**
+   * @brief Returns the precomputed NTT tables for the modulus and root of unity
+   * of these parameters, so the transforms need no lookup by modulus.
+   *
+   * @return the shared tables or nullptr if the parameters are not native or the
+   * cyclotomic order is not a power of two.
+   */
+    const std::shared_ptr<const NTTTables>& GetNTTTables() const {
+        return m_nttTables;
+    }
+
     /**
    * @brief Equality operator compares ElemParams (which will be dynamic casted)
    *
@@ -142,6 +165,7 @@ public:
             OPENFHE_THROW("serialized object version " + std::to_string(version) +
                           " is from a later version of the library");
         ar(::cereal::base_class<ElemParams<IntType>>(this));
+        SetNTTTables();
     }
 
     std::string SerializedObjectName() const override {
@@ -153,6 +177,22 @@ public:
     }
 
 private:
+    void SetNTTTables() {
+        if constexpr (std::is_same_v<IntType, NativeInteger>) {
+            // the tables are only built for parameters that support the power-of-two NTT:
+            // 2n | q-1 and the root of unity is a primitive 2n-th root modulo q
+            const auto& ru = ElemParams<IntType>::m_rootOfUnity;
+            const auto& q  = ElemParams<IntType>::m_ciphertextModulus;
+            const auto co  = ElemParams<IntType>::m_cyclotomicOrder;
+            if (co < 2 || !IsPowerOfTwo(co) || q < IntType(3) || ru == IntType(0) || ru == IntType(1) ||
+                (q - IntType(1)).Mod(IntType(co)) != IntType(0) || ru.ModExp(IntType(co >> 1), q) != q - IntType(1))
+                return;
+            m_nttTables = intnat::ChineseRemainderTransformFTTNat<NativeVector>::GetTables(ru, co, q);
+        }
+    }
+
+    std::shared_ptr<const NTTTables> m_nttTables;
+
     std::ostream& doprint(std::ostream& out) const override {
         out << "ILParams ";
         ElemParams<IntType>::doprint(out);
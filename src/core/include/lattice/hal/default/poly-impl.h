@@ -41,12 +41,15 @@
 #include "utils/debug.h"
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/parallel.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <limits>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -420,6 +423,21 @@ void PolyImpl<VecType>::SwitchFormat() {
     if (!m_values)
         OPENFHE_THROW("Poly switch format to empty values");
 
+    if constexpr (std::is_same_v<VecType, NativeVector>) {
+        // the tables held by the parameters save the lookup by modulus
+        auto tables = m_params->GetNTTTables();
+        if (tables != nullptr && m_values->GetModulus() == m_params->GetModulus()) {
+            if (m_format != Format::COEFFICIENT) {
+                m_format = Format::COEFFICIENT;
+                ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(*tables, &(*m_values));
+                return;
+            }
+            m_format = Format::EVALUATION;
+            ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(*tables, &(*m_values));
+            return;
+        }
+    }
+
     if (m_format != Format::COEFFICIENT) {
         m_format = Format::COEFFICIENT;
         ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(ru, co, &(*m_values));
@@ -429,6 +447,222 @@ void PolyImpl<VecType>::SwitchFormat() {
     ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(ru, co, &(*m_values));
 }
 
+template <typename VecType>
+void PolyImpl<VecType>::SwitchFormat(const std::vector<PolyImpl*>& polys) {
+    if (polys.empty())
+        return;
+
+    if constexpr (std::is_same_v<VecType, NativeVector>) {
+        const auto co{polys[0]->m_params->GetCyclotomicOrder()};
+        bool batched{true};
+        for (auto p : polys) {
+            if (p->m_params->GetCyclotomicOrder() != co || p->m_params->GetRingDimension() != (co >> 1))
+                batched = false;
+            else if (!p->m_values)
+                OPENFHE_THROW("Poly switch format to empty values");
+        }
+        if (batched) {
+            using Tables = typename ChineseRemainderTransformFTT<VecType>::Tables;
+            std::vector<std::shared_ptr<const Tables>> forwardTables, inverseTables;
+            std::vector<VecType*> forward, inverse;
+            for (auto p : polys) {
+                std::shared_ptr<const Tables> tables{p->m_params->GetNTTTables()};
+                if (tables == nullptr || p->m_values->GetModulus() != p->m_params->GetModulus()) {
+                    const auto& ru{p->m_params->GetRootOfUnity()};
+                    if (ru != Integer(0) && ru != Integer(1))
+                        tables = ChineseRemainderTransformFTT<VecType>::GetTables(ru, co, p->m_values->GetModulus());
+                }
+                if (p->m_format == Format::COEFFICIENT) {
+                    p->m_format = Format::EVALUATION;
+                    forwardTables.push_back(tables);
+                    forward.push_back(p->m_values.get());
+                }
+                else {
+                    p->m_format = Format::COEFFICIENT;
+                    inverseTables.push_back(tables);
+                    inverse.push_back(p->m_values.get());
+                }
+            }
+            ChineseRemainderTransformFTT<VecType>().ForwardTransformToBitReverseInPlace(forwardTables, forward);
+            ChineseRemainderTransformFTT<VecType>().InverseTransformFromBitReverseInPlace(inverseTables, inverse);
+            return;
+        }
+    }
+
+    size_t size{polys.size()};
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(size))
+    for (size_t i = 0; i < size; ++i)
+        polys[i]->SwitchFormat();
+}
+
+template <typename VecType>
+void PolyImpl<VecType>::MultiplyAccumulate(const std::vector<PolyImpl>& operands,
+                                           const std::vector<std::vector<PolyImpl>>& keys,
+                                           std::vector<PolyImpl>& results) {
+    std::vector<const PolyImpl*> operandPtrs;
+    operandPtrs.reserve(operands.size());
+    for (const auto& p : operands)
+        operandPtrs.push_back(&p);
+    std::vector<std::vector<const PolyImpl*>> keyPtrs(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        keyPtrs[i].reserve(keys[i].size());
+        for (const auto& p : keys[i])
+            keyPtrs[i].push_back(&p);
+    }
+    std::vector<PolyImpl*> resultPtrs;
+    resultPtrs.reserve(results.size());
+    for (auto& p : results)
+        resultPtrs.push_back(&p);
+    MultiplyAccumulate(operandPtrs, keyPtrs, resultPtrs, OpenFHEParallelControls.GetThreadLimit(operands.size()));
+}
+
+template <typename VecType>
+void PolyImpl<VecType>::MultiplyAccumulate(const std::vector<const PolyImpl*>& operands,
+                                           const std::vector<std::vector<const PolyImpl*>>& keys,
+                                           const std::vector<PolyImpl*>& results, uint32_t threads) {
+    const uint32_t size(operands.size());
+    const uint32_t outputs(results.size());
+    if (keys.size() != size)
+        OPENFHE_THROW("the number of key rows must be equal to the number of operands");
+    for (const auto& row : keys) {
+        if (row.size() != outputs)
+            OPENFHE_THROW("the number of keys in a row must be equal to the number of results");
+        for (auto k : row) {
+            if (k->m_format != Format::EVALUATION)
+                OPENFHE_THROW("keys must be in EVALUATION format");
+            if (!k->m_values)
+                OPENFHE_THROW("MultiplyAccumulate with empty values");
+        }
+    }
+    for (auto p : operands) {
+        if (!p->m_values)
+            OPENFHE_THROW("MultiplyAccumulate with empty values");
+    }
+    for (auto p : results) {
+        if (!p->m_values)
+            OPENFHE_THROW("MultiplyAccumulate with empty values");
+    }
+    if (size == 0 || outputs == 0)
+        return;
+
+    if constexpr (std::is_same_v<VecType, NativeVector>) {
+        const auto tables{results[0]->m_params->GetNTTTables()};
+        const auto& q{results[0]->m_params->GetModulus()};
+        const uint32_t n{results[0]->m_params->GetRingDimension()};
+        auto compatible = [&q, n](const PolyImpl* p) {
+            return p->m_values->GetModulus() == q && p->m_values->GetLength() == n;
+        };
+        bool fused{tables != nullptr && std::all_of(operands.begin(), operands.end(), compatible) &&
+                   std::all_of(results.begin(), results.end(), compatible)};
+        for (const auto& row : keys)
+            fused = fused && std::all_of(row.begin(), row.end(), compatible);
+
+        if (fused) {
+            ChineseRemainderTransformFTT<VecType> crt;
+            for (auto p : results) {
+                if (p->m_format == Format::COEFFICIENT)
+                    crt.ForwardTransformToBitReverseInPlace(*tables, p->m_values.get());
+            }
+
+            // the operands are transformed a group at a time into the scratch vectors, which
+            // are consumed by the products right away, so at most `group` of them are alive.
+            // With the lazy butterflies the last stage of the transform is left out and run
+            // block by block inside the products, so the transformed operands are never stored
+            threads = std::max(1u, threads);
+            const bool lazy{q.GetMSB() <= Integer::MaxBits() - 2 && n >= 2};
+            const uint32_t group{std::min(threads, size)};
+            const uint32_t nBlocks{(n + MAC_BLOCK_SIZE - 1) / MAC_BLOCK_SIZE};
+            const auto mu{q.ComputeMu()};
+            const auto twoQ{q << 1};
+            const auto& w{tables->rootOfUnityReverseTable};
+            const auto& wPrecon{tables->rootOfUnityPreconReverseTable};
+            std::vector<VecType> scratch(group);
+            std::vector<const VecType*> values(group);
+            std::vector<bool> lastStage(group);
+            for (uint32_t begin = 0; begin < size; begin += group) {
+                const uint32_t count{std::min(group, size - begin)};
+#pragma omp parallel for num_threads(count)
+                for (uint32_t s = 0; s < count; ++s) {
+                    const auto a{operands[begin + s]};
+                    if (a->m_format == Format::EVALUATION) {
+                        values[s] = a->m_values.get();
+                    }
+                    else {
+                        scratch[s] = *a->m_values;
+                        if (lazy)
+                            crt.ForwardTransformToBitReverseInPlaceButLast(*tables, &scratch[s]);
+                        else
+                            crt.ForwardTransformToBitReverseInPlace(*tables, &scratch[s]);
+                        values[s] = &scratch[s];
+                    }
+                }
+                for (uint32_t s = 0; s < count; ++s)
+                    lastStage[s] = lazy && operands[begin + s]->m_format == Format::COEFFICIENT;
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(std::min(threads, nBlocks)))
+                for (uint32_t b = 0; b < nBlocks; ++b) {
+                    const uint32_t kBegin{b * MAC_BLOCK_SIZE};
+                    const uint32_t kEnd{std::min(n, kBegin + MAC_BLOCK_SIZE)};
+                    Integer block[MAC_BLOCK_SIZE];
+                    for (uint32_t s = 0; s < count; ++s) {
+                        const Integer* a{&(*values[s])[kBegin]};
+                        if (lastStage[s]) {
+                            // the butterflies of the last stage, reduced to [0, q)
+                            for (uint32_t k = kBegin; k < kEnd; k += 2) {
+                                auto loVal{a[k - kBegin]};
+                                if (loVal >= twoQ)
+                                    loVal -= twoQ;
+                                auto omegaFactor{a[k - kBegin + 1].ModMulFastConstLazy(w[(k + n) >> 1], q,
+                                                                                       wPrecon[(k + n) >> 1])};
+                                auto hiVal{loVal + omegaFactor};
+                                if (hiVal >= twoQ)
+                                    hiVal -= twoQ;
+                                if (hiVal >= q)
+                                    hiVal -= q;
+                                loVal += twoQ - omegaFactor;
+                                if (loVal >= twoQ)
+                                    loVal -= twoQ;
+                                if (loVal >= q)
+                                    loVal -= q;
+                                block[k - kBegin]     = hiVal;
+                                block[k - kBegin + 1] = loVal;
+                            }
+                            a = block;
+                        }
+                        for (uint32_t j = 0; j < outputs; ++j) {
+                            auto& acc{*results[j]->m_values};
+                            const auto& key{*keys[begin + s][j]->m_values};
+                            for (uint32_t k = kBegin; k < kEnd; ++k)
+                                acc[k].ModAddFastEq(a[k - kBegin].ModMulFast(key[k], q, mu), q);
+                        }
+                    }
+                }
+            }
+
+            for (auto p : results) {
+                if (p->m_format == Format::COEFFICIENT)
+                    crt.InverseTransformFromBitReverseInPlace(*tables, p->m_values.get());
+            }
+            return;
+        }
+    }
+
+    std::vector<Format> formats;
+    formats.reserve(outputs);
+    for (auto p : results) {
+        formats.push_back(p->m_format);
+        p->SetFormat(Format::EVALUATION);
+    }
+    for (uint32_t i = 0; i < size; ++i) {
+        PolyImpl a(*operands[i]);
+        a.SetFormat(Format::EVALUATION);
+        for (uint32_t j = 0; j < outputs; ++j)
+            *results[j] += a * *keys[i][j];
+    }
+    for (uint32_t j = 0; j < outputs; ++j)
+        results[j]->SetFormat(formats[j]);
+}
+
 template <typename VecType>
 void PolyImpl<VecType>::ArbitrarySwitchFormat() {
     if (m_values == nullptr)
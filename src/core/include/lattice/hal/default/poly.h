@@ -44,6 +44,7 @@
 #include "math/math-hal.h"
 #include "math/nbtheory.h"
 
+#include "utils/arenaallocator.h"
 #include "utils/exception.h"
 #include "utils/inttypes.h"
 
@@ -138,6 +139,44 @@ public:
     PolyImpl(PolyType&& p) noexcept
         : m_format{p.m_format}, m_params{std::move(p.m_params)}, m_values{std::move(p.m_values)} {}
 
+    /**
+     * @brief Copies a native polynomial with its values stored in the given arena
+     * (used for the contiguous towers of DCRTPolyImpl).
+     */
+    PolyImpl(const PolyType& p, const std::shared_ptr<ContiguousArena>& arena)
+        : m_format{p.m_format}, m_params{p.m_params} {
+        if (!p.m_values)
+            return;
+        if constexpr (std::is_same_v<VecType, NativeVector>)
+            m_values = std::make_unique<VecType>(*p.m_values, arena);
+        else
+            m_values = std::make_unique<VecType>(*p.m_values);
+    }
+
+    /**
+     * @brief Creates a native polynomial whose values are the next slice of the given arena;
+     * they are used in place when the arena is a view and zero otherwise.
+     */
+    PolyImpl(const std::shared_ptr<Params>& params, Format format, const std::shared_ptr<ContiguousArena>& arena)
+        : m_format{format}, m_params{params} {
+        if constexpr (std::is_same_v<VecType, NativeVector>)
+            m_values = std::make_unique<VecType>(params->GetRingDimension(), params->GetModulus(), arena);
+        else
+            PolyImpl::SetValuesToZero();
+    }
+
+    bool IsInArena(const ContiguousArena* arena) const {
+        if constexpr (std::is_same_v<VecType, NativeVector>)
+            return m_values && m_values->IsInArena(arena);
+        return false;
+    }
+
+    const ContiguousArena* GetArena() const {
+        if constexpr (std::is_same_v<VecType, NativeVector>)
+            return m_values ? m_values->GetArena() : nullptr;
+        return nullptr;
+    }
+
     PolyType& operator=(const PolyType& rhs) noexcept override;
     PolyType& operator=(PolyType&& rhs) noexcept override {
         m_format = std::move(rhs.m_format);
@@ -267,6 +306,46 @@ public:
         tmp.m_values->ModMulNoCheckEq(*rhs.m_values);
         return tmp;
     }
+
+    /**
+     * @brief Converts the values to Montgomery form (see NativeVectorT::ToMontgomeryEq()),
+     * e.g. for operands that are stored once and multiplied many times with TimesMontgomeryEq().
+     * Only supported for native vectors.
+     */
+    PolyImpl& ToMontgomeryEq() {
+        if constexpr (std::is_same_v<VecType, NativeVector>) {
+            if (m_values)
+                m_values->ToMontgomeryEq();
+            return *this;
+        }
+        OPENFHE_THROW("ToMontgomeryEq is only supported for native vectors");
+    }
+
+    /**
+     * @brief Converts the values from Montgomery form back to the standard representation.
+     */
+    PolyImpl& FromMontgomeryEq() {
+        if constexpr (std::is_same_v<VecType, NativeVector>) {
+            if (m_values)
+                m_values->FromMontgomeryEq();
+            return *this;
+        }
+        OPENFHE_THROW("FromMontgomeryEq is only supported for native vectors");
+    }
+
+    /**
+     * @brief Pointwise Montgomery product; when rhs is in Montgomery form this computes
+     * the same result as operator*=(rhs) on the standard form of rhs.
+     */
+    PolyImpl& TimesMontgomeryEq(const PolyImpl& rhs) {
+        if constexpr (std::is_same_v<VecType, NativeVector>) {
+            if (m_format != Format::EVALUATION || rhs.m_format != Format::EVALUATION)
+                OPENFHE_THROW("TimesMontgomeryEq for PolyImpl supported only in Format::EVALUATION");
+            m_values->ModMulMontgomeryEq(*rhs.m_values);
+            return *this;
+        }
+        OPENFHE_THROW("TimesMontgomeryEq is only supported for native vectors");
+    }
     PolyImpl& operator*=(const PolyImpl& rhs) override {
         if (m_params->GetRingDimension() != rhs.m_params->GetRingDimension())
             OPENFHE_THROW("RingDimension missmatch");
@@ -318,6 +397,42 @@ public:
     void SwitchModulus(const Integer& modulus, const Integer& rootOfUnity, const Integer& modulusArb,
                        const Integer& rootOfUnityArb) override;
     void SwitchFormat() override;
+
+    /**
+     * @brief Switches the format of several polynomials at once. For power-of-two
+     * cyclotomics over native integers, all transforms are handed to the batched NTT,
+     * which splits them into (polynomial, block) work items so that all threads are
+     * used even for a few polynomials.
+     *
+     * @param polys the polynomials to switch; each one switches from its own format
+     */
+    static void SwitchFormat(const std::vector<PolyImpl*>& polys);
+
+    /**
+     * @brief Fused multiply-accumulate results[j] += sum_i operands[i] * keys[i][j].
+     * Operands in COEFFICIENT format are transformed on the fly into scratch vectors
+     * that are consumed right away by the pointwise products, and results in COEFFICIENT
+     * format are transformed to EVALUATION format and back, so neither the transformed
+     * operands nor the products are ever stored as separate polynomials. The pointwise
+     * products run over blocks of coefficients so that each block of an operand stays
+     * in L1 while it is multiplied by all of its keys.
+     *
+     * @param operands the polynomials to multiply; they are not modified
+     * @param keys the key polynomials in EVALUATION format, one row per operand and one column per result
+     * @param results the accumulators; each one keeps its format
+     */
+    static void MultiplyAccumulate(const std::vector<PolyImpl>& operands,
+                                   const std::vector<std::vector<PolyImpl>>& keys, std::vector<PolyImpl>& results);
+
+    /**
+     * @brief Pointer-based variant of MultiplyAccumulate() above.
+     *
+     * @param threads the number of operands transformed concurrently; the kernel keeps
+     * one scratch vector per thread, so 1 gives the fully fused single-buffer pass
+     */
+    static void MultiplyAccumulate(const std::vector<const PolyImpl*>& operands,
+                                   const std::vector<std::vector<const PolyImpl*>>& keys,
+                                   const std::vector<PolyImpl*>& results, uint32_t threads);
     void MakeSparse(uint32_t wFactor) override;
     bool InverseExists() const override;
     double Norm() const override;
@@ -359,6 +474,9 @@ protected:
     std::shared_ptr<Params> m_params{nullptr};
     std::unique_ptr<VecType> m_values{nullptr};
     void ArbitrarySwitchFormat();
+
+    // number of coefficients per block of the pointwise products in MultiplyAccumulate()
+    static constexpr uint32_t MAC_BLOCK_SIZE{1 << 9};
 };
 
 }  // namespace lbcrypto
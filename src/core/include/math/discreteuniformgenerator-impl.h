@@ -67,12 +67,13 @@ typename VecType::Integer DiscreteUniformGeneratorImpl<VecType>::GenerateInteger
     if (m_modulus == typename VecType::Integer(0))
         OPENFHE_THROW("0 modulus?");
 
+    PRNG& prng = m_prng ? *m_prng : PseudoRandomNumberGenerator::GetPRNG();
     std::uniform_int_distribution<uint32_t> dist(DUG_CHUNK_MIN, DUG_CHUNK_MAX);
     while (true) {
         typename VecType::Integer result{};
         for (uint32_t i{0}, shift{0}; i < m_chunksPerValue; ++i, shift += DUG_CHUNK_WIDTH)
-            result += typename VecType::Integer{dist(PseudoRandomNumberGenerator::GetPRNG())} << shift;
-        result += typename VecType::Integer{dist(PseudoRandomNumberGenerator::GetPRNG(), m_bound)} << m_shiftChunk;
+            result += typename VecType::Integer{dist(prng)} << shift;
+        result += typename VecType::Integer{dist(prng, m_bound)} << m_shiftChunk;
 
         if (result < m_modulus)
             return result;
@@ -40,6 +40,7 @@
 #include "math/distributiongenerator.h"
 
 #include <limits>
+#include <memory>
 #include <random>
 
 namespace lbcrypto {
@@ -64,6 +65,16 @@ public:
    */
     void SetModulus(const typename VecType::Integer& modulus);
 
+    /**
+   * @brief      Draws all further samples from the given engine instead of the
+   *             thread-local PRNG, e.g. to expand a seeded polynomial
+   *             deterministically. A null engine restores the default.
+   * @param prng the engine to sample from.
+   */
+    void SetPRNG(std::shared_ptr<PRNG> prng) {
+        m_prng = std::move(prng);
+    }
+
     /**
    * @brief Generates a random integer based on the modulus set for the Discrete
    * Uniform Generator object. Required by DistributionGenerator.
@@ -81,6 +92,8 @@ private:
     uint32_t m_chunksPerValue{};
     uint32_t m_shiftChunk{};
     std::uniform_int_distribution<uint32_t>::param_type m_bound{DUG_CHUNK_MIN, DUG_CHUNK_MAX};
+    // optional engine overriding PseudoRandomNumberGenerator::GetPRNG()
+    std::shared_ptr<PRNG> m_prng;
 };
 
 }  // namespace lbcrypto
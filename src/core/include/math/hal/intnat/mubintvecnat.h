@@ -40,6 +40,7 @@
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/vector.h"
 
+#include "utils/arenaallocator.h"
 #include "utils/blockAllocator/xvector.h"
 #include "utils/exception.h"
 #include "utils/inttypes.h"
@@ -124,7 +125,8 @@ private:
     IntegerType m_modulus{0};
 
 #if BLOCK_VECTOR_ALLOCATION != 1
-    std::vector<IntegerType> m_data{};
+    // 64-byte aligned heap storage by default; a slice of a shared arena for contiguous DCRTPoly towers
+    std::vector<IntegerType, lbcrypto::ArenaAllocator<IntegerType>> m_data{};
 #else
     xvector<IntegerType> m_data{};
 #endif
@@ -180,6 +182,73 @@ public:
    */
     constexpr NativeVectorT(const NativeVectorT& v) noexcept : m_modulus{v.m_modulus}, m_data{v.m_data} {}
 
+    /**
+   * Constructor for copying a vector into storage taken from a contiguous arena
+   * (see DCRTPolyImpl::MakeContiguous()); falls back to the heap when the arena
+   * is exhausted or when block allocation is enabled.
+   *
+   * @param &v is the native vector to be copied.
+   * @param &arena is the arena to take the storage from.
+   */
+    NativeVectorT(const NativeVectorT& v, const std::shared_ptr<lbcrypto::ContiguousArena>& arena)
+#if BLOCK_VECTOR_ALLOCATION != 1
+        : m_modulus{v.m_modulus}, m_data(v.m_data, lbcrypto::ArenaAllocator<IntegerType>(arena)) {
+    }
+#else
+        : m_modulus{v.m_modulus}, m_data{v.m_data} {
+    }
+#endif
+
+    /**
+   * Constructor taking the storage for the vector from the next slice of an arena. When the
+   * arena is a view (e.g. of a memory-mapped file), the vector uses the values found in the
+   * slice in place; otherwise they are initialized to zero. With block allocation enabled the
+   * values are copied out of the slice.
+   *
+   * @param length is the length of the native vector.
+   * @param &modulus is the modulus of the ring.
+   * @param &arena is the arena to take the storage from.
+   */
+    NativeVectorT(usint length, const IntegerType& modulus, const std::shared_ptr<lbcrypto::ContiguousArena>& arena)
+#if BLOCK_VECTOR_ALLOCATION != 1
+        : m_modulus{modulus}, m_data(length, lbcrypto::ArenaAllocator<IntegerType>(arena)) {
+    }
+#else
+        : m_modulus{modulus}, m_data(length) {
+        if (arena->IsView()) {
+            auto p = static_cast<const IntegerType*>(arena->Allocate(length * sizeof(IntegerType)));
+            if (p == nullptr)
+                OPENFHE_THROW("the arena view is exhausted");
+            std::copy_n(p, length, m_data.begin());
+        }
+    }
+#endif
+
+    /**
+   * Returns the arena the vector takes its storage from, or nullptr for heap storage.
+   */
+    const lbcrypto::ContiguousArena* GetArena() const {
+#if BLOCK_VECTOR_ALLOCATION != 1
+        return m_data.get_allocator().GetArena().get();
+#else
+        return nullptr;
+#endif
+    }
+
+    /**
+   * Checks whether the storage of the vector is a slice of the given arena.
+   *
+   * @param *arena is the arena.
+   * @return true if the values are stored in the arena.
+   */
+    bool IsInArena(const lbcrypto::ContiguousArena* arena) const {
+#if BLOCK_VECTOR_ALLOCATION != 1
+        return arena != nullptr && m_data.get_allocator().GetArena().get() == arena && arena->Owns(m_data.data());
+#else
+        return false;
+#endif
+    }
+
     /**
    * Basic move constructor for moving a vector
    *
@@ -486,6 +555,46 @@ public:
    * @return is the result of the modulus multiplication operation.
    */
     NativeVectorT& ModMulEq(const NativeVectorT& b);
+
+    /**
+   * Converts all entries to Montgomery form x * 2^w mod q, where w is the
+   * native word size. The modulus must be odd and below 2^(w - 1). In-place.
+   *
+   * @return a reference to this vector.
+   */
+    NativeVectorT& ToMontgomeryEq();
+
+    /**
+   * Converts all entries from Montgomery form back to the standard
+   * representation. In-place.
+   *
+   * @return a reference to this vector.
+   */
+    NativeVectorT& FromMontgomeryEq();
+
+    /**
+   * Vector Montgomery modular multiplication x * y * 2^{-w} mod q. When b is in
+   * Montgomery form and this vector is not, the result is the ordinary product,
+   * which makes this a Barrett-free replacement for ModMulEq() against stored
+   * operands such as keys. Addition and subtraction are unaffected by the
+   * representation. In-place.
+   *
+   * @param &b is the vector to multiply.
+   * @return a reference to this vector.
+   */
+    NativeVectorT& ModMulMontgomeryEq(const NativeVectorT& b);
+
+    /**
+   * Vector Montgomery modular multiplication with the parameter from
+   * IntegerType::ComputeMontgomeryNegInv() of the modulus precomputed by the
+   * caller, e.g. once per tower of a chain of products. In-place.
+   *
+   * @param &b is the vector to multiply.
+   * @param &modulusNegInv is -modulus^{-1} mod 2^w.
+   * @return a reference to this vector.
+   */
+    NativeVectorT& ModMulMontgomeryEq(const NativeVectorT& b, const IntegerType& modulusNegInv);
+
     NativeVectorT& ModMulNoCheckEq(const NativeVectorT& b) {
         size_t size{m_data.size()};
         auto mv{m_modulus};
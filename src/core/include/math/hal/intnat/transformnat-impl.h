@@ -40,13 +40,21 @@
 #include "math/hal/intnat/ubintnat.h"
 #include "math/hal/intnat/mubintvecnat.h"
 #include "math/hal/intnat/transformnat.h"
+#include "math/hal/intnat/transformnat-simd.h"
 #include "math/nbtheory.h"
 
 #include "utils/exception.h"
 #include "utils/inttypes.h"
+#include "utils/parallel.h"
 #include "utils/utilities.h"
 
+#include <algorithm>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace intnat {
@@ -54,28 +62,11 @@ namespace intnat {
 using namespace lbcrypto;
 
 template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_cycloOrderInversePreconTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInverseReverseTableByModulus;
-
-template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityPreconReverseTableByModulus;
+std::map<std::pair<typename VecType::Integer, usint>, std::shared_ptr<const NTTTablesNat<VecType>>>
+    ChineseRemainderTransformFTTNat<VecType>::m_tables;
 
 template <typename VecType>
-std::map<typename VecType::Integer, VecType>
-    ChineseRemainderTransformFTTNat<VecType>::m_rootOfUnityInversePreconReverseTableByModulus;
+std::shared_mutex ChineseRemainderTransformFTTNat<VecType>::m_tablesMutex;
 
 template <typename VecType>
 std::map<typename VecType::Integer, VecType> ChineseRemainderTransformArbNat<VecType>::m_cyclotomicPolyMap;
@@ -303,6 +294,23 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlace(c
                                                                                const VecType& preconRootOfUnityTable,
                                                                                VecType* element) {
     auto modulus{element->GetModulus()};
+    bool lazy{modulus.GetMSB() <= IntType::MaxBits() - 2};
+    // checked before the SIMD transform: the blocked one runs its row stages through the SIMD kernels
+    if (lazy && element->GetLength() >= NTT_BLOCKED_MIN_SIZE)
+        return ForwardTransformToBitReverseInPlaceBlocked(rootOfUnityTable, preconRootOfUnityTable, element);
+
+    if constexpr (std::is_same_v<IntType, NativeIntegerT<uint64_t>>) {
+        static_assert(sizeof(IntType) == sizeof(uint64_t), "NativeIntegerT must be layout-compatible with uint64_t");
+        if (ForwardTransformToBitReverseInPlaceSIMD(reinterpret_cast<uint64_t*>(&(*element)[0]),
+                                                    element->GetLength(), modulus.ConvertToInt(),
+                                                    reinterpret_cast<const uint64_t*>(&rootOfUnityTable[0]),
+                                                    reinterpret_cast<const uint64_t*>(&preconRootOfUnityTable[0])))
+            return;
+    }
+
+    if (lazy)
+        return ForwardTransformToBitReverseInPlaceLazy(rootOfUnityTable, preconRootOfUnityTable, element);
+
     uint32_t n(element->GetLength() >> 1), t{n}, logt{GetMSB(t)};
     for (uint32_t m{1}; m < n; m <<= 1, t >>= 1, --logt) {
         for (uint32_t i{0}; i < m; ++i) {
@@ -355,6 +363,136 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlace(c
     }
 }
 
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlaceLazy(
+    const VecType& rootOfUnityTable, const VecType& preconRootOfUnityTable, VecType* element) {
+    auto modulus{element->GetModulus()};
+    auto twoModulus{modulus << 1};
+    uint32_t n(element->GetLength() >> 1), t{n}, logt{GetMSB(t)};
+    // all intermediate values are kept in [0, 4q)
+    for (uint32_t m{1}; m < n; m <<= 1, t >>= 1, --logt) {
+        for (uint32_t i{0}; i < m; ++i) {
+            auto omega{rootOfUnityTable[i + m]};
+            auto preconOmega{preconRootOfUnityTable[i + m]};
+            for (uint32_t j1{i << logt}, j2{j1 + t}; j1 < j2; ++j1) {
+                auto loVal{(*element)[j1 + 0]};
+                if (loVal >= twoModulus)
+                    loVal -= twoModulus;
+                auto omegaFactor{(*element)[j1 + t].ModMulFastConstLazy(omega, modulus, preconOmega)};
+                (*element)[j1 + 0] = loVal + omegaFactor;
+                (*element)[j1 + t] = loVal + twoModulus - omegaFactor;
+            }
+        }
+    }
+    // the last stage brings the output back to [0, q)
+    for (uint32_t i{0}; i < (n << 1); i += 2) {
+        auto omega{rootOfUnityTable[(i >> 1) + n]};
+        auto preconOmega{preconRootOfUnityTable[(i >> 1) + n]};
+        auto loVal{(*element)[i + 0]};
+        if (loVal >= twoModulus)
+            loVal -= twoModulus;
+        auto omegaFactor{(*element)[i + 1].ModMulFastConstLazy(omega, modulus, preconOmega)};
+        auto hiVal{loVal + omegaFactor};
+        if (hiVal >= twoModulus)
+            hiVal -= twoModulus;
+        if (hiVal >= modulus)
+            hiVal -= modulus;
+        loVal += twoModulus - omegaFactor;
+        if (loVal >= twoModulus)
+            loVal -= twoModulus;
+        if (loVal >= modulus)
+            loVal -= modulus;
+        (*element)[i + 0] = hiVal;
+        (*element)[i + 1] = loVal;
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseStages(const VecType& rootOfUnityTable,
+                                                                              const VecType& preconRootOfUnityTable,
+                                                                              uint32_t mBegin, uint32_t mEnd,
+                                                                              uint32_t block, uint32_t nBlocks,
+                                                                              VecType* element) {
+    auto modulus{element->GetModulus()};
+    uint32_t n(element->GetLength());
+    if constexpr (std::is_same_v<IntType, NativeIntegerT<uint64_t>>) {
+        if (ForwardTransformToBitReverseStagesSIMD(reinterpret_cast<uint64_t*>(&(*element)[0]), n,
+                                                   modulus.ConvertToInt(),
+                                                   reinterpret_cast<const uint64_t*>(&rootOfUnityTable[0]),
+                                                   reinterpret_cast<const uint64_t*>(&preconRootOfUnityTable[0]),
+                                                   mBegin, mEnd, block, nBlocks))
+            return;
+    }
+
+    auto twoModulus{modulus << 1};
+    for (uint32_t m{mBegin}; m < mEnd; m <<= 1) {
+        // stages with m >= nBlocks own whole groups, the others a span of a single group
+        uint32_t t{n / (m << 1)};
+        uint32_t split{m >= nBlocks ? 1 : nBlocks / m}, groups{m >= nBlocks ? m / nBlocks : 1}, span{t / split};
+        uint32_t iBegin{m >= nBlocks ? block * groups : block / split}, jBegin{(block % split) * span};
+        for (uint32_t i{iBegin}; i < iBegin + groups; ++i) {
+            auto omega{rootOfUnityTable[i + m]};
+            auto preconOmega{preconRootOfUnityTable[i + m]};
+            for (uint32_t j1{((i * t) << 1) + jBegin}, j2{j1 + span}; j1 < j2; ++j1) {
+                auto loVal{(*element)[j1 + 0]};
+                if (loVal >= twoModulus)
+                    loVal -= twoModulus;
+                auto omegaFactor{(*element)[j1 + t].ModMulFastConstLazy(omega, modulus, preconOmega)};
+                auto hiVal{loVal + omegaFactor};
+                loVal += twoModulus - omegaFactor;
+                if (t == 1) {
+                    if (hiVal >= twoModulus)
+                        hiVal -= twoModulus;
+                    if (hiVal >= modulus)
+                        hiVal -= modulus;
+                    if (loVal >= twoModulus)
+                        loVal -= twoModulus;
+                    if (loVal >= modulus)
+                        loVal -= modulus;
+                }
+                (*element)[j1 + 0] = hiVal;
+                (*element)[j1 + t] = loVal;
+            }
+        }
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverseInPlaceBlocked(
+    const VecType& rootOfUnityTable, const VecType& preconRootOfUnityTable, VecType* element) {
+    uint32_t n(element->GetLength());
+    if (n <= NTT_BLOCK_SIZE)
+        return ForwardTransformToBitReverseInPlaceLazy(rootOfUnityTable, preconRootOfUnityTable, element);
+
+    auto modulus{element->GetModulus()};
+    auto twoModulus{modulus << 1};
+    // the column stages (m < rows) combine words a multiple of NTT_BLOCK_SIZE apart; all of them
+    // run on a chunk of `width` columns, i.e., rows * width words, before moving to the next chunk
+    uint32_t rows{n / NTT_BLOCK_SIZE}, width{std::max<uint32_t>(NTT_BLOCK_SIZE / rows, 8)};
+    for (uint32_t c{0}; c < NTT_BLOCK_SIZE; c += width) {
+        for (uint32_t m{1}; m < rows; m <<= 1) {
+            uint32_t t{n / (m << 1)};
+            for (uint32_t i{0}; i < m; ++i) {
+                auto omega{rootOfUnityTable[i + m]};
+                auto preconOmega{preconRootOfUnityTable[i + m]};
+                for (uint32_t r{((i * t) << 1) + c}, rEnd{r + t}; r < rEnd; r += NTT_BLOCK_SIZE) {
+                    for (uint32_t j1{r}, j2{r + width}; j1 < j2; ++j1) {
+                        auto loVal{(*element)[j1 + 0]};
+                        if (loVal >= twoModulus)
+                            loVal -= twoModulus;
+                        auto omegaFactor{(*element)[j1 + t].ModMulFastConstLazy(omega, modulus, preconOmega)};
+                        (*element)[j1 + 0] = loVal + omegaFactor;
+                        (*element)[j1 + t] = loVal + twoModulus - omegaFactor;
+                    }
+                }
+            }
+        }
+    }
+    // the row stages only combine words within a row, which stays in the cache for all of them
+    for (uint32_t row{0}; row < rows; ++row)
+        ForwardTransformToBitReverseStages(rootOfUnityTable, preconRootOfUnityTable, rows, n, row, rows, element);
+}
+
 template <typename VecType>
 void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverse(const VecType& element,
                                                                         const VecType& rootOfUnityTable,
@@ -374,6 +512,21 @@ void NumberTheoreticTransformNat<VecType>::ForwardTransformToBitReverse(const Ve
         (*result)[i] = element[i];
     }
 
+    bool lazy{modulus.GetMSB() <= IntType::MaxBits() - 2};
+    if (lazy && n >= NTT_BLOCKED_MIN_SIZE)
+        return ForwardTransformToBitReverseInPlaceBlocked(rootOfUnityTable, preconRootOfUnityTable, result);
+
+    if constexpr (std::is_same_v<IntType, NativeIntegerT<uint64_t>>) {
+        if (ForwardTransformToBitReverseInPlaceSIMD(reinterpret_cast<uint64_t*>(&(*result)[0]), n,
+                                                    modulus.ConvertToInt(),
+                                                    reinterpret_cast<const uint64_t*>(&rootOfUnityTable[0]),
+                                                    reinterpret_cast<const uint64_t*>(&preconRootOfUnityTable[0])))
+            return;
+    }
+
+    if (lazy)
+        return ForwardTransformToBitReverseInPlaceLazy(rootOfUnityTable, preconRootOfUnityTable, result);
+
     uint32_t indexOmega, indexHi;
     NativeInteger preconOmega;
     IntType omega, omegaFactor, loVal, hiVal, zero(0);
@@ -495,6 +648,25 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlace
     const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, const IntType& cycloOrderInv,
     const IntType& preconCycloOrderInv, VecType* element) {
     auto modulus{element->GetModulus()};
+    bool lazy{modulus.GetMSB() <= IntType::MaxBits() - 2};
+    // checked before the SIMD transform: the blocked one runs its row stages through the SIMD kernels
+    if (lazy && element->GetLength() >= NTT_BLOCKED_MIN_SIZE)
+        return InverseTransformFromBitReverseInPlaceBlocked(rootOfUnityInverseTable, preconRootOfUnityInverseTable,
+                                                            cycloOrderInv, preconCycloOrderInv, element);
+
+    if constexpr (std::is_same_v<IntType, NativeIntegerT<uint64_t>>) {
+        if (InverseTransformFromBitReverseInPlaceSIMD(
+                reinterpret_cast<uint64_t*>(&(*element)[0]), element->GetLength(), modulus.ConvertToInt(),
+                reinterpret_cast<const uint64_t*>(&rootOfUnityInverseTable[0]),
+                reinterpret_cast<const uint64_t*>(&preconRootOfUnityInverseTable[0]), cycloOrderInv.ConvertToInt(),
+                preconCycloOrderInv.ConvertToInt()))
+            return;
+    }
+
+    if (lazy)
+        return InverseTransformFromBitReverseInPlaceLazy(rootOfUnityInverseTable, preconRootOfUnityInverseTable,
+                                                         cycloOrderInv, preconCycloOrderInv, element);
+
     uint32_t n(element->GetLength());
     for (uint32_t i{0}; i < n; i += 2) {
         auto omega{rootOfUnityInverseTable[(i + n) >> 1]};
@@ -553,6 +725,161 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlace
     }
 }
 
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlaceLazy(
+    const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, const IntType& cycloOrderInv,
+    const IntType& preconCycloOrderInv, VecType* element) {
+    auto modulus{element->GetModulus()};
+    auto twoModulus{modulus << 1};
+    uint32_t n(element->GetLength());
+    uint32_t m{n >> 1}, t{1}, logt{1};
+    // all intermediate values are kept in [0, 2q)
+    for (; m > 1; m >>= 1, t <<= 1, ++logt) {
+        for (uint32_t i{0}; i < m; ++i) {
+            auto omega{rootOfUnityInverseTable[i + m]};
+            auto preconOmega{preconRootOfUnityInverseTable[i + m]};
+            for (uint32_t j1{i << logt}, j2{j1 + t}; j1 < j2; ++j1) {
+                auto hiVal{(*element)[j1 + t]};
+                auto loVal{(*element)[j1 + 0]};
+                auto omegaFactor{loVal + twoModulus - hiVal};
+                loVal += hiVal;
+                if (loVal >= twoModulus)
+                    loVal -= twoModulus;
+                (*element)[j1 + 0] = loVal;
+                (*element)[j1 + t] = omegaFactor.ModMulFastConstLazy(omega, modulus, preconOmega);
+            }
+        }
+    }
+    // the scaling by n^{-1} is merged into the last stage, which also brings the output back to [0, q)
+    if (m == 0)
+        return;
+    auto omega{rootOfUnityInverseTable[1].ModMulFastConst(cycloOrderInv, modulus, preconCycloOrderInv)};
+    auto preconOmega{omega.PrepModMulConst(modulus)};
+    for (uint32_t j1{0}; j1 < t; ++j1) {
+        auto hiVal{(*element)[j1 + t]};
+        auto loVal{(*element)[j1 + 0]};
+        auto omegaFactor{(loVal + twoModulus - hiVal).ModMulFastConstLazy(omega, modulus, preconOmega)};
+        loVal = (loVal + hiVal).ModMulFastConstLazy(cycloOrderInv, modulus, preconCycloOrderInv);
+        if (omegaFactor >= modulus)
+            omegaFactor -= modulus;
+        if (loVal >= modulus)
+            loVal -= modulus;
+        (*element)[j1 + 0] = loVal;
+        (*element)[j1 + t] = omegaFactor;
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseStages(
+    const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, const IntType& cycloOrderInv,
+    const IntType& preconCycloOrderInv, uint32_t mBegin, uint32_t mEnd, uint32_t block, uint32_t nBlocks,
+    VecType* element) {
+    auto modulus{element->GetModulus()};
+    uint32_t n(element->GetLength());
+    if constexpr (std::is_same_v<IntType, NativeIntegerT<uint64_t>>) {
+        if (InverseTransformFromBitReverseStagesSIMD(
+                reinterpret_cast<uint64_t*>(&(*element)[0]), n, modulus.ConvertToInt(),
+                reinterpret_cast<const uint64_t*>(&rootOfUnityInverseTable[0]),
+                reinterpret_cast<const uint64_t*>(&preconRootOfUnityInverseTable[0]), cycloOrderInv.ConvertToInt(),
+                preconCycloOrderInv.ConvertToInt(), mBegin, mEnd, block, nBlocks))
+            return;
+    }
+
+    auto twoModulus{modulus << 1};
+    for (uint32_t m{mEnd >> 1}; m >= mBegin && m > 0; m >>= 1) {
+        // stages with m >= nBlocks own whole groups, the others a span of a single group
+        uint32_t t{n / (m << 1)};
+        uint32_t split{m >= nBlocks ? 1 : nBlocks / m}, groups{m >= nBlocks ? m / nBlocks : 1}, span{t / split};
+        uint32_t iBegin{m >= nBlocks ? block * groups : block / split}, jBegin{(block % split) * span};
+        for (uint32_t i{iBegin}; i < iBegin + groups; ++i) {
+            auto omega{rootOfUnityInverseTable[i + m]};
+            auto preconOmega{preconRootOfUnityInverseTable[i + m]};
+            if (m == 1) {
+                // the scaling by n^{-1} is merged into the last stage
+                omega       = omega.ModMulFastConst(cycloOrderInv, modulus, preconCycloOrderInv);
+                preconOmega = omega.PrepModMulConst(modulus);
+            }
+            for (uint32_t j1{((i * t) << 1) + jBegin}, j2{j1 + span}; j1 < j2; ++j1) {
+                auto hiVal{(*element)[j1 + t]};
+                auto loVal{(*element)[j1 + 0]};
+                auto omegaFactor{(loVal + twoModulus - hiVal).ModMulFastConstLazy(omega, modulus, preconOmega)};
+                loVal += hiVal;
+                if (m == 1) {
+                    loVal = loVal.ModMulFastConstLazy(cycloOrderInv, modulus, preconCycloOrderInv);
+                    if (loVal >= modulus)
+                        loVal -= modulus;
+                    if (omegaFactor >= modulus)
+                        omegaFactor -= modulus;
+                }
+                else if (loVal >= twoModulus) {
+                    loVal -= twoModulus;
+                }
+                (*element)[j1 + 0] = loVal;
+                (*element)[j1 + t] = omegaFactor;
+            }
+        }
+    }
+}
+
+template <typename VecType>
+void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverseInPlaceBlocked(
+    const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable, const IntType& cycloOrderInv,
+    const IntType& preconCycloOrderInv, VecType* element) {
+    uint32_t n(element->GetLength());
+    if (n <= NTT_BLOCK_SIZE)
+        return InverseTransformFromBitReverseInPlaceLazy(rootOfUnityInverseTable, preconRootOfUnityInverseTable,
+                                                         cycloOrderInv, preconCycloOrderInv, element);
+
+    // the row stages only combine words within a row, which stays in the cache for all of them
+    uint32_t rows{n / NTT_BLOCK_SIZE}, width{std::max<uint32_t>(NTT_BLOCK_SIZE / rows, 8)};
+    for (uint32_t row{0}; row < rows; ++row)
+        InverseTransformFromBitReverseStages(rootOfUnityInverseTable, preconRootOfUnityInverseTable, cycloOrderInv,
+                                             preconCycloOrderInv, rows, n, row, rows, element);
+
+    auto modulus{element->GetModulus()};
+    auto twoModulus{modulus << 1};
+    // the scaling by n^{-1} is merged into the last stage (m = 1)
+    auto omegaLast{rootOfUnityInverseTable[1].ModMulFastConst(cycloOrderInv, modulus, preconCycloOrderInv)};
+    auto preconOmegaLast{omegaLast.PrepModMulConst(modulus)};
+    // the column stages run on a chunk of `width` columns, i.e., rows * width words, at a time
+    for (uint32_t c{0}; c < NTT_BLOCK_SIZE; c += width) {
+        for (uint32_t m{rows >> 1}; m > 1; m >>= 1) {
+            uint32_t t{n / (m << 1)};
+            for (uint32_t i{0}; i < m; ++i) {
+                auto omega{rootOfUnityInverseTable[i + m]};
+                auto preconOmega{preconRootOfUnityInverseTable[i + m]};
+                for (uint32_t r{((i * t) << 1) + c}, rEnd{r + t}; r < rEnd; r += NTT_BLOCK_SIZE) {
+                    for (uint32_t j1{r}, j2{r + width}; j1 < j2; ++j1) {
+                        auto hiVal{(*element)[j1 + t]};
+                        auto loVal{(*element)[j1 + 0]};
+                        auto omegaFactor{loVal + twoModulus - hiVal};
+                        loVal += hiVal;
+                        if (loVal >= twoModulus)
+                            loVal -= twoModulus;
+                        (*element)[j1 + 0] = loVal;
+                        (*element)[j1 + t] = omegaFactor.ModMulFastConstLazy(omega, modulus, preconOmega);
+                    }
+                }
+            }
+        }
+        uint32_t t{n >> 1};
+        for (uint32_t r{c}; r < t; r += NTT_BLOCK_SIZE) {
+            for (uint32_t j1{r}, j2{r + width}; j1 < j2; ++j1) {
+                auto hiVal{(*element)[j1 + t]};
+                auto loVal{(*element)[j1 + 0]};
+                auto omegaFactor{(loVal + twoModulus - hiVal).ModMulFastConstLazy(omegaLast, modulus, preconOmegaLast)};
+                loVal = (loVal + hiVal).ModMulFastConstLazy(cycloOrderInv, modulus, preconCycloOrderInv);
+                if (omegaFactor >= modulus)
+                    omegaFactor -= modulus;
+                if (loVal >= modulus)
+                    loVal -= modulus;
+                (*element)[j1 + 0] = loVal;
+                (*element)[j1 + t] = omegaFactor;
+            }
+        }
+    }
+}
+
 template <typename VecType>
 void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverse(
     const VecType& element, const VecType& rootOfUnityInverseTable, const VecType& preconRootOfUnityInverseTable,
@@ -573,6 +900,77 @@ void NumberTheoreticTransformNat<VecType>::InverseTransformFromBitReverse(
     return;
 }
 
+template <typename VecType>
+NTTTablesNat<VecType>::NTTTablesNat(const IntType& rootOfUnity, usint CycloOrder, const IntType& modulus) {
+    // Half of cyclo order
+    usint CycloOrderHf = (CycloOrder >> 1);
+    usint msb          = GetMSB(CycloOrderHf - 1);
+
+    IntType x(1), xinv(1);
+    IntType mu = modulus.ComputeMu();
+    rootOfUnityReverseTable        = VecType(CycloOrderHf, modulus);
+    rootOfUnityInverseReverseTable = VecType(CycloOrderHf, modulus);
+    IntType rootOfUnityInverse     = rootOfUnity.ModInverse(modulus);
+    for (usint i = 0; i < CycloOrderHf; i++) {
+        usint iinv                           = ReverseBits(i, msb);
+        rootOfUnityReverseTable[iinv]        = x;
+        rootOfUnityInverseReverseTable[iinv] = xinv;
+        x.ModMulEq(rootOfUnity, modulus, mu);
+        xinv.ModMulEq(rootOfUnityInverse, modulus, mu);
+    }
+
+    NativeInteger nativeModulus          = modulus.ConvertToInt();
+    rootOfUnityPreconReverseTable        = VecType(CycloOrderHf, nativeModulus);
+    rootOfUnityInversePreconReverseTable = VecType(CycloOrderHf, nativeModulus);
+    for (usint i = 0; i < CycloOrderHf; i++) {
+        rootOfUnityPreconReverseTable[i] =
+            NativeInteger(rootOfUnityReverseTable[i].ConvertToInt()).PrepModMulConst(nativeModulus);
+        rootOfUnityInversePreconReverseTable[i] =
+            NativeInteger(rootOfUnityInverseReverseTable[i].ConvertToInt()).PrepModMulConst(nativeModulus);
+    }
+
+    cycloOrderInv       = IntType(CycloOrderHf).ModInverse(modulus);
+    cycloOrderInvPrecon = NativeInteger(cycloOrderInv.ConvertToInt()).PrepModMulConst(nativeModulus);
+}
+
+template <typename VecType>
+std::shared_ptr<const NTTTablesNat<VecType>> ChineseRemainderTransformFTTNat<VecType>::GetTables(
+    const IntType& rootOfUnity, usint CycloOrder, const IntType& modulus) {
+    std::pair<IntType, usint> key{modulus, CycloOrder};
+    {
+        std::shared_lock<std::shared_mutex> lock(m_tablesMutex);
+        auto mapSearch = m_tables.find(key);
+        if (mapSearch != m_tables.end())
+            return mapSearch->second;
+    }
+
+    // the tables are built without holding the lock; if another thread registers tables for
+    // the same key in the meantime, its tables are kept and these ones are dropped
+    auto tables = std::make_shared<const NTTTablesNat<VecType>>(rootOfUnity, CycloOrder, modulus);
+    std::unique_lock<std::shared_mutex> lock(m_tablesMutex);
+    return m_tables.emplace(std::move(key), std::move(tables)).first->second;
+}
+
+template <typename VecType>
+std::vector<std::shared_ptr<const NTTTablesNat<VecType>>> ChineseRemainderTransformFTTNat<VecType>::GetTables(
+    const std::vector<IntType>& rootOfUnity, usint CycloOrder, const std::vector<VecType*>& elements) {
+    if (rootOfUnity.size() != elements.size()) {
+        OPENFHE_THROW("the number of roots of unity must be equal to the number of elements");
+    }
+
+    if (!IsPowerOfTwo(CycloOrder)) {
+        OPENFHE_THROW("CyclotomicOrder is not a power of two");
+    }
+
+    // the tables are shared with the registry so that a concurrent Reset() cannot free them
+    std::vector<std::shared_ptr<const NTTTablesNat<VecType>>> tables(elements.size());
+    for (size_t i = 0; i < elements.size(); ++i) {
+        if (rootOfUnity[i] != IntType(1) && rootOfUnity[i] != IntType(0))
+            tables[i] = GetTables(rootOfUnity[i], CycloOrder, elements[i]->GetModulus());
+    }
+    return tables;
+}
+
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(const IntType& rootOfUnity,
                                                                                    const usint CycloOrder,
@@ -585,20 +983,92 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPla
         OPENFHE_THROW("CyclotomicOrder is not a power of two");
     }
 
-    usint CycloOrderHf = (CycloOrder >> 1);
-    if (element->GetLength() != CycloOrderHf) {
+    ForwardTransformToBitReverseInPlace(*GetTables(rootOfUnity, CycloOrder, element->GetModulus()), element);
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(const NTTTablesNat<VecType>& tables,
+                                                                                   VecType* element) {
+    if (element->GetLength() != tables.rootOfUnityReverseTable.GetLength()) {
         OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element->GetModulus();
+    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
+        tables.rootOfUnityReverseTable, tables.rootOfUnityPreconReverseTable, element);
+}
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlaceButLast(
+    const NTTTablesNat<VecType>& tables, VecType* element) {
+    uint32_t n(element->GetLength());
+    if (n != tables.rootOfUnityReverseTable.GetLength()) {
+        OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+    }
+    if (element->GetModulus().GetMSB() > IntType::MaxBits() - 2) {
+        OPENFHE_THROW("the modulus is too large for the lazy butterflies");
     }
 
-    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
-        m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus], element);
+    NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseStages(
+        tables.rootOfUnityReverseTable, tables.rootOfUnityPreconReverseTable, 1, n >> 1, 0, 1, element);
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(
+    const std::vector<IntType>& rootOfUnity, const usint CycloOrder, const std::vector<VecType*>& elements) {
+    ForwardTransformToBitReverseInPlace(GetTables(rootOfUnity, CycloOrder, elements), elements);
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverseInPlace(
+    const std::vector<std::shared_ptr<const NTTTablesNat<VecType>>>& tables, const std::vector<VecType*>& elements) {
+    uint32_t size(elements.size());
+    if (tables.size() != size) {
+        OPENFHE_THROW("the number of tables must be equal to the number of elements");
+    }
+    if (size == 0)
+        return;
+
+    uint32_t n(elements[0]->GetLength());
+    for (uint32_t i = 0; i < size; ++i) {
+        if (elements[i]->GetLength() != n ||
+            (tables[i] != nullptr && tables[i]->rootOfUnityReverseTable.GetLength() != n)) {
+            OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+        }
+    }
+
+    int threads{OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::NTT, static_cast<size_t>(size) * n)};
+    uint32_t nBlocks{GetBlockCount(n, elements)};
+    if (nBlocks == 1) {
+#pragma omp parallel for num_threads(std::min<int>(threads, size))
+        for (uint32_t i = 0; i < size; ++i) {
+            if (tables[i] != nullptr)
+                NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseInPlace(
+                    tables[i]->rootOfUnityReverseTable, tables[i]->rootOfUnityPreconReverseTable, elements[i]);
+        }
+        return;
+    }
+
+    // the stages spanning more than one block, each one shared by all blocks of a vector
+    uint32_t items{size * nBlocks};
+    for (uint32_t m = 1; m < nBlocks; m <<= 1) {
+#pragma omp parallel for num_threads(std::min<int>(threads, items))
+        for (uint32_t k = 0; k < items; ++k) {
+            uint32_t i{k / nBlocks};
+            if (tables[i] != nullptr)
+                NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseStages(
+                    tables[i]->rootOfUnityReverseTable, tables[i]->rootOfUnityPreconReverseTable, m, m << 1,
+                    k % nBlocks, nBlocks, elements[i]);
+        }
+    }
+    // the remaining stages, independent for every block
+#pragma omp parallel for num_threads(std::min<int>(threads, items))
+    for (uint32_t k = 0; k < items; ++k) {
+        uint32_t i{k / nBlocks};
+        if (tables[i] != nullptr)
+            NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverseStages(
+                tables[i]->rootOfUnityReverseTable, tables[i]->rootOfUnityPreconReverseTable, nBlocks, n,
+                k % nBlocks, nBlocks, elements[i]);
+    }
 }
 
 template <typename VecType>
@@ -619,16 +1089,9 @@ void ChineseRemainderTransformFTTNat<VecType>::ForwardTransformToBitReverse(cons
         OPENFHE_THROW("result size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element.GetModulus();
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
-
+    auto tables = GetTables(rootOfUnity, CycloOrder, element.GetModulus());
     NumberTheoreticTransformNat<VecType>().ForwardTransformToBitReverse(
-        element, m_rootOfUnityReverseTableByModulus[modulus], m_rootOfUnityPreconReverseTableByModulus[modulus],
-        result);
+        element, tables->rootOfUnityReverseTable, tables->rootOfUnityPreconReverseTable, result);
 
     return;
 }
@@ -645,23 +1108,99 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInP
         OPENFHE_THROW("CyclotomicOrder is not a power of two");
     }
 
-    usint CycloOrderHf = (CycloOrder >> 1);
-    if (element->GetLength() != CycloOrderHf) {
+    InverseTransformFromBitReverseInPlace(*GetTables(rootOfUnity, CycloOrder, element->GetModulus()), element);
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(
+    const NTTTablesNat<VecType>& tables, VecType* element) {
+    if (element->GetLength() != tables.rootOfUnityInverseReverseTable.GetLength()) {
         OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element->GetModulus();
+    NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
+        tables.rootOfUnityInverseReverseTable, tables.rootOfUnityInversePreconReverseTable, tables.cycloOrderInv,
+        tables.cycloOrderInvPrecon, element);
+}
+
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(
+    const std::vector<IntType>& rootOfUnity, const usint CycloOrder, const std::vector<VecType*>& elements) {
+    InverseTransformFromBitReverseInPlace(GetTables(rootOfUnity, CycloOrder, elements), elements);
+}
 
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
+template <typename VecType>
+void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverseInPlace(
+    const std::vector<std::shared_ptr<const NTTTablesNat<VecType>>>& tables, const std::vector<VecType*>& elements) {
+    uint32_t size(elements.size());
+    if (tables.size() != size) {
+        OPENFHE_THROW("the number of tables must be equal to the number of elements");
     }
+    if (size == 0)
+        return;
 
-    usint msb = GetMSB(CycloOrderHf - 1);
-    NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb],
-        element);
+    uint32_t n(elements[0]->GetLength());
+    for (uint32_t i = 0; i < size; ++i) {
+        if (elements[i]->GetLength() != n ||
+            (tables[i] != nullptr && tables[i]->rootOfUnityInverseReverseTable.GetLength() != n)) {
+            OPENFHE_THROW("element size must be equal to CyclotomicOrder / 2");
+        }
+    }
+
+    int threads{OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::NTT, static_cast<size_t>(size) * n)};
+    uint32_t nBlocks{GetBlockCount(n, elements)};
+    if (nBlocks == 1) {
+#pragma omp parallel for num_threads(std::min<int>(threads, size))
+        for (uint32_t i = 0; i < size; ++i) {
+            if (tables[i] != nullptr)
+                NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
+                    tables[i]->rootOfUnityInverseReverseTable, tables[i]->rootOfUnityInversePreconReverseTable,
+                    tables[i]->cycloOrderInv, tables[i]->cycloOrderInvPrecon, elements[i]);
+        }
+        return;
+    }
+
+    // the stages within a block, independent for every block
+    uint32_t items{size * nBlocks};
+#pragma omp parallel for num_threads(std::min<int>(threads, items))
+    for (uint32_t k = 0; k < items; ++k) {
+        uint32_t i{k / nBlocks};
+        if (tables[i] != nullptr)
+            NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseStages(
+                tables[i]->rootOfUnityInverseReverseTable, tables[i]->rootOfUnityInversePreconReverseTable,
+                tables[i]->cycloOrderInv, tables[i]->cycloOrderInvPrecon, nBlocks, n, k % nBlocks, nBlocks,
+                elements[i]);
+    }
+    // the stages spanning more than one block, each one shared by all blocks of a vector
+    for (uint32_t m = nBlocks >> 1; m >= 1; m >>= 1) {
+#pragma omp parallel for num_threads(std::min<int>(threads, items))
+        for (uint32_t k = 0; k < items; ++k) {
+            uint32_t i{k / nBlocks};
+            if (tables[i] != nullptr)
+                NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseStages(
+                    tables[i]->rootOfUnityInverseReverseTable, tables[i]->rootOfUnityInversePreconReverseTable,
+                    tables[i]->cycloOrderInv, tables[i]->cycloOrderInvPrecon, m, m << 1, k % nBlocks, nBlocks,
+                    elements[i]);
+        }
+    }
+}
+
+template <typename VecType>
+uint32_t ChineseRemainderTransformFTTNat<VecType>::GetBlockCount(uint32_t n, const std::vector<VecType*>& elements) {
+    uint32_t size(elements.size());
+    uint32_t threads(OpenFHEParallelControls.GetKernelThreadLimit(ParallelKernel::NTT, static_cast<size_t>(size) * n));
+    if (size == 0 || size >= threads)
+        return 1;
+    // the staged transforms rely on the lazy butterflies
+    for (auto element : elements) {
+        if (element->GetModulus().GetMSB() > IntType::MaxBits() - 2)
+            return 1;
+    }
+    uint32_t grain(OpenFHEParallelControls.GetKernelGrain(ParallelKernel::NTT));
+    uint32_t nBlocks{1};
+    while (nBlocks * size < threads && n / (nBlocks << 1) >= grain)
+        nBlocks <<= 1;
+    return nBlocks;
 }
 
 template <typename VecType>
@@ -682,12 +1221,7 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
         OPENFHE_THROW("result size must be equal to CyclotomicOrder / 2");
     }
 
-    IntType modulus = element.GetModulus();
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-        PreCompute(rootOfUnity, CycloOrder, modulus);
-    }
+    auto tables = GetTables(rootOfUnity, CycloOrder, element.GetModulus());
 
     usint n = element.GetLength();
     result->SetModulus(element.GetModulus());
@@ -695,10 +1229,9 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
         (*result)[i] = element[i];
     }
 
-    usint msb = GetMSB(CycloOrderHf - 1);
     NumberTheoreticTransformNat<VecType>().InverseTransformFromBitReverseInPlace(
-        m_rootOfUnityInverseReverseTableByModulus[modulus], m_rootOfUnityInversePreconReverseTableByModulus[modulus],
-        m_cycloOrderInverseTableByModulus[modulus][msb], m_cycloOrderInversePreconTableByModulus[modulus][msb], result);
+        tables->rootOfUnityInverseReverseTable, tables->rootOfUnityInversePreconReverseTable, tables->cycloOrderInv,
+        tables->cycloOrderInvPrecon, result);
 
     return;
 }
@@ -706,59 +1239,7 @@ void ChineseRemainderTransformFTTNat<VecType>::InverseTransformFromBitReverse(co
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::PreCompute(const IntType& rootOfUnity, const usint CycloOrder,
                                                           const IntType& modulus) {
-    // Half of cyclo order
-    usint CycloOrderHf = (CycloOrder >> 1);
-
-    auto mapSearch = m_rootOfUnityReverseTableByModulus.find(modulus);
-    if (mapSearch == m_rootOfUnityReverseTableByModulus.end() || mapSearch->second.GetLength() != CycloOrderHf) {
-#pragma omp critical
-        {
-            IntType x(1), xinv(1);
-            usint msb  = GetMSB(CycloOrderHf - 1);
-            IntType mu = modulus.ComputeMu();
-            VecType Table(CycloOrderHf, modulus);
-            VecType TableI(CycloOrderHf, modulus);
-            IntType rootOfUnityInverse = rootOfUnity.ModInverse(modulus);
-            usint iinv;
-            for (usint i = 0; i < CycloOrderHf; i++) {
-                iinv         = ReverseBits(i, msb);
-                Table[iinv]  = x;
-                TableI[iinv] = xinv;
-                x.ModMulEq(rootOfUnity, modulus, mu);
-                xinv.ModMulEq(rootOfUnityInverse, modulus, mu);
-            }
-            m_rootOfUnityReverseTableByModulus[modulus]        = Table;
-            m_rootOfUnityInverseReverseTableByModulus[modulus] = TableI;
-
-            VecType TableCOI(msb + 1, modulus);
-            for (usint i = 0; i < msb + 1; i++) {
-                IntType coInv(IntType(1 << i).ModInverse(modulus));
-                TableCOI[i] = coInv;
-            }
-            m_cycloOrderInverseTableByModulus[modulus] = TableCOI;
-
-            NativeInteger nativeModulus = modulus.ConvertToInt();
-            VecType preconTable(CycloOrderHf, nativeModulus);
-            VecType preconTableI(CycloOrderHf, nativeModulus);
-
-            for (usint i = 0; i < CycloOrderHf; i++) {
-                preconTable[i] = NativeInteger(m_rootOfUnityReverseTableByModulus[modulus][i].ConvertToInt())
-                                     .PrepModMulConst(nativeModulus);
-                preconTableI[i] = NativeInteger(m_rootOfUnityInverseReverseTableByModulus[modulus][i].ConvertToInt())
-                                      .PrepModMulConst(nativeModulus);
-            }
-
-            VecType preconTableCOI(msb + 1, nativeModulus);
-            for (usint i = 0; i < msb + 1; i++) {
-                preconTableCOI[i] = NativeInteger(m_cycloOrderInverseTableByModulus[modulus][i].ConvertToInt())
-                                        .PrepModMulConst(nativeModulus);
-            }
-
-            m_rootOfUnityPreconReverseTableByModulus[modulus]        = preconTable;
-            m_rootOfUnityInversePreconReverseTableByModulus[modulus] = preconTableI;
-            m_cycloOrderInversePreconTableByModulus[modulus]         = preconTableCOI;
-        }
-    }
+    GetTables(rootOfUnity, CycloOrder, modulus);
 }
 
 template <typename VecType>
@@ -780,12 +1261,9 @@ void ChineseRemainderTransformFTTNat<VecType>::PreCompute(std::vector<IntType>&
 
 template <typename VecType>
 void ChineseRemainderTransformFTTNat<VecType>::Reset() {
-    m_cycloOrderInverseTableByModulus.clear();
-    m_cycloOrderInversePreconTableByModulus.clear();
-    m_rootOfUnityReverseTableByModulus.clear();
-    m_rootOfUnityInverseReverseTableByModulus.clear();
-    m_rootOfUnityPreconReverseTableByModulus.clear();
-    m_rootOfUnityInversePreconReverseTableByModulus.clear();
+    // tables still held by element parameters stay valid
+    std::unique_lock<std::shared_mutex> lock(m_tablesMutex);
+    m_tables.clear();
 }
 
 template <typename VecType>
@@ -0,0 +1,143 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Runtime-dispatched vectorized kernels for the native (64-bit) number theoretic transform
+ */
+
+#ifndef LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+#define LBCRYPTO_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_H
+
+#include <cstdint>
+
+namespace intnat {
+
+/**
+ * @brief Instruction set used by the native NTT. The vectorized backends produce
+ * exactly the same (fully reduced) output as the scalar implementation.
+ *
+ * NTT_SIMD_AVX512IFMA is used for moduli below 2^50, NTT_SIMD_AVX512 for moduli
+ * below 2^62 and NTT_SIMD_AVX2 for moduli below 2^61; larger moduli always use
+ * the scalar code.
+ */
+enum NTTSimdBackend {
+    NTT_SIMD_SCALAR = 0,
+    NTT_SIMD_AVX2,
+    NTT_SIMD_AVX512,
+    NTT_SIMD_AVX512IFMA,
+};
+
+/**
+ * Returns the most capable backend supported by both the build and the CPU (detected via CPUID)
+ */
+NTTSimdBackend GetNTTSimdBackendSupported();
+
+/**
+ * Returns the backend currently used by the native NTT
+ */
+NTTSimdBackend GetNTTSimdBackend();
+
+/**
+ * Selects the backend used by the native NTT, e.g., to compare against the scalar code.
+ * Requests for a backend that is not supported fall back to GetNTTSimdBackendSupported().
+ *
+ * @param backend the requested backend
+ * @return the backend that is now active
+ */
+NTTSimdBackend SetNTTSimdBackend(NTTSimdBackend backend);
+
+/**
+ * In-place forward transform in the ring Z_q[X]/(X^n+1) (bit-reversed output) using the
+ * active vectorized backend.
+ *
+ * @param element the n coefficients to transform, all less than modulus
+ * @param n the ring dimension (a power of two)
+ * @param modulus the prime modulus q
+ * @param rootOfUnityTable the n-th root of unity powers in bit reverse order
+ * @param preconRootOfUnityTable Shoup's precomputations for rootOfUnityTable
+ * @return false if no vectorized backend applies (the caller must then run the scalar code)
+ */
+bool ForwardTransformToBitReverseInPlaceSIMD(uint64_t* element, uint32_t n, uint64_t modulus,
+                                             const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable);
+
+/**
+ * In-place inverse transform in the ring Z_q[X]/(X^n+1) (bit-reversed input) using the
+ * active vectorized backend.
+ *
+ * @param element the n coefficients to transform, all less than modulus
+ * @param n the ring dimension (a power of two)
+ * @param modulus the prime modulus q
+ * @param rootOfUnityInverseTable the inverse root of unity powers in bit reverse order
+ * @param preconRootOfUnityInverseTable Shoup's precomputations for rootOfUnityInverseTable
+ * @param cycloOrderInv the inverse of n modulo q
+ * @param preconCycloOrderInv Shoup's precomputation for cycloOrderInv
+ * @return false if no vectorized backend applies (the caller must then run the scalar code)
+ */
+bool InverseTransformFromBitReverseInPlaceSIMD(uint64_t* element, uint32_t n, uint64_t modulus,
+                                               const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv);
+
+/**
+ * Runs part of the forward transform computed by ForwardTransformToBitReverseInPlaceSIMD(),
+ * so that the transform of one vector can be shared by several threads.
+ *
+ * The transform consists of the stages m = 1, 2, 4, ..., n/2, where stage m applies the
+ * butterflies of m groups of n/m consecutive words. The call runs the stages m in
+ * [mBegin, mEnd) restricted to the part owned by block out of nBlocks (a power of two, at
+ * most n/2): for m >= nBlocks, the block owns the groups within words
+ * [block * n / nBlocks, (block + 1) * n / nBlocks), so all these stages are independent
+ * from the other blocks; for m < nBlocks, the block owns 1 / nBlocks of the butterflies of
+ * the stage, so all blocks have to finish a stage before the next one starts.
+ *
+ * @return false if no vectorized backend applies (the caller must then run the scalar code)
+ */
+bool ForwardTransformToBitReverseStagesSIMD(uint64_t* element, uint32_t n, uint64_t modulus,
+                                            const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable,
+                                            uint32_t mBegin, uint32_t mEnd, uint32_t block, uint32_t nBlocks);
+
+/**
+ * Runs part of the inverse transform computed by InverseTransformFromBitReverseInPlaceSIMD();
+ * the stages m in [mBegin, mEnd) run from the largest to the smallest m, and the blocks are
+ * defined as in ForwardTransformToBitReverseStagesSIMD(). The multiplication by n^{-1} is
+ * done in the stage m = 1.
+ *
+ * @return false if no vectorized backend applies (the caller must then run the scalar code)
+ */
+bool InverseTransformFromBitReverseStagesSIMD(uint64_t* element, uint32_t n, uint64_t modulus,
+                                              const uint64_t* rootOfUnityInverseTable,
+                                              const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                              uint64_t preconCycloOrderInv, uint32_t mBegin, uint32_t mEnd,
+                                              uint32_t block, uint32_t nBlocks);
+
+}  // namespace intnat
+
+#endif
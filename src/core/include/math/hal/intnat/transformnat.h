@@ -41,7 +41,9 @@
 #include "utils/inttypes.h"
 
 #include <map>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -239,6 +241,173 @@ public:
                                                const VecType& preconRootOfUnityInverseTable,
                                                const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
                                                VecType* element);
+
+    /**
+   * In-place forward transform with Harvey's lazy butterflies: intermediate
+   * values are kept in [0, 4q) and only the last stage reduces to [0, q), which
+   * removes most of the conditional subtractions. Requires q < 2^(MaxBits() - 2).
+   * Called by ForwardTransformToBitReverseInPlace() whenever the modulus allows it.
+   * [Algorithm 4 in https://arxiv.org/abs/1205.2926]
+   *
+   * @param &rootOfUnityTable is the table with the root of unity powers in bit
+   * reverse order.
+   * @param &preconRootOfUnityTable is NTL-specific precomputations for
+   * optimized NativeInteger modulo multiplications.
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlaceLazy(const VecType& rootOfUnityTable,
+                                                 const VecType& preconRootOfUnityTable, VecType* element);
+
+    /**
+   * In-place inverse transform with Harvey's lazy butterflies: intermediate
+   * values are kept in [0, 2q), and the multiplication by n^{-1} is merged into
+   * the last stage, which also reduces the output to [0, q). Requires
+   * q < 2^(MaxBits() - 2). Called by InverseTransformFromBitReverseInPlace()
+   * whenever the modulus allows it.
+   *
+   * @param &rootOfUnityInverseTable is the table with the inverse 2n-th root of
+   * unity powers in bit reverse order.
+   * @param &preconRootOfUnityInverseTable is NTL-specific precomputations for
+   * optimized NativeInteger modulo multiplications.
+   * @param &cycloOrderInv is inverse of n modulo q
+   * @param &preconCycloOrderInv is NTL-specific precomputations for optimized
+   * NativeInteger modulo multiplications.
+   * @param &element[in,out] is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void InverseTransformFromBitReverseInPlaceLazy(const VecType& rootOfUnityInverseTable,
+                                                   const VecType& preconRootOfUnityInverseTable,
+                                                   const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
+                                                   VecType* element);
+
+    /**
+   * Runs the stages m in [mBegin, mEnd) of ForwardTransformToBitReverseInPlaceLazy()
+   * (m is the number of butterfly groups of a stage) restricted to the part owned by
+   * \p block out of \p nBlocks, so that several threads can share one transform.
+   * Stages with m >= nBlocks only touch the words [block * n / nBlocks, (block + 1) * n / nBlocks);
+   * stages with m < nBlocks are split evenly and must be completed by all blocks
+   * before the next stage starts. Requires q < 2^(MaxBits() - 2).
+   *
+   * @param &rootOfUnityTable is the table with the root of unity powers in bit
+   * reverse order.
+   * @param &preconRootOfUnityTable is NTL-specific precomputations for
+   * optimized NativeInteger modulo multiplications.
+   * @param mBegin first stage (a power of two)
+   * @param mEnd stage after the last one (a power of two, at most n)
+   * @param block index of the block in [0, nBlocks)
+   * @param nBlocks number of blocks, a power of two not larger than n/2
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void ForwardTransformToBitReverseStages(const VecType& rootOfUnityTable, const VecType& preconRootOfUnityTable,
+                                            uint32_t mBegin, uint32_t mEnd, uint32_t block, uint32_t nBlocks,
+                                            VecType* element);
+
+    /**
+   * Runs the stages m in [mBegin, mEnd), from the largest to the smallest m, of
+   * InverseTransformFromBitReverseInPlaceLazy() restricted to the part owned by
+   * \p block out of \p nBlocks; the blocks are defined as in
+   * ForwardTransformToBitReverseStages(). Requires q < 2^(MaxBits() - 2).
+   *
+   * @param &rootOfUnityInverseTable is the table with the inverse 2n-th root of
+   * unity powers in bit reverse order.
+   * @param &preconRootOfUnityInverseTable is NTL-specific precomputations for
+   * optimized NativeInteger modulo multiplications.
+   * @param &cycloOrderInv is inverse of n modulo q
+   * @param &preconCycloOrderInv is NTL-specific precomputations for optimized
+   * NativeInteger modulo multiplications.
+   * @param mBegin smallest stage (a power of two)
+   * @param mEnd stage after the largest one (a power of two, at most n)
+   * @param block index of the block in [0, nBlocks)
+   * @param nBlocks number of blocks, a power of two not larger than n/2
+   * @param &element[in,out] is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void InverseTransformFromBitReverseStages(const VecType& rootOfUnityInverseTable,
+                                              const VecType& preconRootOfUnityInverseTable,
+                                              const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
+                                              uint32_t mBegin, uint32_t mEnd, uint32_t block, uint32_t nBlocks,
+                                              VecType* element);
+
+    /**
+   * Cache-blocked variant of ForwardTransformToBitReverseInPlaceLazy() for large n
+   * (Bailey's four-step decomposition without the explicit transposes). Viewing the
+   * vector as an (n/B) x B matrix with B = NTT_BLOCK_SIZE, the first log(n/B) stages
+   * only combine words in the same column, so they run as n/B-point transforms on
+   * chunks of columns that fit in the cache; the remaining stages only combine words
+   * in the same row and run on one row of B words at a time. The whole vector is
+   * thus streamed through the cache twice instead of log(n) times. Called by
+   * ForwardTransformToBitReverseInPlace() for n >= NTT_BLOCKED_MIN_SIZE, also when
+   * a SIMD kernel is available: the row stages then run through that kernel.
+   * Requires q < 2^(MaxBits() - 2).
+   *
+   * @param &rootOfUnityTable is the table with the root of unity powers in bit
+   * reverse order.
+   * @param &preconRootOfUnityTable is NTL-specific precomputations for
+   * optimized NativeInteger modulo multiplications.
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlaceBlocked(const VecType& rootOfUnityTable,
+                                                    const VecType& preconRootOfUnityTable, VecType* element);
+
+    /**
+   * Cache-blocked variant of InverseTransformFromBitReverseInPlaceLazy(): the row
+   * stages run first, one row at a time, then the column stages on chunks of
+   * columns; see ForwardTransformToBitReverseInPlaceBlocked(). Called by
+   * InverseTransformFromBitReverseInPlace() for n >= NTT_BLOCKED_MIN_SIZE.
+   * Requires q < 2^(MaxBits() - 2).
+   *
+   * @param &rootOfUnityInverseTable is the table with the inverse 2n-th root of
+   * unity powers in bit reverse order.
+   * @param &preconRootOfUnityInverseTable is NTL-specific precomputations for
+   * optimized NativeInteger modulo multiplications.
+   * @param &cycloOrderInv is inverse of n modulo q
+   * @param &preconCycloOrderInv is NTL-specific precomputations for optimized
+   * NativeInteger modulo multiplications.
+   * @param &element[in,out] is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void InverseTransformFromBitReverseInPlaceBlocked(const VecType& rootOfUnityInverseTable,
+                                                      const VecType& preconRootOfUnityInverseTable,
+                                                      const IntType& cycloOrderInv, const IntType& preconCycloOrderInv,
+                                                      VecType* element);
+
+    /// number of words of a row of the cache-blocked transforms (32 KB)
+    static constexpr uint32_t NTT_BLOCK_SIZE{1 << 12};
+    /// smallest transform length for which the cache-blocked transforms are used
+    static constexpr uint32_t NTT_BLOCKED_MIN_SIZE{1 << 16};
+};
+
+/**
+ * @brief Precomputed tables for the transforms modulo one prime q in the ring
+ * Z_q[X]/(X^n+1). The tables are immutable once built, so they can be shared
+ * by any number of threads and held by the element parameters (ILParamsImpl),
+ * which saves the lookup by modulus in every transform.
+ */
+template <typename VecType>
+struct NTTTablesNat {
+    using IntType = typename VecType::Integer;
+
+    /**
+   * Computes the tables.
+   *
+   * @param &rootOfUnity is the 2n-th root of unity in Z_q.
+   * @param CycloOrder is 2n, a power of two.
+   * @param &modulus is q, the prime modulus.
+   */
+    NTTTablesNat(const IntType& rootOfUnity, usint CycloOrder, const IntType& modulus);
+
+    /// the 2n-th root of unity powers in bit reverse order and Shoup's precomputations for them
+    VecType rootOfUnityReverseTable;
+    VecType rootOfUnityPreconReverseTable;
+    /// the inverse 2n-th root of unity powers in bit reverse order and Shoup's precomputations for them
+    VecType rootOfUnityInverseReverseTable;
+    VecType rootOfUnityInversePreconReverseTable;
+    /// n^{-1} mod q and Shoup's precomputation for it
+    IntType cycloOrderInv;
+    IntType cycloOrderInvPrecon;
 };
 
 /**
@@ -249,6 +418,8 @@ class ChineseRemainderTransformFTTNat final : public lbcrypto::ChineseRemainderT
     using IntType = typename VecType::Integer;
 
 public:
+    using Tables = NTTTablesNat<VecType>;
+
     /**
    * Copies \p element into \p result and calls NumberTheoreticTransform::ForwardTransformToBitReverseInPlace()
    *
@@ -318,6 +489,91 @@ public:
    */
     void InverseTransformFromBitReverseInPlace(const IntType& rootOfUnity, const usint CycloOrder, VecType* element);
 
+    /**
+   * Batched in-place Forward Transform of several vectors, e.g., all towers of one
+   * or more DCRTPolys. The work is split into (vector, block) items: when there are
+   * fewer vectors than threads, each transform is shared by several threads, which
+   * first run the stages spanning the whole vector together and then transform
+   * their own contiguous blocks independently.
+   *
+   * @param &rootOfUnity are the 2n-th roots of unity, one per element; see
+   * ForwardTransformToBitReverseInPlace()
+   * @param CycloOrder is 2n, should be a power-of-two or a throw if an error
+   * occurs.
+   * @param &elements are the inputs/outputs of the transforms, each of length n.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlace(const std::vector<IntType>& rootOfUnity, const usint CycloOrder,
+                                             const std::vector<VecType*>& elements);
+
+    /**
+   * Batched in-place Inverse Transform of several vectors, split into (vector, block)
+   * items as in the batched ForwardTransformToBitReverseInPlace().
+   *
+   * @param &rootOfUnity are the 2n-th roots of unity, one per element; see
+   * InverseTransformFromBitReverseInPlace()
+   * @param CycloOrder is 2n, should be a power-of-two or a throw if an error
+   * occurs.
+   * @param &elements are the inputs/outputs of the transforms, each of length n.
+   * @return none
+   */
+    void InverseTransformFromBitReverseInPlace(const std::vector<IntType>& rootOfUnity, const usint CycloOrder,
+                                               const std::vector<VecType*>& elements);
+
+    /**
+   * In-place Forward Transform using tables obtained from GetTables(), e.g.,
+   * the ones held by the element parameters.
+   *
+   * @param &tables are the precomputed tables for the modulus of \p element.
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlace(const NTTTablesNat<VecType>& tables, VecType* element);
+
+    /**
+   * Runs all stages of the in-place Forward Transform but the last one (m = n/2),
+   * whose butterflies combine adjacent words, so that callers can fuse it into their
+   * own pass over the output; see PolyImpl::MultiplyAccumulate(). The values are left
+   * in [0, 4q). Requires q < 2^(MaxBits() - 2) and n >= 2.
+   *
+   * @param &tables are the precomputed tables for the modulus of \p element.
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlaceButLast(const NTTTablesNat<VecType>& tables, VecType* element);
+
+    /**
+   * In-place Inverse Transform using tables obtained from GetTables(), e.g.,
+   * the ones held by the element parameters.
+   *
+   * @param &tables are the precomputed tables for the modulus of \p element.
+   * @param[in,out] &element is the input/output of the transform of type VecType and length n.
+   * @return none
+   */
+    void InverseTransformFromBitReverseInPlace(const NTTTablesNat<VecType>& tables, VecType* element);
+
+    /**
+   * Batched in-place Forward Transform using tables obtained from GetTables();
+   * see the batched ForwardTransformToBitReverseInPlace() above.
+   *
+   * @param &tables are the precomputed tables, one per element; nullptr leaves the element unchanged.
+   * @param &elements are the inputs/outputs of the transforms, each of length n.
+   * @return none
+   */
+    void ForwardTransformToBitReverseInPlace(const std::vector<std::shared_ptr<const NTTTablesNat<VecType>>>& tables,
+                                             const std::vector<VecType*>& elements);
+
+    /**
+   * Batched in-place Inverse Transform using tables obtained from GetTables();
+   * see the batched InverseTransformFromBitReverseInPlace() above.
+   *
+   * @param &tables are the precomputed tables, one per element; nullptr leaves the element unchanged.
+   * @param &elements are the inputs/outputs of the transforms, each of length n.
+   * @return none
+   */
+    void InverseTransformFromBitReverseInPlace(
+        const std::vector<std::shared_ptr<const NTTTablesNat<VecType>>>& tables, const std::vector<VecType*>& elements);
+
     /**
    * Precomputation of root of unity tables for transforms in the ring
    * Z_q[X]/(X^n+1)
@@ -347,25 +603,33 @@ public:
    */
     void Reset();
 
-    /// map to store the cyclo order inverse with modulus as a key
-    /// For inverse FTT, we also need #m_cycloOrderInversePreconTableByModulus (this is to use an N-size NTT for FTT instead of 2N-size NTT).
-    static std::map<IntType, VecType> m_cycloOrderInverseTableByModulus;
-
-    /// map to store the cyclo order inverse preconditioned with modulus as a key
-    /// Shoup's precomputation of above #m_cycloOrderInverseTableByModulus
-    static std::map<IntType, VecType> m_cycloOrderInversePreconTableByModulus;
-
-    /// map to store the forward roots of Unity for NTT, with bits reversed, with modulus as a key (aka twiddle factors)
-    static std::map<IntType, VecType> m_rootOfUnityReverseTableByModulus;
-
-    /// map to store inverse roots of unity for iNTT, with bits reversed, with modulus as a key (aka inverse twiddle factors)
-    static std::map<IntType, VecType> m_rootOfUnityInverseReverseTableByModulus;
-
-    /// map to store Shoup's precomputations of forward roots of unity for NTT, with bits reversed, with modulus as a key
-    static std::map<IntType, VecType> m_rootOfUnityPreconReverseTableByModulus;
+    /**
+   * Returns the tables for the modulus and cyclotomic order, computing and
+   * registering them on first use. The registry lock is held only to look up or
+   * insert the shared pointer; the tables themselves are computed outside of it,
+   * so parameters for different moduli can be generated concurrently.
+   *
+   * @param &rootOfUnity is the 2n-th root of unity in Z_q.
+   * @param CycloOrder is 2n, a power of two.
+   * @param &modulus is q, the prime modulus.
+   * @return the shared immutable tables
+   */
+    static std::shared_ptr<const NTTTablesNat<VecType>> GetTables(const IntType& rootOfUnity, usint CycloOrder,
+                                                                  const IntType& modulus);
 
-    /// map to store Shoup's precomputations of inverse rou for iNTT, with bits reversed, with modulus as a key
-    static std::map<IntType, VecType> m_rootOfUnityInversePreconReverseTableByModulus;
+private:
+    // number of blocks (a power of two) each transform of a batch is split into so that
+    // all threads of the NTT budget get work; blocks never get smaller than the NTT grain
+    static uint32_t GetBlockCount(uint32_t n, const std::vector<VecType*>& elements);
+
+    // tables for the roots of unity passed to the batched transforms; nullptr for roots 0 and 1
+    static std::vector<std::shared_ptr<const NTTTablesNat<VecType>>> GetTables(const std::vector<IntType>& rootOfUnity,
+                                                                               usint CycloOrder,
+                                                                               const std::vector<VecType*>& elements);
+
+    /// registry of the tables with (modulus, cyclotomic order) as a key
+    static std::map<std::pair<IntType, usint>, std::shared_ptr<const NTTTablesNat<VecType>>> m_tables;
+    static std::shared_mutex m_tablesMutex;
 };
 
 // struct used as a key in BlueStein transform
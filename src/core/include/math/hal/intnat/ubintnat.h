@@ -1490,6 +1490,87 @@ public:
         return *this;
     }
 
+    /**
+   * Modular multiplication using a precomputation for the multiplicand,
+   * without the final correction (Harvey's lazy reduction). The operand may
+   * be any value below 2^MaxBits(); the result lies in [0, 2 * modulus).
+   *
+   * @param &b is the NativeIntegerT to multiply.
+   * @param modulus is the modulus to perform operations with.
+   * @param &bInv precomputation for b.
+   * @return is the result of the modulus multiplication operation in [0, 2 * modulus).
+   */
+    NativeIntegerT ModMulFastConstLazy(const NativeIntegerT& b, const NativeIntegerT& modulus,
+                                       const NativeIntegerT& bInv) const {
+        NativeInt q = MultDHi(m_value, bInv.m_value);
+        return {m_value * b.m_value - q * modulus.m_value};
+    }
+
+    /**
+   * Precomputes the parameter -modulus^{-1} mod 2^MaxBits() for Montgomery
+   * multiplication; called on the modulus, which must be odd.
+   *
+   * @return the precomputed parameter.
+   */
+    NativeIntegerT ComputeMontgomeryNegInv() const {
+        if ((m_value & 0x1) == 0)
+            OPENFHE_THROW("NativeIntegerT ComputeMontgomeryNegInv: the modulus must be odd");
+        // Newton's iteration doubles the number of correct low bits, starting from 3
+        NativeInt inv{m_value};
+        for (uint32_t bits = 3; bits < NativeIntegerT::MaxBits(); bits <<= 1)
+            inv *= NativeInt(2) - m_value * inv;
+        return {NativeInt(0) - inv};
+    }
+
+    /**
+   * Precomputes 2^(2 * MaxBits()) mod modulus, which converts values to
+   * Montgomery form with ModMulMontgomery(); called on the modulus.
+   *
+   * @return the precomputed parameter.
+   */
+    NativeIntegerT ComputeMontgomeryR2() const {
+        if (m_value == 0)
+            OPENFHE_THROW("NativeIntegerT ComputeMontgomeryR2: Divide by zero");
+        // 2^MaxBits() - modulus is congruent to 2^MaxBits()
+        NativeIntegerT r{static_cast<NativeInt>((NativeInt(0) - m_value) % m_value)};
+        return r.ModMul(r, *this);
+    }
+
+    /**
+   * Montgomery modular multiplication: returns this * b * 2^{-MaxBits()} mod
+   * modulus. If one operand is in Montgomery form (x * 2^MaxBits() mod modulus),
+   * the result is the plain product; if both are, the result is the product in
+   * Montgomery form. Requires an odd modulus below 2^(MaxBits() - 1) and operands
+   * below the modulus.
+   *
+   * @param &b is the NativeIntegerT to multiply.
+   * @param &modulus is the modulus to perform operations with.
+   * @param &modulusNegInv is the precomputation from ComputeMontgomeryNegInv().
+   * @return is the result of the modulus multiplication operation.
+   */
+    NativeIntegerT ModMulMontgomery(const NativeIntegerT& b, const NativeIntegerT& modulus,
+                                    const NativeIntegerT& modulusNegInv) const {
+        typeD t, u;
+        MultD(m_value, b.m_value, t);
+        MultD(t.lo * modulusNegInv.m_value, modulus.m_value, u);
+        // the low words of t and u add up to 2^MaxBits() unless both are zero
+        NativeInt r{t.hi + u.hi + (t.lo != 0)};
+        return {r >= modulus.m_value ? r - modulus.m_value : r};
+    }
+
+    /**
+   * Montgomery modular multiplication. In-place variant.
+   *
+   * @param &b is the NativeIntegerT to multiply.
+   * @param &modulus is the modulus to perform operations with.
+   * @param &modulusNegInv is the precomputation from ComputeMontgomeryNegInv().
+   * @return is the result of the modulus multiplication operation.
+   */
+    NativeIntegerT& ModMulMontgomeryEq(const NativeIntegerT& b, const NativeIntegerT& modulus,
+                                       const NativeIntegerT& modulusNegInv) {
+        return *this = ModMulMontgomery(b, modulus, modulusNegInv);
+    }
+
     /**
    * Modulus exponentiation operation.
    *
@@ -0,0 +1,268 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Aligned (optionally huge-page backed) allocation, contiguous memory arenas and the allocator used
+  by native vectors for their storage
+ */
+
+#ifndef LBCRYPTO_UTILS_ARENAALLOCATOR_H
+#define LBCRYPTO_UTILS_ARENAALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "utils/vectorpool.h"
+
+#if defined(__linux__)
+    #include <sys/mman.h>
+#endif
+
+namespace lbcrypto {
+
+// alignment of all native vector storage: one cache line, enough for 512-bit aligned loads
+constexpr size_t VECTOR_ALIGNMENT{64};
+
+// allocations of at least this size are aligned to it so that they can be backed by huge pages
+constexpr size_t HUGE_PAGE_SIZE{size_t(1) << 21};
+
+inline std::atomic<bool>& HugePagesFlag() {
+    static std::atomic<bool> flag{false};
+    return flag;
+}
+
+/**
+ * @brief Enables or disables madvise(MADV_HUGEPAGE) on allocations of HUGE_PAGE_SIZE bytes or more,
+ * so that transparent huge pages back large vectors and arenas also when the system only grants
+ * them on request. Disabled by default; has no effect on systems without MADV_HUGEPAGE.
+ */
+inline void EnableHugePages(bool enable) {
+    HugePagesFlag().store(enable, std::memory_order_relaxed);
+}
+
+inline bool HugePagesEnabled() {
+    return HugePagesFlag().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Allocates VECTOR_ALIGNMENT aligned storage, or HUGE_PAGE_SIZE aligned storage for large
+ * requests; must be released with DeallocateAligned() and the same size.
+ *
+ * Below the huge-page size the storage is aligned within one ordinary allocation that is
+ * VECTOR_ALIGNMENT bytes larger, and the pointer to that allocation is kept just in front of the
+ * aligned storage. The aligned operator new would carve every block out of a larger chunk and
+ * leave the trimmed ends as small free chunks between live vectors, which fragments the heap of
+ * long-lived keys by a third.
+ */
+inline void* AllocateAligned(size_t bytes) {
+    if (bytes < HUGE_PAGE_SIZE) {
+        static_assert(__STDCPP_DEFAULT_NEW_ALIGNMENT__ >= sizeof(void*), "no room for the base pointer");
+        void* base = ::operator new(bytes + VECTOR_ALIGNMENT);
+        auto p     = (reinterpret_cast<uintptr_t>(base) + VECTOR_ALIGNMENT) & ~uintptr_t(VECTOR_ALIGNMENT - 1);
+        reinterpret_cast<void**>(p)[-1] = base;
+        return reinterpret_cast<void*>(p);
+    }
+    void* p = ::operator new(bytes, std::align_val_t{HUGE_PAGE_SIZE});
+#if defined(MADV_HUGEPAGE)
+    if (HugePagesEnabled())
+        madvise(p, bytes & ~(HUGE_PAGE_SIZE - 1), MADV_HUGEPAGE);
+#endif
+    return p;
+}
+
+inline void DeallocateAligned(void* p, size_t bytes) noexcept {
+    if (bytes < HUGE_PAGE_SIZE)
+        ::operator delete(static_cast<void**>(p)[-1]);
+    else
+        ::operator delete(p, std::align_val_t{HUGE_PAGE_SIZE});
+}
+
+/**
+ * @brief A single aligned buffer handed out in 64-byte aligned slices by a bump pointer.
+ * Slices are never reused; the buffer is released when the last allocator referring to it is
+ * destroyed, so vectors carved out of an arena stay valid even after they are moved elsewhere.
+ *
+ * An arena can also be a view of memory it does not own, such as a memory-mapped file. Vectors
+ * taking their storage from a view adopt the values already there instead of initializing them
+ * (see ArenaAllocator::construct()).
+ */
+class ContiguousArena {
+public:
+    static constexpr size_t ALIGNMENT{VECTOR_ALIGNMENT};
+
+    explicit ContiguousArena(size_t capacity)
+        : m_capacity{RoundUp(capacity)}, m_data{static_cast<uint8_t*>(AllocateAligned(m_capacity))} {}
+
+    /**
+     * @brief Creates a view of existing memory. The polynomials laid out in it may be written in place,
+     * so the memory must be writable (a file mapping must be private, i.e. copy-on-write).
+     * @param data the start of the memory; must be ALIGNMENT aligned
+     * @param capacity the size of the memory in bytes
+     * @param owner keeps the memory alive for as long as the arena exists; must not be null
+     */
+    ContiguousArena(const void* data, size_t capacity, std::shared_ptr<const void> owner)
+        : m_capacity{capacity},
+          m_data{static_cast<uint8_t*>(const_cast<void*>(data))},
+          m_owner{std::move(owner)} {}
+
+    ~ContiguousArena() {
+        if (!m_owner)
+            DeallocateAligned(m_data, m_capacity);
+    }
+
+    ContiguousArena(const ContiguousArena&)            = delete;
+    ContiguousArena& operator=(const ContiguousArena&) = delete;
+
+    /**
+     * @brief Reserves the next slice of the arena; thread safe.
+     * @param bytes the size of the slice
+     * @return the slice or nullptr when the arena is exhausted
+     */
+    void* Allocate(size_t bytes) {
+        bytes       = RoundUp(bytes);
+        size_t used = m_used.load(std::memory_order_relaxed);
+        do {
+            if (bytes > m_capacity - used)
+                return nullptr;
+        } while (!m_used.compare_exchange_weak(used, used + bytes, std::memory_order_relaxed));
+        return m_data + used;
+    }
+
+    bool Owns(const void* p) const {
+        auto q = static_cast<const uint8_t*>(p);
+        return q >= m_data && q < m_data + m_capacity;
+    }
+
+    const uint8_t* GetData() const {
+        return m_data;
+    }
+
+    size_t GetCapacity() const {
+        return m_capacity;
+    }
+
+    size_t GetUsed() const {
+        return m_used.load(std::memory_order_relaxed);
+    }
+
+    bool IsView() const {
+        return m_owner != nullptr;
+    }
+
+    static constexpr size_t RoundUp(size_t bytes) {
+        return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+    }
+
+private:
+    size_t m_capacity;
+    uint8_t* m_data;
+    std::shared_ptr<const void> m_owner{};
+    std::atomic<size_t> m_used{0};
+};
+
+/**
+ * @brief Allocator that takes storage from a shared ContiguousArena when it has one and otherwise
+ * from the VectorPool, which recycles AllocateAligned() buffers, so that every vector is at least
+ * 64-byte aligned. Copies of a container get a heap allocator, while moves and swaps carry the
+ * arena along with the storage. Storage taken from a view is not initialized on default
+ * construction, so the container exposes the values of the viewed memory.
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type                             = T;
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+    using is_always_equal                        = std::false_type;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(std::shared_ptr<ContiguousArena> arena) noexcept : m_arena{std::move(arena)} {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena{other.GetArena()} {}
+
+    T* allocate(size_t n) {
+        if (m_arena) {
+            if (void* p = m_arena->Allocate(n * sizeof(T)))
+                return static_cast<T*>(p);
+            // a view has nothing to fall back to: the values would silently be lost
+            if (m_arena->IsView())
+                throw std::bad_alloc();
+        }
+        return static_cast<T*>(VectorPool::Allocate(n * sizeof(T)));
+    }
+
+    template <typename U>
+    void construct(U* p) {
+        if (!m_arena || !m_arena->IsView() || !m_arena->Owns(p))
+            ::new (static_cast<void*>(p)) U();
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* p, Args&&... args) {
+        ::new (static_cast<void*>(p)) U(std::forward<Args>(args)...);
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        if (!m_arena || !m_arena->Owns(p))
+            VectorPool::Deallocate(p, n * sizeof(T));
+    }
+
+    ArenaAllocator select_on_container_copy_construction() const noexcept {
+        return ArenaAllocator();
+    }
+
+    const std::shared_ptr<ContiguousArena>& GetArena() const noexcept {
+        return m_arena;
+    }
+
+private:
+    std::shared_ptr<ContiguousArena> m_arena{};
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.GetArena() == b.GetArena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return !(a == b);
+}
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_UTILS_ARENAALLOCATOR_H
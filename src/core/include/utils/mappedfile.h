@@ -0,0 +1,150 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Binary files of a cereal description followed by raw polynomial values that are memory-mapped
+  copy-on-write and used in place
+ */
+
+#ifndef LBCRYPTO_UTILS_MAPPEDFILE_H
+#define LBCRYPTO_UTILS_MAPPEDFILE_H
+
+#include "utils/arenaallocator.h"
+#include "utils/exception.h"
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+
+namespace lbcrypto {
+
+/**
+ * @brief Header of a mapped file. It is followed by the description, and the values start at
+ * dataOffset, on a page boundary, so that every tower is ContiguousArena::ALIGNMENT aligned in the
+ * mapping. Values are stored in the native byte order and integer width.
+ */
+struct MappedFileHeader {
+    static constexpr uint32_t ORDER_MARK{0x01020304};
+    static constexpr uint64_t DATA_ALIGNMENT{4096};
+
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t integerSize;
+    uint64_t descriptionSize;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+};
+
+/**
+ * @brief Writes the header and the description, padded up to the start of the values.
+ * @param os the output stream
+ * @param magic the file type
+ * @param version the format version of the file type
+ * @param integerSize the size of one stored value
+ * @param description the serialized description
+ * @param dataSize the total size of the values that follow
+ */
+void WriteMappedFileHeader(std::ostream& os, const char (&magic)[8], uint32_t version, uint64_t integerSize,
+                           const std::string& description, uint64_t dataSize);
+
+/**
+ * @brief Checks the header of a mapped file and returns it.
+ * @param filename the name of the file in error messages
+ * @param mapping the mapped file
+ * @param size the size of the mapping
+ * @param magic the expected file type
+ * @param version the latest format version understood
+ * @param integerSize the size of one value in this build
+ * @param what the name of the file type in error messages
+ */
+MappedFileHeader ReadMappedFileHeader(const std::string& filename, const uint8_t* mapping, uint64_t size,
+                                      const char (&magic)[8], uint32_t version, uint64_t integerSize,
+                                      const std::string& what);
+
+/**
+ * @brief Maps the whole file copy-on-write: pages that are written are copied privately and the file is
+ * never modified. The mapping is released with the last reference to it.
+ * Without mmap support the file is read into one aligned buffer instead.
+ * @param filename the file to map
+ * @param size receives the size of the file
+ */
+std::shared_ptr<const uint8_t> MapFile(const std::string& filename, uint64_t& size);
+
+/**
+ * @brief The number of bytes the values of a DCRT polynomial take in a mapped file: every tower is
+ * padded to ContiguousArena::ALIGNMENT, as DCRTPoly::MakeContiguous() lays them out in memory.
+ */
+template <typename DCRTPolyType>
+uint64_t MappedSize(const DCRTPolyType& poly) {
+    uint64_t bytes{0};
+    for (const auto& p : poly.GetParams()->GetParams())
+        bytes += ContiguousArena::RoundUp(p->GetRingDimension() * sizeof(typename DCRTPolyType::PolyType::Integer));
+    return bytes;
+}
+
+/**
+ * @brief Writes the values of a DCRT polynomial in the layout described by MappedSize().
+ */
+template <typename DCRTPolyType>
+void WriteMapped(std::ostream& os, const DCRTPolyType& poly) {
+    static constexpr char padding[ContiguousArena::ALIGNMENT]{};
+    for (const auto& tower : poly.GetAllElements()) {
+        const auto& values = tower.GetValues();
+        uint64_t bytes     = values.GetLength() * sizeof(values[0]);
+        os.write(reinterpret_cast<const char*>(&values[0]), bytes);
+        os.write(padding, ContiguousArena::RoundUp(bytes) - bytes);
+    }
+}
+
+/**
+ * @brief Makes a DCRT polynomial that is a view of its values in a mapped file.
+ * @param shape a polynomial with the parameters and format of the stored one, and no values
+ * @param data the start of the values in the mapping
+ * @param mapping keeps the mapping alive for as long as the polynomial exists
+ * @param dataSize the size of the values in the mapping
+ * @param offset the offset of the polynomial from data; advanced past it
+ */
+template <typename DCRTPolyType>
+DCRTPolyType AttachMapped(const DCRTPolyType& shape, const uint8_t* data, const std::shared_ptr<const uint8_t>& mapping,
+                          uint64_t dataSize, uint64_t& offset) {
+    uint64_t bytes = MappedSize(shape);
+    if (bytes > dataSize - offset)
+        OPENFHE_THROW("the mapped values do not match their description");
+    auto arena = std::make_shared<ContiguousArena>(data + offset, bytes, mapping);
+    offset += bytes;
+    return DCRTPolyType(shape.GetParams(), shape.GetFormat(), arena);
+}
+
+}  // namespace lbcrypto
+
+#endif
@@ -40,8 +40,19 @@
     #include <omp.h>
 #endif
 
+#include <cstddef>
+#include <cstdint>
+
 namespace lbcrypto {
 
+// @Brief classes of kernels that have their own parallelism policy
+enum class ParallelKernel : uint32_t {
+    NTT = 0,           // batched forward/inverse NTTs over DCRTPoly towers
+    BASIS_CONVERSION,  // CRT basis switching/expansion and interpolation
+    SCALE_AND_ROUND,   // BFV/BGV scale-and-round and approximate scale-and-round
+    COUNT
+};
+
 class ParallelControls {
 public:
     // @Brief CTOR, enables parallel operations as default
@@ -125,8 +136,75 @@ public:
 #endif
     }
 
+    // @Brief sets the thread budget of a kernel class; 0 means all machine threads
+    void SetKernelThreads(ParallelKernel kernel, uint32_t nthreads) {
+        kernelThreads[static_cast<uint32_t>(kernel)] = nthreads;
+    }
+
+    uint32_t GetKernelThreads(ParallelKernel kernel) const {
+        return kernelThreads[static_cast<uint32_t>(kernel)];
+    }
+
+    // @Brief sets the grain of a kernel class: the minimum number of work items
+    // (coefficients) handed to a single thread. 0 is treated as 1
+    void SetKernelGrain(ParallelKernel kernel, uint32_t grain) {
+        kernelGrain[static_cast<uint32_t>(kernel)] = grain > 0 ? grain : 1;
+    }
+
+    uint32_t GetKernelGrain(ParallelKernel kernel) const {
+        return kernelGrain[static_cast<uint32_t>(kernel)];
+    }
+
+    // @Brief returns the number of threads a kernel of the given class should use
+    // for a parallel loop over "items" work items: the kernel budget, limited by the
+    // machine threads and by the number of grains in the loop (at least 1)
+    int GetKernelThreadLimit(ParallelKernel kernel, size_t items) const {
+#ifdef PARALLEL
+        size_t limit  = static_cast<size_t>(machineThreads);
+        uint32_t budget = kernelThreads[static_cast<uint32_t>(kernel)];
+        if (budget > 0 && budget < limit)
+            limit = budget;
+        size_t grains = items / kernelGrain[static_cast<uint32_t>(kernel)];
+        if (grains < limit)
+            limit = grains;
+        return limit > 0 ? static_cast<int>(limit) : 1;
+#else
+        return 1;
+#endif
+    }
+
+    // @Brief enables/disables autotuning of the kernel grains; when enabled,
+    // Autotune() is run on the first crypto context creation
+    void SetAutotune(bool enable) {
+        autotune = enable;
+    }
+
+    bool IsAutotuneEnabled() const {
+        return autotune;
+    }
+
+    // @Brief measures the OpenMP fork/join overhead and the per-item cost of each
+    // kernel class on this machine and sets the grains so that a thread's share of
+    // work dominates the overhead. Runs once unless force is set; returns true if
+    // the measurement was performed
+    bool Autotune(bool force = false);
+
+    // @Brief restores the default budgets and grains
+    void ResetKernelPolicy();
+
 private:
+    static constexpr uint32_t KERNEL_COUNT = static_cast<uint32_t>(ParallelKernel::COUNT);
+
+    // default grains: the NTT grain matches the minimum block size of the batched
+    // NTT; per-coefficient basis conversion and scale-and-round loops are heavier
+    static constexpr uint32_t DEFAULT_KERNEL_GRAIN[KERNEL_COUNT]{1 << 11, 1 << 8, 1 << 8};
+
     int machineThreads{1};
+    // 0 = no budget beyond the machine threads
+    uint32_t kernelThreads[KERNEL_COUNT]{0, 0, 0};
+    uint32_t kernelGrain[KERNEL_COUNT]{DEFAULT_KERNEL_GRAIN[0], DEFAULT_KERNEL_GRAIN[1], DEFAULT_KERNEL_GRAIN[2]};
+    bool autotune{false};
+    bool autotuned{false};
 };
 
 extern ParallelControls OpenFHEParallelControls;
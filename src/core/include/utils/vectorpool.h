@@ -0,0 +1,131 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Thread-local pool of recycled native vector buffers
+ */
+
+#ifndef LBCRYPTO_UTILS_VECTORPOOL_H
+#define LBCRYPTO_UTILS_VECTORPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace lbcrypto {
+
+struct VectorPoolStats {
+    // allocations served from the pool
+    uint64_t hits{0};
+    // allocations made while pooling was active that had to go to the heap
+    uint64_t misses{0};
+    // bytes currently cached by the pool(s)
+    size_t cachedBytes{0};
+};
+
+/**
+ * @brief Thread-local cache of the heap buffers backing NativeVectorT, keyed by their size in bytes,
+ * i.e. by ring dimension. It removes the malloc/free churn (and the page faults of large mmap'ed
+ * buffers) of the temporaries in hot paths such as key switching, rescaling and tensoring.
+ *
+ * Pooling is active on a thread only while a VectorPoolScope exists on it: buffers freed inside a
+ * scope are kept (up to the per-thread capacity) and allocations inside a scope reuse them. Outside
+ * of any scope allocation goes straight to the heap. A thread that leaves its outermost scope inside
+ * an OpenMP parallel region releases its cache, so OpenMP workers retain nothing between regions;
+ * only the threads that enter scopes outside of parallel regions keep their buffers, until they
+ * exit or call Release().
+ *
+ * The cached bytes are bounded per thread (SetCapacity()) and for the whole process
+ * (SetGlobalCapacity()), so a service that runs requests on many threads of its own caches at most
+ * the global capacity, whatever the number of threads. Such a service should size both limits for
+ * its ring dimension and call Release() on threads that go idle.
+ */
+class VectorPool {
+public:
+    // buffers below this size are left to malloc
+    static constexpr size_t MIN_POOLED_BYTES{size_t(1) << 12};
+    // default limits of the bytes cached by one thread and by all threads together
+    static constexpr size_t DEFAULT_CAPACITY{size_t(1) << 24};
+    static constexpr size_t DEFAULT_GLOBAL_CAPACITY{size_t(1) << 26};
+
+    // called by the vector allocator; fall back to the heap when pooling is not active
+    static void* Allocate(size_t bytes);
+    static void Deallocate(void* p, size_t bytes) noexcept;
+
+    /**
+     * @brief Sets the maximum number of bytes each thread may cache; 0 disables pooling.
+     * Caches that are already larger shrink as their buffers are reused.
+     */
+    static void SetCapacity(size_t bytes);
+    static size_t GetCapacity();
+
+    /**
+     * @brief Sets the maximum number of bytes all threads together may cache. Buffers freed while
+     * the limit is reached go back to the heap.
+     */
+    static void SetGlobalCapacity(size_t bytes);
+    static size_t GetGlobalCapacity();
+
+    // counters of the calling thread / summed over all threads (including finished ones)
+    static VectorPoolStats GetThreadStats();
+    static VectorPoolStats GetStats();
+    static void ResetStats();
+
+    /**
+     * @brief Returns the buffers cached by the calling thread to the heap. Threads that are not
+     * OpenMP workers keep their cache until they exit, so long-lived request threads of a service
+     * should call it when they go idle.
+     */
+    static void Release();
+
+private:
+    friend class VectorPoolScope;
+    static void Enter();
+    static void Leave();
+};
+
+/**
+ * @brief Activates the VectorPool on the current thread for its lifetime; scopes may be nested.
+ */
+class VectorPoolScope {
+public:
+    VectorPoolScope() {
+        VectorPool::Enter();
+    }
+    ~VectorPoolScope() {
+        VectorPool::Leave();
+    }
+    VectorPoolScope(const VectorPoolScope&)            = delete;
+    VectorPoolScope& operator=(const VectorPoolScope&) = delete;
+};
+
+}  // namespace lbcrypto
+
+#endif  // LBCRYPTO_UTILS_VECTORPOOL_H
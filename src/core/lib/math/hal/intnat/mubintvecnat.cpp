@@ -352,6 +352,44 @@ NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulEq(const NativeVec
     return *this;
 }
 
+template <class IntegerType>
+NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ToMontgomeryEq() {
+    auto mv{m_modulus};
+    if (mv.GetMSB() > IntegerType::MaxBits() - 1)
+        OPENFHE_THROW("ToMontgomeryEq: the modulus is too large for Montgomery form");
+    auto negInv{mv.ComputeMontgomeryNegInv()};
+    auto r2{mv.ComputeMontgomeryR2()};
+    for (size_t i = 0; i < m_data.size(); ++i)
+        m_data[i].ModMulMontgomeryEq(r2, mv, negInv);
+    return *this;
+}
+
+template <class IntegerType>
+NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::FromMontgomeryEq() {
+    auto mv{m_modulus};
+    auto negInv{mv.ComputeMontgomeryNegInv()};
+    IntegerType one{1};
+    for (size_t i = 0; i < m_data.size(); ++i)
+        m_data[i].ModMulMontgomeryEq(one, mv, negInv);
+    return *this;
+}
+
+template <class IntegerType>
+NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulMontgomeryEq(const NativeVectorT& b) {
+    return ModMulMontgomeryEq(b, m_modulus.ComputeMontgomeryNegInv());
+}
+
+template <class IntegerType>
+NativeVectorT<IntegerType>& NativeVectorT<IntegerType>::ModMulMontgomeryEq(const NativeVectorT& b,
+                                                                           const IntegerType& modulusNegInv) {
+    if (m_data.size() != b.m_data.size() || m_modulus != b.m_modulus)
+        OPENFHE_THROW("ModMulMontgomeryEq called on NativeVectorT's with different parameters.");
+    auto mv{m_modulus};
+    for (size_t i = 0; i < m_data.size(); ++i)
+        m_data[i].ModMulMontgomeryEq(b[i], mv, modulusNegInv);
+    return *this;
+}
+
 template <class IntegerType>
 NativeVectorT<IntegerType> NativeVectorT<IntegerType>::ModByTwo() const {
     auto ans(*this);
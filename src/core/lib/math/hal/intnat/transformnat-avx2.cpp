@@ -0,0 +1,153 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  AVX2 kernels for the native NTT. This file is compiled with -mavx2 and the kernels
+  are only called after the CPU support has been checked at runtime
+ */
+
+#include "math/hal/intnat/transformnat-simd-kernels.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+namespace intnat {
+
+#if defined(__AVX2__)
+
+namespace {
+
+// All values handled here are below 4q < 2^63, so the sign bit of a difference
+// tells whether it wrapped around; blendv_pd selects on exactly that bit.
+struct AVX2Ops {
+    using Reg = __m256i;
+    static constexpr uint32_t Lanes{4};
+
+    static Reg Load(const uint64_t* p) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    static void Store(uint64_t* p, Reg x) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), x);
+    }
+
+    static Reg Set1(uint64_t x) {
+        return _mm256_set1_epi64x(static_cast<int64_t>(x));
+    }
+
+    static uint64_t Precon(uint64_t bPrecon) {
+        return bPrecon;
+    }
+
+    // returns (sign(mask) ? b : a) per lane
+    static Reg SelectNegative(Reg a, Reg b, Reg mask) {
+        return _mm256_castpd_si256(
+            _mm256_blendv_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b), _mm256_castsi256_pd(mask)));
+    }
+
+    static Reg Add(Reg a, Reg b) {
+        return _mm256_add_epi64(a, b);
+    }
+
+    static Reg Sub(Reg a, Reg b) {
+        return _mm256_sub_epi64(a, b);
+    }
+
+    // maps [0, 2 * bound) to [0, bound)
+    static Reg Reduce(Reg x, Reg bound) {
+        auto r{_mm256_sub_epi64(x, bound)};
+        return SelectNegative(r, x, r);
+    }
+
+    // high 64 bits of the 128-bit products, assembled from 32x32-bit partial products
+    static Reg MulHi(Reg a, Reg b) {
+        const auto mask{_mm256_set1_epi64x(0xFFFFFFFF)};
+        auto aHi{_mm256_srli_epi64(a, 32)};
+        auto bHi{_mm256_srli_epi64(b, 32)};
+        auto p00{_mm256_mul_epu32(a, b)};
+        auto p01{_mm256_mul_epu32(a, bHi)};
+        auto p10{_mm256_mul_epu32(aHi, b)};
+        auto p11{_mm256_mul_epu32(aHi, bHi)};
+        auto mid{_mm256_add_epi64(_mm256_srli_epi64(p00, 32), _mm256_and_si256(p01, mask))};
+        mid = _mm256_add_epi64(mid, _mm256_and_si256(p10, mask));
+        auto hi{_mm256_add_epi64(p11, _mm256_srli_epi64(p01, 32))};
+        hi = _mm256_add_epi64(hi, _mm256_srli_epi64(p10, 32));
+        return _mm256_add_epi64(hi, _mm256_srli_epi64(mid, 32));
+    }
+
+    // low 64 bits of the products
+    static Reg MulLo(Reg a, Reg b) {
+        auto cross{_mm256_add_epi64(_mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)),
+                                    _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b))};
+        return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+    }
+
+    // Shoup's modular multiplication a * b mod q in [0, 2q) with bPrecon = floor(b * 2^64 / q)
+    static Reg ModMulConstLazy(Reg a, Reg b, Reg bPrecon, Reg q) {
+        auto quot{MulHi(a, bPrecon)};
+        return _mm256_sub_epi64(MulLo(a, b), MulLo(quot, q));
+    }
+};
+
+}  // namespace
+
+bool ForwardTransformToBitReverseStagesAVX2(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                            const uint64_t* wp, uint32_t mBegin, uint32_t mEnd, uint32_t block,
+                                            uint32_t nBlocks) {
+    NTTKernelSIMD<AVX2Ops>::ForwardTransformToBitReverseStages(element, n, modulus, w, wp, mBegin, mEnd, block,
+                                                               nBlocks);
+    return true;
+}
+
+bool InverseTransformFromBitReverseStagesAVX2(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                              const uint64_t* wp, uint64_t nInv, uint64_t nInvPrecon, uint32_t mBegin,
+                                              uint32_t mEnd, uint32_t block, uint32_t nBlocks) {
+    NTTKernelSIMD<AVX2Ops>::InverseTransformFromBitReverseStages(element, n, modulus, w, wp, nInv, nInvPrecon, mBegin,
+                                                                 mEnd, block, nBlocks);
+    return true;
+}
+
+#else
+
+bool ForwardTransformToBitReverseStagesAVX2(uint64_t*, uint32_t, uint64_t, const uint64_t*, const uint64_t*, uint32_t,
+                                            uint32_t, uint32_t, uint32_t) {
+    return false;
+}
+
+bool InverseTransformFromBitReverseStagesAVX2(uint64_t*, uint32_t, uint64_t, const uint64_t*, const uint64_t*, uint64_t,
+                                              uint64_t, uint32_t, uint32_t, uint32_t, uint32_t) {
+    return false;
+}
+
+#endif
+
+}  // namespace intnat
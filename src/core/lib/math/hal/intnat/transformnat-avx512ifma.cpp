@@ -0,0 +1,132 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  AVX-512 IFMA kernels for the native NTT with moduli below 2^50. This file is compiled with
+  -mavx512f -mavx512dq -mavx512ifma and the kernels are only called after the CPU support
+  has been checked at runtime
+ */
+
+#include "math/hal/intnat/transformnat-simd-kernels.h"
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__AVX512IFMA__)
+    // GCC 12 reports false positives (-Wmaybe-uninitialized) inside the AVX-512 intrinsics
+    #if defined(__GNUC__) && !defined(__clang__)
+        #pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    #endif
+    #include <immintrin.h>
+#endif
+
+namespace intnat {
+
+#if defined(__AVX512F__) && defined(__AVX512DQ__) && defined(__AVX512IFMA__)
+
+namespace {
+
+// Shoup's multiplication on 52-bit lanes: with a < 2^52 and bPrecon = floor(b * 2^52 / q),
+// a * b - floor(a * bPrecon / 2^52) * q lies in [0, 2q). The lazy butterflies feed inputs
+// up to 4q, so this backend requires q < 2^50.
+struct AVX512IFMAOps {
+    using Reg = __m512i;
+    static constexpr uint32_t Lanes{8};
+
+    static Reg Load(const uint64_t* p) {
+        return _mm512_loadu_si512(p);
+    }
+
+    static void Store(uint64_t* p, Reg x) {
+        _mm512_storeu_si512(p, x);
+    }
+
+    static Reg Set1(uint64_t x) {
+        return _mm512_set1_epi64(static_cast<int64_t>(x));
+    }
+
+    // floor(b * 2^52 / q) == floor(floor(b * 2^64 / q) / 2^12)
+    static uint64_t Precon(uint64_t bPrecon) {
+        return bPrecon >> 12;
+    }
+
+    static Reg Add(Reg a, Reg b) {
+        return _mm512_add_epi64(a, b);
+    }
+
+    static Reg Sub(Reg a, Reg b) {
+        return _mm512_sub_epi64(a, b);
+    }
+
+    // maps [0, 2 * bound) to [0, bound): x - bound wraps around to a larger value whenever x < bound
+    static Reg Reduce(Reg x, Reg bound) {
+        return _mm512_min_epu64(x, _mm512_sub_epi64(x, bound));
+    }
+
+    static Reg ModMulConstLazy(Reg a, Reg b, Reg bPrecon, Reg q) {
+        const auto zero{_mm512_setzero_si512()};
+        const auto mask{_mm512_set1_epi64((uint64_t(1) << 52) - 1)};
+        auto quot{_mm512_madd52hi_epu64(zero, a, bPrecon)};
+        auto r{_mm512_sub_epi64(_mm512_madd52lo_epu64(zero, a, b), _mm512_madd52lo_epu64(zero, quot, q))};
+        return _mm512_and_si512(r, mask);
+    }
+};
+
+}  // namespace
+
+bool ForwardTransformToBitReverseStagesAVX512IFMA(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                                  const uint64_t* wp, uint32_t mBegin, uint32_t mEnd, uint32_t block,
+                                                  uint32_t nBlocks) {
+    NTTKernelSIMD<AVX512IFMAOps>::ForwardTransformToBitReverseStages(element, n, modulus, w, wp, mBegin, mEnd, block,
+                                                                     nBlocks);
+    return true;
+}
+
+bool InverseTransformFromBitReverseStagesAVX512IFMA(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                                    const uint64_t* wp, uint64_t nInv, uint64_t nInvPrecon,
+                                                    uint32_t mBegin, uint32_t mEnd, uint32_t block, uint32_t nBlocks) {
+    NTTKernelSIMD<AVX512IFMAOps>::InverseTransformFromBitReverseStages(element, n, modulus, w, wp, nInv, nInvPrecon,
+                                                                       mBegin, mEnd, block, nBlocks);
+    return true;
+}
+
+#else
+
+bool ForwardTransformToBitReverseStagesAVX512IFMA(uint64_t*, uint32_t, uint64_t, const uint64_t*, const uint64_t*,
+                                                  uint32_t, uint32_t, uint32_t, uint32_t) {
+    return false;
+}
+
+bool InverseTransformFromBitReverseStagesAVX512IFMA(uint64_t*, uint32_t, uint64_t, const uint64_t*, const uint64_t*,
+                                                    uint64_t, uint64_t, uint32_t, uint32_t, uint32_t, uint32_t) {
+    return false;
+}
+
+#endif
+
+}  // namespace intnat
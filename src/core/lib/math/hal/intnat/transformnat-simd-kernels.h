@@ -0,0 +1,238 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/*
+  Butterfly loops shared by the instruction-set-specific native NTT kernels.
+  This header is included only by transformnat-avx2.cpp, transformnat-avx512.cpp,
+  transformnat-avx512ifma.cpp and transformnat-simd.cpp
+ */
+
+#ifndef LBCRYPTO_LIB_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_KERNELS_H
+#define LBCRYPTO_LIB_MATH_HAL_INTNAT_TRANSFORMNAT_SIMD_KERNELS_H
+
+#include <cstdint>
+
+namespace intnat {
+
+// Entry points of the per-ISA translation units; see ForwardTransformToBitReverseStagesSIMD()
+// for the meaning of the arguments. Each of them returns false if its translation unit was
+// built without the corresponding instruction set.
+bool ForwardTransformToBitReverseStagesAVX2(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                            const uint64_t* wp, uint32_t mBegin, uint32_t mEnd, uint32_t block,
+                                            uint32_t nBlocks);
+bool InverseTransformFromBitReverseStagesAVX2(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                              const uint64_t* wp, uint64_t nInv, uint64_t nInvPrecon, uint32_t mBegin,
+                                              uint32_t mEnd, uint32_t block, uint32_t nBlocks);
+bool ForwardTransformToBitReverseStagesAVX512(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                              const uint64_t* wp, uint32_t mBegin, uint32_t mEnd, uint32_t block,
+                                              uint32_t nBlocks);
+bool InverseTransformFromBitReverseStagesAVX512(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                                const uint64_t* wp, uint64_t nInv, uint64_t nInvPrecon,
+                                                uint32_t mBegin, uint32_t mEnd, uint32_t block, uint32_t nBlocks);
+bool ForwardTransformToBitReverseStagesAVX512IFMA(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                                  const uint64_t* wp, uint32_t mBegin, uint32_t mEnd, uint32_t block,
+                                                  uint32_t nBlocks);
+bool InverseTransformFromBitReverseStagesAVX512IFMA(uint64_t* element, uint32_t n, uint64_t modulus,
+                                                    const uint64_t* w, const uint64_t* wp, uint64_t nInv,
+                                                    uint64_t nInvPrecon, uint32_t mBegin, uint32_t mEnd,
+                                                    uint32_t block, uint32_t nBlocks);
+
+#if defined(__x86_64__)
+
+/**
+ * @brief Radix-2 NTT loops parameterized by a vector backend V, which provides
+ * Lanes, Reg, Load, Store, Set1, Precon, Add, Sub, Reduce and ModMulConstLazy.
+ *
+ * The butterflies use Harvey's lazy reduction: the forward transform keeps values in
+ * [0, 4q) and the inverse transform in [0, 2q); both reduce to [0, q) in the last stage,
+ * so the output matches NumberTheoreticTransformNat bit for bit. The backend must hold
+ * 4q without overflow. Butterfly spans of at least V::Lanes words are vectorized; the
+ * remaining (short) stages run the same butterflies on scalars.
+ *
+ * A call runs the stages m in [mBegin, mEnd) (m is the number of butterfly groups of the
+ * stage) restricted to the part owned by block out of nBlocks; see
+ * ForwardTransformToBitReverseStagesSIMD().
+ *
+ * Every member is a static function of a class template instantiated with a type
+ * local to one translation unit, so code compiled for different instruction sets
+ * is never merged by the linker.
+ */
+template <typename V>
+struct NTTKernelSIMD {
+    static void ForwardTransformToBitReverseStages(uint64_t* element, uint32_t n, uint64_t modulus,
+                                                   const uint64_t* w, const uint64_t* wp, uint32_t mBegin,
+                                                   uint32_t mEnd, uint32_t block, uint32_t nBlocks) {
+        for (uint32_t m{mBegin}; m < mEnd; m <<= 1) {
+            uint32_t t{n / (m << 1)}, iBegin, iEnd, jBegin, span;
+            Partition(n, m, block, nBlocks, iBegin, iEnd, jBegin, span);
+            for (uint32_t i{iBegin}; i < iEnd; ++i) {
+                uint64_t* x{element + ((i * t) << 1) + jBegin};
+                ForwardButterflies(x, x + t, span, modulus, w[m + i], wp[m + i], m == (n >> 1));
+            }
+        }
+    }
+
+    // the multiplication by n^{-1} and the final reduction are merged into the last stage (m == 1)
+    static void InverseTransformFromBitReverseStages(uint64_t* element, uint32_t n, uint64_t modulus,
+                                                     const uint64_t* w, const uint64_t* wp, uint64_t nInv,
+                                                     uint64_t nInvPrecon, uint32_t mBegin, uint32_t mEnd,
+                                                     uint32_t block, uint32_t nBlocks) {
+        for (uint32_t m{mEnd >> 1}; m >= mBegin && m > 0; m >>= 1) {
+            uint32_t t{n / (m << 1)}, iBegin, iEnd, jBegin, span;
+            Partition(n, m, block, nBlocks, iBegin, iEnd, jBegin, span);
+            for (uint32_t i{iBegin}; i < iEnd; ++i) {
+                uint64_t* x{element + ((i * t) << 1) + jBegin};
+                uint64_t omega{w[m + i]};
+                uint64_t preconOmega{wp[m + i]};
+                if (m == 1) {
+                    omega       = Reduce(ModMulConstLazy(omega, nInv, nInvPrecon, modulus), modulus);
+                    preconOmega = Precon(omega, modulus);
+                }
+                InverseButterflies(x, x + t, span, modulus, omega, preconOmega, nInv, nInvPrecon, m == 1);
+            }
+        }
+    }
+
+private:
+    // Butterflies of stage m owned by block: for m >= nBlocks the block owns whole groups
+    // [iBegin, iEnd); otherwise it owns the span [jBegin, jBegin + span) of a single group.
+    static void Partition(uint32_t n, uint32_t m, uint32_t block, uint32_t nBlocks, uint32_t& iBegin, uint32_t& iEnd,
+                          uint32_t& jBegin, uint32_t& span) {
+        uint32_t t{n / (m << 1)};
+        if (m >= nBlocks) {
+            iBegin = block * (m / nBlocks);
+            iEnd   = iBegin + m / nBlocks;
+            jBegin = 0;
+            span   = t;
+        }
+        else {
+            span   = t / (nBlocks / m);
+            iBegin = block / (nBlocks / m);
+            iEnd   = iBegin + 1;
+            jBegin = (block % (nBlocks / m)) * span;
+        }
+    }
+
+    static void ForwardButterflies(uint64_t* x, uint64_t* y, uint32_t span, uint64_t modulus, uint64_t omega,
+                                   uint64_t preconOmega, bool last) {
+        const uint64_t twoModulus{modulus << 1};
+        if (span >= V::Lanes) {
+            const auto q{V::Set1(modulus)};
+            const auto q2{V::Set1(twoModulus)};
+            const auto vOmega{V::Set1(omega)};
+            const auto vPreconOmega{V::Set1(V::Precon(preconOmega))};
+            for (uint32_t j{0}; j < span; j += V::Lanes) {
+                auto loVal{V::Reduce(V::Load(x + j), q2)};
+                auto omegaFactor{V::ModMulConstLazy(V::Load(y + j), vOmega, vPreconOmega, q)};
+                V::Store(x + j, V::Add(loVal, omegaFactor));
+                V::Store(y + j, V::Sub(V::Add(loVal, q2), omegaFactor));
+            }
+            return;
+        }
+        for (uint32_t j{0}; j < span; ++j) {
+            uint64_t loVal{Reduce(x[j], twoModulus)};
+            uint64_t omegaFactor{ModMulConstLazy(y[j], omega, preconOmega, modulus)};
+            uint64_t hiVal{loVal + omegaFactor};
+            loVal += twoModulus - omegaFactor;
+            if (last) {
+                // back to [0, q)
+                hiVal = Reduce(Reduce(hiVal, twoModulus), modulus);
+                loVal = Reduce(Reduce(loVal, twoModulus), modulus);
+            }
+            x[j] = hiVal;
+            y[j] = loVal;
+        }
+    }
+
+    static void InverseButterflies(uint64_t* x, uint64_t* y, uint32_t span, uint64_t modulus, uint64_t omega,
+                                   uint64_t preconOmega, uint64_t nInv, uint64_t nInvPrecon, bool last) {
+        const uint64_t twoModulus{modulus << 1};
+        if (span >= V::Lanes) {
+            const auto q{V::Set1(modulus)};
+            const auto q2{V::Set1(twoModulus)};
+            const auto vOmega{V::Set1(omega)};
+            const auto vPreconOmega{V::Set1(V::Precon(preconOmega))};
+            const auto vInv{V::Set1(nInv)};
+            const auto vPreconInv{V::Set1(V::Precon(nInvPrecon))};
+            for (uint32_t j{0}; j < span; j += V::Lanes) {
+                auto loVal{V::Load(x + j)};
+                auto hiVal{V::Load(y + j)};
+                auto sum{V::Add(loVal, hiVal)};
+                auto diff{V::ModMulConstLazy(V::Sub(V::Add(loVal, q2), hiVal), vOmega, vPreconOmega, q)};
+                if (last) {
+                    sum  = V::Reduce(V::ModMulConstLazy(sum, vInv, vPreconInv, q), q);
+                    diff = V::Reduce(diff, q);
+                }
+                else {
+                    sum = V::Reduce(sum, q2);
+                }
+                V::Store(x + j, sum);
+                V::Store(y + j, diff);
+            }
+            return;
+        }
+        for (uint32_t j{0}; j < span; ++j) {
+            uint64_t loVal{x[j]};
+            uint64_t hiVal{y[j]};
+            uint64_t sum{loVal + hiVal};
+            uint64_t diff{ModMulConstLazy(loVal + twoModulus - hiVal, omega, preconOmega, modulus)};
+            if (last) {
+                sum  = Reduce(ModMulConstLazy(sum, nInv, nInvPrecon, modulus), modulus);
+                diff = Reduce(diff, modulus);
+            }
+            else {
+                sum = Reduce(sum, twoModulus);
+            }
+            x[j] = sum;
+            y[j] = diff;
+        }
+    }
+
+    static uint64_t Reduce(uint64_t a, uint64_t bound) {
+        return a >= bound ? a - bound : a;
+    }
+
+    // Shoup's modular multiplication by a constant with a 64-bit precomputation;
+    // the result lies in [0, 2q) for any 64-bit a
+    static uint64_t ModMulConstLazy(uint64_t a, uint64_t b, uint64_t bPrecon, uint64_t modulus) {
+        auto q{static_cast<uint64_t>((static_cast<unsigned __int128>(a) * bPrecon) >> 64)};
+        return a * b - q * modulus;
+    }
+
+    static uint64_t Precon(uint64_t b, uint64_t modulus) {
+        return static_cast<uint64_t>((static_cast<unsigned __int128>(b) << 64) / modulus);
+    }
+};
+
+#endif
+
+}  // namespace intnat
+
+#endif
@@ -0,0 +1,152 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  CPU detection and runtime dispatch for the vectorized native NTT kernels
+ */
+
+#include "math/hal/intnat/transformnat-simd.h"
+#include "math/hal/intnat/transformnat-simd-kernels.h"
+
+#include <atomic>
+
+namespace intnat {
+
+namespace {
+
+// the lazy butterflies keep values below 4q, which has to fit into the 52-bit multipliers (IFMA),
+// the unsigned 64-bit lanes (AVX-512) and the signed 64-bit lanes (AVX2), respectively
+constexpr uint64_t MAX_MODULUS_IFMA{uint64_t(1) << 50};
+constexpr uint64_t MAX_MODULUS_AVX512{uint64_t(1) << 62};
+constexpr uint64_t MAX_MODULUS_AVX2{uint64_t(1) << 61};
+
+NTTSimdBackend DetectNTTSimdBackend() {
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__EMSCRIPTEN__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")) {
+        if (__builtin_cpu_supports("avx512ifma"))
+            return NTT_SIMD_AVX512IFMA;
+        return NTT_SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+        return NTT_SIMD_AVX2;
+#endif
+    return NTT_SIMD_SCALAR;
+}
+
+const NTTSimdBackend supportedBackend{DetectNTTSimdBackend()};
+std::atomic<NTTSimdBackend> activeBackend{supportedBackend};
+
+}  // namespace
+
+NTTSimdBackend GetNTTSimdBackendSupported() {
+    return supportedBackend;
+}
+
+NTTSimdBackend GetNTTSimdBackend() {
+    return activeBackend.load(std::memory_order_relaxed);
+}
+
+NTTSimdBackend SetNTTSimdBackend(NTTSimdBackend backend) {
+    if (backend > supportedBackend)
+        backend = supportedBackend;
+    activeBackend.store(backend, std::memory_order_relaxed);
+    return backend;
+}
+
+bool ForwardTransformToBitReverseInPlaceSIMD(uint64_t* element, uint32_t n, uint64_t modulus,
+                                             const uint64_t* rootOfUnityTable, const uint64_t* preconRootOfUnityTable) {
+    return ForwardTransformToBitReverseStagesSIMD(element, n, modulus, rootOfUnityTable, preconRootOfUnityTable, 1, n,
+                                                  0, 1);
+}
+
+bool InverseTransformFromBitReverseInPlaceSIMD(uint64_t* element, uint32_t n, uint64_t modulus,
+                                               const uint64_t* rootOfUnityInverseTable,
+                                               const uint64_t* preconRootOfUnityInverseTable, uint64_t cycloOrderInv,
+                                               uint64_t preconCycloOrderInv) {
+    return InverseTransformFromBitReverseStagesSIMD(element, n, modulus, rootOfUnityInverseTable,
+                                                    preconRootOfUnityInverseTable, cycloOrderInv, preconCycloOrderInv,
+                                                    1, n, 0, 1);
+}
+
+bool ForwardTransformToBitReverseStagesSIMD(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                            const uint64_t* wp, uint32_t mBegin, uint32_t mEnd, uint32_t block,
+                                            uint32_t nBlocks) {
+    if (n < 2)
+        return false;
+    switch (GetNTTSimdBackend()) {
+        case NTT_SIMD_AVX512IFMA:
+            if (modulus < MAX_MODULUS_IFMA)
+                return ForwardTransformToBitReverseStagesAVX512IFMA(element, n, modulus, w, wp, mBegin, mEnd, block,
+                                                                    nBlocks);
+            [[fallthrough]];
+        case NTT_SIMD_AVX512:
+            if (modulus < MAX_MODULUS_AVX512)
+                return ForwardTransformToBitReverseStagesAVX512(element, n, modulus, w, wp, mBegin, mEnd, block,
+                                                                nBlocks);
+            return false;
+        case NTT_SIMD_AVX2:
+            if (modulus < MAX_MODULUS_AVX2)
+                return ForwardTransformToBitReverseStagesAVX2(element, n, modulus, w, wp, mBegin, mEnd, block, nBlocks);
+            return false;
+        default:
+            return false;
+    }
+}
+
+bool InverseTransformFromBitReverseStagesSIMD(uint64_t* element, uint32_t n, uint64_t modulus, const uint64_t* w,
+                                              const uint64_t* wp, uint64_t cycloOrderInv, uint64_t preconCycloOrderInv,
+                                              uint32_t mBegin, uint32_t mEnd, uint32_t block, uint32_t nBlocks) {
+    if (n < 2)
+        return false;
+    switch (GetNTTSimdBackend()) {
+        case NTT_SIMD_AVX512IFMA:
+            if (modulus < MAX_MODULUS_IFMA)
+                return InverseTransformFromBitReverseStagesAVX512IFMA(element, n, modulus, w, wp, cycloOrderInv,
+                                                                      preconCycloOrderInv, mBegin, mEnd, block,
+                                                                      nBlocks);
+            [[fallthrough]];
+        case NTT_SIMD_AVX512:
+            if (modulus < MAX_MODULUS_AVX512)
+                return InverseTransformFromBitReverseStagesAVX512(element, n, modulus, w, wp, cycloOrderInv,
+                                                                  preconCycloOrderInv, mBegin, mEnd, block, nBlocks);
+            return false;
+        case NTT_SIMD_AVX2:
+            if (modulus < MAX_MODULUS_AVX2)
+                return InverseTransformFromBitReverseStagesAVX2(element, n, modulus, w, wp, cycloOrderInv,
+                                                                preconCycloOrderInv, mBegin, mEnd, block, nBlocks);
+            return false;
+        default:
+            return false;
+    }
+}
+
+}  // namespace intnat
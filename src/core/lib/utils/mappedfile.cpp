@@ -0,0 +1,128 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Binary files of a cereal description followed by raw polynomial values that are memory-mapped
+  read-only and used in place
+ */
+
+#include "utils/mappedfile.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace lbcrypto {
+
+void WriteMappedFileHeader(std::ostream& os, const char (&magic)[8], uint32_t version, uint64_t integerSize,
+                           const std::string& description, uint64_t dataSize) {
+    MappedFileHeader header{};
+    std::memcpy(header.magic, magic, sizeof(header.magic));
+    header.version         = version;
+    header.byteOrder       = MappedFileHeader::ORDER_MARK;
+    header.integerSize     = integerSize;
+    header.descriptionSize = description.size();
+    header.dataOffset      = (sizeof(MappedFileHeader) + description.size() + MappedFileHeader::DATA_ALIGNMENT - 1) &
+                        ~(MappedFileHeader::DATA_ALIGNMENT - 1);
+    header.dataSize        = dataSize;
+
+    os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    os.write(description.data(), description.size());
+    const std::vector<char> padding(header.dataOffset - sizeof(header) - description.size(), 0);
+    os.write(padding.data(), padding.size());
+}
+
+MappedFileHeader ReadMappedFileHeader(const std::string& filename, const uint8_t* mapping, uint64_t size,
+                                      const char (&magic)[8], uint32_t version, uint64_t integerSize,
+                                      const std::string& what) {
+    MappedFileHeader header;
+    if (size < sizeof(header))
+        OPENFHE_THROW(filename + " is not a " + what);
+    std::memcpy(&header, mapping, sizeof(header));
+    if (std::memcmp(header.magic, magic, sizeof(header.magic)) != 0)
+        OPENFHE_THROW(filename + " is not a " + what);
+    if (header.version > version)
+        OPENFHE_THROW(what + " version " + std::to_string(header.version) + " is from a later version of the library");
+    if (header.byteOrder != MappedFileHeader::ORDER_MARK || header.integerSize != integerSize)
+        OPENFHE_THROW(filename + " was written on a platform with a different integer representation");
+    if (header.dataOffset < sizeof(header) || header.dataOffset > size ||
+        header.descriptionSize > header.dataOffset - sizeof(header) || header.dataSize > size - header.dataOffset ||
+        header.dataOffset % MappedFileHeader::DATA_ALIGNMENT != 0)
+        OPENFHE_THROW("the " + what + " " + filename + " is truncated");
+    return header;
+}
+
+std::shared_ptr<const uint8_t> MapFile(const std::string& filename, uint64_t& size) {
+#if defined(__unix__) || defined(__APPLE__)
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        OPENFHE_THROW("Can not open " + filename);
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        OPENFHE_THROW("Can not map " + filename);
+    }
+    size = static_cast<uint64_t>(st.st_size);
+    // The values are handed out as ordinary polynomial storage, which may be written in place. A private
+    // writable mapping makes such writes copy the touched page instead of faulting; pages that are only
+    // read stay shared with the page cache and with other processes mapping the same file.
+    void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (p == MAP_FAILED)
+        OPENFHE_THROW("Can not map " + filename);
+    return std::shared_ptr<const uint8_t>(static_cast<const uint8_t*>(p), [size](const uint8_t* q) {
+        munmap(const_cast<uint8_t*>(q), size);
+    });
+#else
+    // without mmap the file is read into one buffer shared by everything attached to it
+    std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+        OPENFHE_THROW("Can not open " + filename);
+    size        = static_cast<uint64_t>(file.tellg());
+    auto buffer = static_cast<uint8_t*>(AllocateAligned(size));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer), size)) {
+        DeallocateAligned(buffer, size);
+        OPENFHE_THROW("Can not read " + filename);
+    }
+    return std::shared_ptr<const uint8_t>(buffer,
+                                          [size](const uint8_t* q) { DeallocateAligned(const_cast<uint8_t*>(q), size); });
+#endif
+}
+
+}  // namespace lbcrypto
@@ -35,8 +35,105 @@
 
 #include "utils/parallel.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
 namespace lbcrypto {
 
 ParallelControls OpenFHEParallelControls;
 
+#ifdef PARALLEL
+namespace {
+
+// approximate number of modular multiply-accumulates per work item of each kernel
+// class: a coefficient of a batched NTT goes through log2(n)/2 butterflies, a
+// coefficient of a basis conversion through a row of the |Q|x|P| conversion matrix,
+// and a coefficient of scale-and-round through a dot product over the input towers
+constexpr uint32_t KERNEL_OPS_PER_ITEM[] = {8, 64, 16};
+
+// a thread's share of a parallel loop should cost this many times the fork/join overhead
+constexpr double AUTOTUNE_WORK_TO_OVERHEAD = 10.0;
+constexpr uint32_t AUTOTUNE_MIN_GRAIN      = 1 << 4;
+constexpr uint32_t AUTOTUNE_MAX_GRAIN      = 1 << 16;
+constexpr uint32_t AUTOTUNE_REPETITIONS    = 64;
+
+using AutotuneClock = std::chrono::steady_clock;
+
+double ElapsedNs(AutotuneClock::time_point start) {
+    return std::chrono::duration<double, std::nano>(AutotuneClock::now() - start).count();
+}
+
+// cost in nanoseconds of one modular multiply-accumulate on a 31-bit modulus
+double MeasureModMulCost() {
+    constexpr uint64_t q     = 2147483647;
+    constexpr uint32_t iters = 1 << 16;
+    volatile uint64_t seed   = 12345;
+    double best              = 0;
+    for (uint32_t r = 0; r < 8; ++r) {
+        uint64_t x = seed, y = seed + 1;
+        auto start = AutotuneClock::now();
+        for (uint32_t i = 0; i < iters; ++i) {
+            x = (x * y + i) % q;
+            y = (y * x + 1) % q;
+        }
+        double t = ElapsedNs(start) / (2 * iters);
+        seed     = x ^ y;
+        if (r == 0 || t < best)
+            best = t;
+    }
+    return best > 0 ? best : 1;
+}
+
+// cost in nanoseconds of forking and joining a team of nthreads threads
+double MeasureForkJoinOverhead(int nthreads) {
+    double best = 0;
+    for (uint32_t r = 0; r < AUTOTUNE_REPETITIONS; ++r) {
+        auto start = AutotuneClock::now();
+    #pragma omp parallel num_threads(nthreads)
+        {
+        }
+        double t = ElapsedNs(start);
+        // the first fork creates the thread team and is not representative
+        if (r == 1 || (r > 1 && t < best))
+            best = t;
+    }
+    return best;
 }
+
+uint32_t RoundGrain(double grain) {
+    uint32_t g = AUTOTUNE_MIN_GRAIN;
+    while (g < AUTOTUNE_MAX_GRAIN && g < grain)
+        g <<= 1;
+    return g;
+}
+
+}  // namespace
+#endif
+
+bool ParallelControls::Autotune(bool force) {
+#ifdef PARALLEL
+    if (autotuned && !force)
+        return false;
+    // a single thread never forks, so the defaults are as good as any grain
+    if (machineThreads > 1) {
+        double overhead = MeasureForkJoinOverhead(machineThreads);
+        double modMul   = MeasureModMulCost();
+        for (uint32_t k = 0; k < KERNEL_COUNT; ++k)
+            kernelGrain[k] = RoundGrain(AUTOTUNE_WORK_TO_OVERHEAD * overhead / (modMul * KERNEL_OPS_PER_ITEM[k]));
+    }
+    autotuned = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void ParallelControls::ResetKernelPolicy() {
+    std::fill(kernelThreads, kernelThreads + KERNEL_COUNT, 0);
+    std::copy(DEFAULT_KERNEL_GRAIN, DEFAULT_KERNEL_GRAIN + KERNEL_COUNT, kernelGrain);
+    autotune  = false;
+    autotuned = false;
+}
+
+}  // namespace lbcrypto
@@ -0,0 +1,241 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Thread-local pool of recycled native vector buffers
+ */
+
+#include "utils/vectorpool.h"
+#include "utils/arenaallocator.h"
+#include "utils/parallel.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace lbcrypto {
+
+namespace {
+
+// per-thread and process-wide limits of the cached bytes; see VectorPool::SetCapacity()
+std::atomic<size_t> poolCapacity{VectorPool::DEFAULT_CAPACITY};
+std::atomic<size_t> globalCapacity{VectorPool::DEFAULT_GLOBAL_CAPACITY};
+// bytes cached by all threads
+std::atomic<size_t> globalCachedBytes{0};
+
+struct ThreadPool;
+
+struct PoolRegistry {
+    std::mutex mutex;
+    std::unordered_set<ThreadPool*> pools;
+    // counters of the threads that have finished
+    uint64_t hits{0};
+    uint64_t misses{0};
+};
+
+PoolRegistry& GetRegistry() {
+    static PoolRegistry registry;
+    return registry;
+}
+
+// trivially destructible, so still usable while the thread-local pool itself is being destroyed
+thread_local uint32_t scopeDepth{0};
+thread_local bool poolDestroyed{false};
+
+struct ThreadPool {
+    std::unordered_map<size_t, std::vector<void*>> buffers;
+    // atomic only so that other threads can read them in VectorPool::GetStats()
+    std::atomic<size_t> cachedBytes{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+
+    ThreadPool() {
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.pools.insert(this);
+    }
+
+    ~ThreadPool() {
+        Clear();
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.hits += hits.load(std::memory_order_relaxed);
+        registry.misses += misses.load(std::memory_order_relaxed);
+        registry.pools.erase(this);
+        poolDestroyed = true;
+    }
+
+    void Clear() {
+        for (auto& [bytes, list] : buffers) {
+            for (void* p : list)
+                DeallocateAligned(p, bytes);
+        }
+        buffers.clear();
+        globalCachedBytes.fetch_sub(cachedBytes.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+
+    VectorPoolStats GetStats() const {
+        return {hits.load(std::memory_order_relaxed), misses.load(std::memory_order_relaxed),
+                cachedBytes.load(std::memory_order_relaxed)};
+    }
+};
+
+ThreadPool* GetThreadPool() {
+    if (poolDestroyed)
+        return nullptr;
+    thread_local ThreadPool pool;
+    return &pool;
+}
+
+bool IsPooled(size_t bytes) {
+    return scopeDepth != 0 && bytes >= VectorPool::MIN_POOLED_BYTES &&
+           poolCapacity.load(std::memory_order_relaxed) != 0;
+}
+
+bool InParallelRegion() {
+#ifdef PARALLEL
+    return omp_in_parallel() != 0;
+#else
+    return false;
+#endif
+}
+
+}  // namespace
+
+void* VectorPool::Allocate(size_t bytes) {
+    if (!IsPooled(bytes))
+        return AllocateAligned(bytes);
+    auto pool = GetThreadPool();
+    if (pool == nullptr)
+        return AllocateAligned(bytes);
+    auto it = pool->buffers.find(bytes);
+    if (it != pool->buffers.end() && !it->second.empty()) {
+        void* p = it->second.back();
+        it->second.pop_back();
+        pool->cachedBytes.store(pool->cachedBytes.load(std::memory_order_relaxed) - bytes, std::memory_order_relaxed);
+        globalCachedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+        pool->hits.fetch_add(1, std::memory_order_relaxed);
+        return p;
+    }
+    pool->misses.fetch_add(1, std::memory_order_relaxed);
+    return AllocateAligned(bytes);
+}
+
+void VectorPool::Deallocate(void* p, size_t bytes) noexcept {
+    if (p == nullptr)
+        return;
+    if (IsPooled(bytes)) {
+        auto pool = GetThreadPool();
+        if (pool != nullptr) {
+            size_t cached = pool->cachedBytes.load(std::memory_order_relaxed);
+            if (cached + bytes <= poolCapacity.load(std::memory_order_relaxed)) {
+                // the bytes are reserved in the process-wide budget before the buffer is kept
+                size_t global = globalCachedBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+                if (global <= globalCapacity.load(std::memory_order_relaxed)) {
+                    try {
+                        pool->buffers[bytes].push_back(p);
+                        pool->cachedBytes.store(cached + bytes, std::memory_order_relaxed);
+                        return;
+                    }
+                    catch (...) {
+                    }
+                }
+                globalCachedBytes.fetch_sub(bytes, std::memory_order_relaxed);
+            }
+        }
+    }
+    DeallocateAligned(p, bytes);
+}
+
+void VectorPool::SetCapacity(size_t bytes) {
+    poolCapacity.store(bytes, std::memory_order_relaxed);
+}
+
+size_t VectorPool::GetCapacity() {
+    return poolCapacity.load(std::memory_order_relaxed);
+}
+
+void VectorPool::SetGlobalCapacity(size_t bytes) {
+    globalCapacity.store(bytes, std::memory_order_relaxed);
+}
+
+size_t VectorPool::GetGlobalCapacity() {
+    return globalCapacity.load(std::memory_order_relaxed);
+}
+
+VectorPoolStats VectorPool::GetThreadStats() {
+    auto pool = GetThreadPool();
+    return pool ? pool->GetStats() : VectorPoolStats();
+}
+
+VectorPoolStats VectorPool::GetStats() {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    VectorPoolStats stats{registry.hits, registry.misses, 0};
+    for (const auto* pool : registry.pools) {
+        auto s = pool->GetStats();
+        stats.hits += s.hits;
+        stats.misses += s.misses;
+        stats.cachedBytes += s.cachedBytes;
+    }
+    return stats;
+}
+
+void VectorPool::ResetStats() {
+    auto& registry = GetRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.hits   = 0;
+    registry.misses = 0;
+    for (auto* pool : registry.pools) {
+        pool->hits.store(0, std::memory_order_relaxed);
+        pool->misses.store(0, std::memory_order_relaxed);
+    }
+}
+
+void VectorPool::Release() {
+    if (auto pool = GetThreadPool())
+        pool->Clear();
+}
+
+void VectorPool::Enter() {
+    ++scopeDepth;
+}
+
+void VectorPool::Leave() {
+    // OpenMP workers live as long as the program, so a worker that entered a scope (e.g. through a kernel
+    // called inside a parallel region) returns its buffers when it leaves the outermost one
+    if (--scopeDepth == 0 && InParallelRegion())
+        Release();
+}
+
+}  // namespace lbcrypto
@@ -38,6 +38,8 @@
 
 #include "lattice/lat-hal.h"
 #include "lattice/ilelement.h"
+#include "math/distrgen.h"
+#include "math/nbtheory.h"
 #include "testdefs.h"
 #include "utils/debug.h"
 #include "utils/inttypes.h"
@@ -550,3 +552,54 @@ void modmul_vector(const std::string& msg) {
 TEST(UTBinVect, modmul_vector) {
     RUN_BIG_BACKENDS(modmul_vector, "modmul_vector")
 }
+
+TEST(UTBinVect, montgomery_native) {
+    const uint32_t n{64};
+    for (usint bits : {20, 45, 60}) {
+        auto q = LastPrime<NativeInteger>(bits, 2 * n);
+        DiscreteUniformGeneratorImpl<NativeVector> dug;
+        dug.SetModulus(q);
+        NativeVector a(dug.GenerateVector(n));
+        NativeVector b(dug.GenerateVector(n));
+        a[0] = 0;
+        b[1] = q - 1;
+
+        NativeVector bMont(b);
+        bMont.ToMontgomeryEq();
+        NativeVector back(bMont);
+        back.FromMontgomeryEq();
+        EXPECT_EQ(b, back) << "Montgomery round trip failed for " << bits << " bits";
+
+        NativeVector expected(a.ModMul(b));
+        NativeVector calculated(a);
+        calculated.ModMulMontgomeryEq(bMont);
+        EXPECT_EQ(expected, calculated) << "Montgomery product failed for " << bits << " bits";
+
+        // a product of two Montgomery operands stays in Montgomery form
+        NativeVector aMont(a);
+        aMont.ToMontgomeryEq();
+        aMont.ModMulMontgomeryEq(bMont);
+        aMont.FromMontgomeryEq();
+        EXPECT_EQ(expected, aMont) << "Montgomery form product failed for " << bits << " bits";
+    }
+
+    NativeVector even(4, NativeInteger(1024));
+    EXPECT_THROW(even.ToMontgomeryEq(), OpenFHEException) << "even modulus not rejected";
+}
+
+TEST(UTBinVect, aligned_storage_native) {
+    NativeInteger q("1152921504606584833");
+    for (usint n : {1, 3, 1024, 1 << 17}) {
+        NativeVector v(n, q);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(&v[0]) % VECTOR_ALIGNMENT) << "vector of length " << n;
+        NativeVector copy(v);
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(&copy[0]) % VECTOR_ALIGNMENT) << "copy of length " << n;
+    }
+
+    EnableHugePages(true);
+    usint n = 4 * HUGE_PAGE_SIZE / sizeof(NativeInteger);
+    NativeVector big(n, q, NativeInteger(12345));
+    EnableHugePages(false);
+    EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(&big[0]) % HUGE_PAGE_SIZE) << "large vector alignment";
+    EXPECT_EQ(NativeInteger(12345), big[n - 1]) << "large vector contents";
+}
@@ -592,6 +592,153 @@ TEST(UTDCRTPoly, DCRT_mod_ops_on_two_elements) {
     RUN_BIG_DCRTPOLYS(DCRT_mod_ops_on_two_elements, "DCRT DCRT_mod_ops_on_two_elements");
 }
 
+template <typename Element>
+void DCRT_multiply_accumulate(const std::string& msg) {
+    uint32_t order     = 4096;
+    uint32_t nBits     = 50;
+    uint32_t towersize = 3;
+
+    auto ildcrtparams = std::make_shared<ILDCRTParams<typename Element::Integer>>(order, towersize, nBits);
+
+    typename Element::DugType dug;
+
+    // operands in both formats and results in both formats
+    std::vector<Element> operands;
+    for (uint32_t i = 0; i < 4; ++i)
+        operands.emplace_back(dug, ildcrtparams, i == 0 ? Format::EVALUATION : Format::COEFFICIENT);
+    std::vector<std::vector<Element>> keys(operands.size());
+    for (auto& row : keys) {
+        for (uint32_t j = 0; j < 2; ++j)
+            row.emplace_back(dug, ildcrtparams, Format::EVALUATION);
+    }
+    std::vector<Element> results{Element(ildcrtparams, Format::EVALUATION, true),
+                                 Element(dug, ildcrtparams, Format::COEFFICIENT)};
+
+    std::vector<Element> expected(results);
+    for (auto& r : expected)
+        r.SetFormat(Format::EVALUATION);
+    for (uint32_t i = 0; i < operands.size(); ++i) {
+        Element a(operands[i]);
+        a.SetFormat(Format::EVALUATION);
+        for (uint32_t j = 0; j < results.size(); ++j)
+            expected[j] += a * keys[i][j];
+    }
+    expected[1].SetFormat(Format::COEFFICIENT);
+
+    std::vector<Element> inputs(operands);
+    Element::MultiplyAccumulate(operands, keys, results);
+    EXPECT_EQ(inputs, operands) << msg << " Failure: operands modified";
+    EXPECT_EQ(Format::EVALUATION, results[0].GetFormat()) << msg << " Failure: result format";
+    EXPECT_EQ(Format::COEFFICIENT, results[1].GetFormat()) << msg << " Failure: result format";
+    EXPECT_EQ(expected, results) << msg << " Failure: MultiplyAccumulate";
+}
+
+TEST(UTDCRTPoly, DCRT_multiply_accumulate) {
+    RUN_BIG_DCRTPOLYS(DCRT_multiply_accumulate, "DCRT_multiply_accumulate");
+}
+
+template <typename Element>
+void DCRT_contiguous(const std::string& msg) {
+    uint32_t order     = 4096;
+    uint32_t nBits     = 50;
+    uint32_t towersize = 3;
+
+    auto ildcrtparams = std::make_shared<ILDCRTParams<typename Element::Integer>>(order, towersize, nBits);
+
+    typename Element::DugType dug;
+    Element a(dug, ildcrtparams, Format::EVALUATION);
+    Element b(dug, ildcrtparams, Format::EVALUATION);
+    EXPECT_FALSE(a.IsContiguous()) << msg << " Failure: heap towers reported contiguous";
+
+    Element packed(a);
+    packed.MakeContiguous();
+    EXPECT_TRUE(packed.IsContiguous()) << msg << " Failure: MakeContiguous";
+    EXPECT_EQ(a, packed) << msg << " Failure: MakeContiguous changed the values";
+
+    // towers are consecutive aligned slices of one allocation
+    for (uint32_t i = 0; i < towersize; ++i) {
+        auto p = reinterpret_cast<uintptr_t>(&packed.GetElementAtIndex(i)[0]);
+        EXPECT_EQ(0u, p % ContiguousArena::ALIGNMENT) << msg << " Failure: tower alignment";
+        if (i > 0) {
+            auto prev = reinterpret_cast<uintptr_t>(&packed.GetElementAtIndex(i - 1)[0]);
+            EXPECT_EQ(prev + ContiguousArena::RoundUp(order / 2 * sizeof(NativeInteger)), p)
+                << msg << " Failure: tower layout";
+        }
+    }
+
+    Element copy(packed);
+    EXPECT_TRUE(copy.IsContiguous()) << msg << " Failure: copy of a contiguous DCRTPoly";
+    copy += b;
+    EXPECT_TRUE(copy.IsContiguous()) << msg << " Failure: in-place addition";
+    EXPECT_EQ(a + b, copy) << msg << " Failure: addition on contiguous towers";
+    EXPECT_EQ(a, packed) << msg << " Failure: copy shares storage with the original";
+
+    Element assigned;
+    assigned = copy;
+    EXPECT_TRUE(assigned.IsContiguous()) << msg << " Failure: assignment of a contiguous DCRTPoly";
+    Element moved(std::move(assigned));
+    EXPECT_TRUE(moved.IsContiguous()) << msg << " Failure: move of a contiguous DCRTPoly";
+    EXPECT_EQ(copy, moved) << msg << " Failure: move";
+}
+
+TEST(UTDCRTPoly, DCRT_contiguous) {
+    RUN_BIG_DCRTPOLYS(DCRT_contiguous, "DCRT_contiguous");
+}
+
+TEST(UTDCRTPoly, DCRT_approx_switch_crt_basis) {
+    // an odd number of target towers exercises the remainder of the blocked kernel
+    uint32_t order = 4096;
+    uint32_t sizeQ = 6;
+    uint32_t sizeP = 7;
+
+    auto paramsQ = std::make_shared<ILDCRTParams<BigInteger>>(order, sizeQ, 50);
+    std::vector<NativeInteger> moduliP(sizeP);
+    std::vector<NativeInteger> rootsP(sizeP);
+    NativeInteger pj = LastPrime<NativeInteger>(55, order);
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        moduliP[j] = pj;
+        rootsP[j]  = RootOfUnity<NativeInteger>(order, pj);
+        pj         = PreviousPrime<NativeInteger>(pj, order);
+    }
+    auto paramsP = std::make_shared<ILDCRTParams<BigInteger>>(order, moduliP, rootsP);
+
+    const BigInteger Q(paramsQ->GetModulus());
+    const auto barrettBase128Bit(BigInteger(1).LShiftEq(128));
+    std::vector<NativeInteger> QHatInvModq(sizeQ);
+    std::vector<NativeInteger> QHatInvModqPrecon(sizeQ);
+    std::vector<std::vector<NativeInteger>> QHatModp(sizeQ, std::vector<NativeInteger>(sizeP));
+    std::vector<DoubleNativeInt> modpBarrettMu(sizeP);
+    for (uint32_t i = 0; i < sizeQ; ++i) {
+        const NativeInteger& qi = paramsQ->GetParams()[i]->GetModulus();
+        BigInteger QHati        = Q / BigInteger(qi);
+        QHatInvModq[i]          = QHati.Mod(BigInteger(qi)).ModInverse(BigInteger(qi)).ConvertToInt();
+        QHatInvModqPrecon[i]    = QHatInvModq[i].PrepModMulConst(qi);
+        for (uint32_t j = 0; j < sizeP; ++j)
+            QHatModp[i][j] = QHati.Mod(BigInteger(moduliP[j])).ConvertToInt();
+    }
+    for (uint32_t j = 0; j < sizeP; ++j)
+        modpBarrettMu[j] = (barrettBase128Bit / BigInteger(moduliP[j])).ConvertToInt<DoubleNativeInt>();
+
+    DCRTPoly::DugType dug;
+    DCRTPoly x(dug, paramsQ, Format::COEFFICIENT);
+    auto y = x.ApproxSwitchCRTBasis(paramsQ, paramsP, QHatInvModq, QHatInvModqPrecon, QHatModp, modpBarrettMu);
+
+    ASSERT_EQ(sizeP, y.GetNumOfElements());
+    uint32_t n = paramsQ->GetRingDimension();
+    for (uint32_t j = 0; j < sizeP; ++j) {
+        const auto& yj = y.GetElementAtIndex(j);
+        for (uint32_t k = 0; k < n; ++k) {
+            NativeInteger expected(0);
+            for (uint32_t i = 0; i < sizeQ; ++i) {
+                const NativeInteger& qi = paramsQ->GetParams()[i]->GetModulus();
+                NativeInteger xi        = x.GetElementAtIndex(i)[k].ModMul(QHatInvModq[i], qi).Mod(moduliP[j]);
+                expected.ModAddEq(xi.ModMul(QHatModp[i][j], moduliP[j]), moduliP[j]);
+            }
+            ASSERT_EQ(expected, yj[k]) << "Failure: ApproxSwitchCRTBasis tower " << j << " coefficient " << k;
+        }
+    }
+}
+
 // only need to try this with one
 void testDCRTPolyConstructorNegative(std::vector<NativePoly>& towers) {
     DCRTPoly expectException(towers);
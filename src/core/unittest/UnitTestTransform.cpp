@@ -375,3 +375,251 @@ void CRT_CHECK_very_big_ring_precomputed(const std::string& msg) {
 TEST(UTTransform, CRT_CHECK_very_big_ring_precomputed) {
     RUN_BIG_BACKENDS(CRT_CHECK_very_big_ring_precomputed, "CRT_CHECK_very_big_ring_precomputed")
 }
+
+// the vectorized native NTT backends must reproduce the scalar transforms bit for bit
+TEST(UTTransform, CRT_CHECK_native_simd_backends) {
+    const auto supported = intnat::GetNTTSimdBackendSupported();
+    const auto original  = intnat::GetNTTSimdBackend();
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    for (usint m : {16, 64, 2048, 16384}) {
+        usint n = m / 2;
+        for (usint bits : {30, 50, MAX_MODULUS_SIZE}) {
+            NativeInteger modulus     = LastPrime<NativeInteger>(bits, m);
+            NativeInteger rootOfUnity = RootOfUnity(m, modulus);
+            ChineseRemainderTransformFTT<NativeVector>().PreCompute(rootOfUnity, m, modulus);
+
+            NativeVector input = dug.GenerateVector(n, modulus);
+
+            intnat::SetNTTSimdBackend(intnat::NTT_SIMD_SCALAR);
+            NativeVector forward(input);
+            ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(rootOfUnity, m, &forward);
+            NativeVector inverse(input);
+            ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(rootOfUnity, m,
+                                                                                               &inverse);
+
+            for (int b = intnat::NTT_SIMD_AVX2; b <= supported; ++b) {
+                auto backend = static_cast<intnat::NTTSimdBackend>(b);
+                std::string msg = "backend " + std::to_string(b) + ", m = " + std::to_string(m) +
+                                  ", bits = " + std::to_string(bits);
+                EXPECT_EQ(intnat::SetNTTSimdBackend(backend), backend) << msg;
+
+                NativeVector forwardSimd(input);
+                ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(rootOfUnity, m,
+                                                                                                 &forwardSimd);
+                EXPECT_EQ(forward, forwardSimd) << "forward: " << msg;
+
+                NativeVector forwardCopy(n);
+                ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverse(input, rootOfUnity, m,
+                                                                                          &forwardCopy);
+                EXPECT_EQ(forward, forwardCopy) << "forward copy: " << msg;
+
+                NativeVector inverseSimd(input);
+                ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(rootOfUnity, m,
+                                                                                                   &inverseSimd);
+                EXPECT_EQ(inverse, inverseSimd) << "inverse: " << msg;
+
+                ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(rootOfUnity, m,
+                                                                                                   &forwardSimd);
+                EXPECT_EQ(input, forwardSimd) << "round trip: " << msg;
+            }
+        }
+    }
+    intnat::SetNTTSimdBackend(original);
+}
+
+// runs the staged transforms block by block in the order used by the batched transforms
+TEST(UTTransform, CRT_CHECK_native_blocked_stages) {
+    using FTT           = ChineseRemainderTransformFTT<NativeVector>;
+    const auto original = intnat::GetNTTSimdBackend();
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    intnat::NumberTheoreticTransformNat<NativeVector> ntt;
+    for (usint m : {64, 16384}) {
+        usint n = m / 2;
+        for (usint bits : {30, 50, MAX_MODULUS_SIZE}) {
+            NativeInteger modulus     = LastPrime<NativeInteger>(bits, m);
+            NativeInteger rootOfUnity = RootOfUnity(m, modulus);
+            auto tables              = FTT::GetTables(rootOfUnity, m, modulus);
+            const auto& table        = tables->rootOfUnityReverseTable;
+            const auto& precon       = tables->rootOfUnityPreconReverseTable;
+            const auto& tableInv     = tables->rootOfUnityInverseReverseTable;
+            const auto& preconInv    = tables->rootOfUnityInversePreconReverseTable;
+            NativeInteger nInverse   = tables->cycloOrderInv;
+            NativeInteger nInvPrecon = tables->cycloOrderInvPrecon;
+
+            NativeVector input = dug.GenerateVector(n, modulus);
+            for (int b = intnat::NTT_SIMD_SCALAR; b <= intnat::GetNTTSimdBackendSupported(); ++b) {
+                intnat::SetNTTSimdBackend(static_cast<intnat::NTTSimdBackend>(b));
+                NativeVector forward(input);
+                FTT().ForwardTransformToBitReverseInPlace(rootOfUnity, m, &forward);
+                NativeVector inverse(input);
+                FTT().InverseTransformFromBitReverseInPlace(rootOfUnity, m, &inverse);
+                for (uint32_t nBlocks : {2, 8}) {
+                    std::string msg = "backend " + std::to_string(b) + ", m = " + std::to_string(m) +
+                                      ", bits = " + std::to_string(bits) + ", blocks = " + std::to_string(nBlocks);
+
+                    NativeVector forwardBlocked(input);
+                    for (uint32_t s = 1; s < nBlocks; s <<= 1) {
+                        for (uint32_t block = 0; block < nBlocks; ++block)
+                            ntt.ForwardTransformToBitReverseStages(table, precon, s, s << 1, block, nBlocks,
+                                                                   &forwardBlocked);
+                    }
+                    for (uint32_t block = 0; block < nBlocks; ++block)
+                        ntt.ForwardTransformToBitReverseStages(table, precon, nBlocks, n, block, nBlocks,
+                                                               &forwardBlocked);
+                    EXPECT_EQ(forward, forwardBlocked) << "forward: " << msg;
+
+                    NativeVector inverseBlocked(input);
+                    for (uint32_t block = 0; block < nBlocks; ++block)
+                        ntt.InverseTransformFromBitReverseStages(tableInv, preconInv, nInverse, nInvPrecon, nBlocks, n,
+                                                                 block, nBlocks, &inverseBlocked);
+                    for (uint32_t s = nBlocks >> 1; s >= 1; s >>= 1) {
+                        for (uint32_t block = 0; block < nBlocks; ++block)
+                            ntt.InverseTransformFromBitReverseStages(tableInv, preconInv, nInverse, nInvPrecon, s,
+                                                                     s << 1, block, nBlocks, &inverseBlocked);
+                    }
+                    EXPECT_EQ(inverse, inverseBlocked) << "inverse: " << msg;
+                }
+            }
+        }
+    }
+    intnat::SetNTTSimdBackend(original);
+}
+
+TEST(UTTransform, CRT_CHECK_native_batched) {
+    usint m = 4096;
+    usint n = m / 2;
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    std::vector<NativeInteger> roots;
+    std::vector<NativeVector> inputs;
+    NativeInteger modulus = LastPrime<NativeInteger>(MAX_MODULUS_SIZE, m);
+    for (usint i = 0; i < 5; ++i) {
+        roots.push_back(RootOfUnity(m, modulus));
+        inputs.push_back(dug.GenerateVector(n, modulus));
+        modulus = PreviousPrime(modulus, m);
+    }
+
+    std::vector<NativeVector> batched(inputs);
+    std::vector<NativeVector*> elements;
+    for (auto& v : batched)
+        elements.push_back(&v);
+
+    ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(roots, m, elements);
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        NativeVector expected(inputs[i]);
+        ChineseRemainderTransformFTT<NativeVector>().ForwardTransformToBitReverseInPlace(roots[i], m, &expected);
+        EXPECT_EQ(expected, batched[i]) << "forward, tower " << i;
+    }
+
+    ChineseRemainderTransformFTT<NativeVector>().InverseTransformFromBitReverseInPlace(roots, m, elements);
+    EXPECT_EQ(inputs, batched) << "round trip";
+}
+
+// the tables are registered once per modulus and cyclotomic order and shared with the element parameters
+TEST(UTTransform, CRT_CHECK_native_tables_registry) {
+    using FTT             = ChineseRemainderTransformFTT<NativeVector>;
+    usint m               = 2048;
+    NativeInteger modulus = LastPrime<NativeInteger>(MAX_MODULUS_SIZE, m);
+    NativeInteger root    = RootOfUnity(m, modulus);
+
+    auto tables = FTT::GetTables(root, m, modulus);
+    EXPECT_EQ(tables, FTT::GetTables(root, m, modulus)) << "tables are not shared";
+    EXPECT_NE(tables, FTT::GetTables(RootOfUnity(2 * m, modulus), 2 * m, modulus)) << "cyclotomic order is ignored";
+
+    ILNativeParams params(m, modulus, root);
+    EXPECT_EQ(tables, params.GetNTTTables()) << "parameters do not hold the registered tables";
+    EXPECT_EQ(params.GetNTTTables(), ILNativeParams(params).GetNTTTables()) << "copy drops the tables";
+
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    NativeVector input = dug.GenerateVector(m / 2, modulus);
+    NativeVector expected(input), result(input);
+    FTT().ForwardTransformToBitReverseInPlace(root, m, &expected);
+    FTT().ForwardTransformToBitReverseInPlace(*params.GetNTTTables(), &result);
+    EXPECT_EQ(expected, result) << "forward";
+    FTT().InverseTransformFromBitReverseInPlace(*params.GetNTTTables(), &result);
+    EXPECT_EQ(input, result) << "round trip";
+
+    // the registry can be cleared while parameters still hold their tables
+    FTT().Reset();
+    EXPECT_NE(params.GetNTTTables(), nullptr);
+    EXPECT_EQ(params.GetNTTTables()->cycloOrderInv, tables->cycloOrderInv);
+}
+
+// the cache-blocked transforms are checked against the radix-2 lazy transforms
+TEST(UTTransform, CRT_CHECK_native_cache_blocked) {
+    using FTT = ChineseRemainderTransformFTT<NativeVector>;
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    intnat::NumberTheoreticTransformNat<NativeVector> ntt;
+    for (usint m : {16384, 131072, 262144}) {
+        usint n = m / 2;
+        for (usint bits : {30, 50, MAX_MODULUS_SIZE}) {
+            NativeInteger modulus     = LastPrime<NativeInteger>(bits, m);
+            NativeInteger rootOfUnity = RootOfUnity(m, modulus);
+            auto tables               = FTT::GetTables(rootOfUnity, m, modulus);
+
+            std::string msg    = "m = " + std::to_string(m) + ", bits = " + std::to_string(bits);
+            NativeVector input = dug.GenerateVector(n, modulus);
+
+            NativeVector forward(input), forwardBlocked(input);
+            ntt.ForwardTransformToBitReverseInPlaceLazy(tables->rootOfUnityReverseTable,
+                                                        tables->rootOfUnityPreconReverseTable, &forward);
+            ntt.ForwardTransformToBitReverseInPlaceBlocked(tables->rootOfUnityReverseTable,
+                                                           tables->rootOfUnityPreconReverseTable, &forwardBlocked);
+            EXPECT_EQ(forward, forwardBlocked) << "forward: " << msg;
+
+            NativeVector inverse(input), inverseBlocked(input);
+            ntt.InverseTransformFromBitReverseInPlaceLazy(
+                tables->rootOfUnityInverseReverseTable, tables->rootOfUnityInversePreconReverseTable,
+                tables->cycloOrderInv, tables->cycloOrderInvPrecon, &inverse);
+            ntt.InverseTransformFromBitReverseInPlaceBlocked(
+                tables->rootOfUnityInverseReverseTable, tables->rootOfUnityInversePreconReverseTable,
+                tables->cycloOrderInv, tables->cycloOrderInvPrecon, &inverseBlocked);
+            EXPECT_EQ(inverse, inverseBlocked) << "inverse: " << msg;
+        }
+    }
+}
+
+// the lazy butterflies are checked against the Barrett-based transforms, which reduce at every step
+TEST(UTTransform, CRT_CHECK_native_lazy_butterflies) {
+    DiscreteUniformGeneratorImpl<NativeVector> dug;
+    intnat::NumberTheoreticTransformNat<NativeVector> ntt;
+    for (usint m : {4, 16, 2048, 16384}) {
+        usint n   = m / 2;
+        usint msb = GetMSB(n - 1);
+        for (usint bits : {30, 50, MAX_MODULUS_SIZE}) {
+            NativeInteger modulus     = LastPrime<NativeInteger>(bits, m);
+            NativeInteger rootOfUnity = RootOfUnity(m, modulus);
+            NativeInteger rootInverse = rootOfUnity.ModInverse(modulus);
+            NativeInteger nInverse    = NativeInteger(n).ModInverse(modulus);
+            NativeInteger nInvPrecon  = nInverse.PrepModMulConst(modulus);
+            NativeInteger x(1), xinv(1);
+            NativeVector table(n, modulus), tableInv(n, modulus), precon(n, modulus), preconInv(n, modulus);
+            for (usint i = 0; i < n; ++i) {
+                usint iinv      = ReverseBits(i, msb);
+                table[iinv]     = x;
+                tableInv[iinv]  = xinv;
+                precon[iinv]    = x.PrepModMulConst(modulus);
+                preconInv[iinv] = xinv.PrepModMulConst(modulus);
+                x.ModMulEq(rootOfUnity, modulus);
+                xinv.ModMulEq(rootInverse, modulus);
+            }
+
+            std::string msg    = "m = " + std::to_string(m) + ", bits = " + std::to_string(bits);
+            NativeVector input = dug.GenerateVector(n, modulus);
+
+            NativeVector forward(input), forwardLazy(input);
+            ntt.ForwardTransformToBitReverseInPlace(table, &forward);
+            ntt.ForwardTransformToBitReverseInPlaceLazy(table, precon, &forwardLazy);
+            EXPECT_EQ(forward, forwardLazy) << "forward: " << msg;
+
+            NativeVector inverse(input), inverseLazy(input);
+            ntt.InverseTransformFromBitReverseInPlace(tableInv, nInverse, &inverse);
+            ntt.InverseTransformFromBitReverseInPlaceLazy(tableInv, preconInv, nInverse, nInvPrecon, &inverseLazy);
+            EXPECT_EQ(inverse, inverseLazy) << "inverse: " << msg;
+
+            ntt.InverseTransformFromBitReverseInPlaceLazy(tableInv, preconInv, nInverse, nInvPrecon, &forwardLazy);
+            EXPECT_EQ(input, forwardLazy) << "round trip: " << msg;
+        }
+    }
+}
@@ -37,7 +37,10 @@
 #include <iostream>
 #include "include/gtest/gtest.h"
 
+#include "math/math-hal.h"
+#include "utils/parallel.h"
 #include "utils/utilities.h"
+#include "utils/vectorpool.h"
 
 using namespace lbcrypto;
 
@@ -53,3 +56,95 @@ TEST(Utilities, IsPowerOfTwo) {
         EXPECT_FALSE(IsPowerOfTwo(not_power_of_two));
     }
 }
+
+TEST(Utilities, VectorPool) {
+    VectorPool::Release();
+    VectorPool::ResetStats();
+    const size_t n     = 3 * 1024 + 8;
+    const size_t bytes = n * sizeof(NativeInteger);
+
+    {
+        NativeVector v(n);
+    }
+    auto stats = VectorPool::GetThreadStats();
+    EXPECT_EQ(0u, stats.hits + stats.misses) << "allocation outside of a scope used the pool";
+
+    {
+        VectorPoolScope scope;
+        const NativeInteger* first;
+        {
+            NativeVector v(n);
+            first = &v[0];
+        }
+        EXPECT_EQ(bytes, VectorPool::GetThreadStats().cachedBytes) << "freed buffer not cached";
+        NativeVector w(n);
+        EXPECT_EQ(first, &w[0]) << "cached buffer not reused";
+        stats = VectorPool::GetThreadStats();
+        EXPECT_EQ(1u, stats.hits);
+        EXPECT_EQ(1u, stats.misses);
+        EXPECT_EQ(0u, stats.cachedBytes);
+
+        auto capacity = VectorPool::GetCapacity();
+        VectorPool::SetCapacity(0);
+        {
+            NativeVector v(n);
+        }
+        EXPECT_EQ(0u, VectorPool::GetThreadStats().cachedBytes) << "disabled pool cached a buffer";
+        VectorPool::SetCapacity(capacity);
+
+        auto globalCapacity = VectorPool::GetGlobalCapacity();
+        VectorPool::SetGlobalCapacity(bytes - 1);
+        {
+            NativeVector v(n);
+        }
+        EXPECT_EQ(0u, VectorPool::GetThreadStats().cachedBytes) << "global capacity exceeded";
+        VectorPool::SetGlobalCapacity(globalCapacity);
+    }
+    EXPECT_GE(VectorPool::GetStats().hits, 1u) << "global counters";
+    VectorPool::Release();
+    EXPECT_EQ(0u, VectorPool::GetThreadStats().cachedBytes);
+
+#ifdef PARALLEL
+    // threads that leave their outermost scope inside a parallel region keep nothing
+    #pragma omp parallel num_threads(4)
+    {
+        VectorPoolScope scope;
+        NativeVector v(n);
+    }
+    EXPECT_EQ(0u, VectorPool::GetStats().cachedBytes) << "buffers retained by OpenMP threads";
+#endif
+}
+
+TEST(Utilities, ParallelKernelPolicy) {
+    ParallelControls& controls = OpenFHEParallelControls;
+    int machineThreads         = controls.GetMachineThreads();
+
+    controls.SetKernelThreads(ParallelKernel::BASIS_CONVERSION, 2);
+    controls.SetKernelGrain(ParallelKernel::BASIS_CONVERSION, 64);
+    EXPECT_EQ(2u, controls.GetKernelThreads(ParallelKernel::BASIS_CONVERSION));
+    EXPECT_EQ(64u, controls.GetKernelGrain(ParallelKernel::BASIS_CONVERSION));
+#ifdef PARALLEL
+    EXPECT_EQ(std::min(2, machineThreads), controls.GetKernelThreadLimit(ParallelKernel::BASIS_CONVERSION, 1 << 16))
+        << "budget not applied";
+    EXPECT_EQ(1, controls.GetKernelThreadLimit(ParallelKernel::BASIS_CONVERSION, 100)) << "grain not applied";
+    EXPECT_EQ(1, controls.GetKernelThreadLimit(ParallelKernel::BASIS_CONVERSION, 0));
+
+    controls.SetKernelThreads(ParallelKernel::SCALE_AND_ROUND, 0);
+    controls.SetKernelGrain(ParallelKernel::SCALE_AND_ROUND, 0);
+    EXPECT_EQ(1u, controls.GetKernelGrain(ParallelKernel::SCALE_AND_ROUND));
+    EXPECT_EQ(machineThreads, controls.GetKernelThreadLimit(ParallelKernel::SCALE_AND_ROUND, 1 << 20))
+        << "unlimited budget should use all machine threads";
+
+    EXPECT_TRUE(controls.Autotune());
+    EXPECT_FALSE(controls.Autotune()) << "autotune ran twice";
+    EXPECT_TRUE(controls.Autotune(true));
+    for (auto kernel : {ParallelKernel::NTT, ParallelKernel::BASIS_CONVERSION, ParallelKernel::SCALE_AND_ROUND})
+        EXPECT_GE(controls.GetKernelGrain(kernel), 1u);
+#else
+    EXPECT_EQ(1, controls.GetKernelThreadLimit(ParallelKernel::BASIS_CONVERSION, 1 << 16));
+#endif
+
+    controls.ResetKernelPolicy();
+    EXPECT_EQ(0u, controls.GetKernelThreads(ParallelKernel::BASIS_CONVERSION));
+    EXPECT_FALSE(controls.IsAutotuneEnabled());
+}
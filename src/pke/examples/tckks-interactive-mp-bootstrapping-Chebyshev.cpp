@@ -197,7 +197,7 @@ void TCKKSCollectiveBoot(enum ScalingTechnique scaleTech) {
     // Generate evalsum key part for A
     cryptoContext->EvalSumKeyGen(kp1.secretKey);
     auto evalSumKeys = std::make_shared<std::map<usint, EvalKey<DCRTPoly>>>(
-        cryptoContext->GetEvalSumKeyMap(kp1.secretKey->GetKeyTag()));
+        *cryptoContext->GetEvalSumKeyMap(kp1.secretKey->GetKeyTag()));
 
     // Round 2 (party B)
     kp2                  = cryptoContext->MultipartyKeyGen(kp1.publicKey);
@@ -121,6 +121,11 @@ template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey<SerType:
     std::ostream& ser, const SerType::SERJSON&, const CryptoContext<DCRTPoly> cc);
 template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey<SerType::SERJSON>(std::istream& ser,
                                                                                             const SerType::SERJSON&);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalEncapsulationKey<SerType::SERJSON>(std::ostream& ser,
+                                                                                           const SerType::SERJSON&,
+                                                                                           std::string id);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalEncapsulationKey<SerType::SERJSON>(std::istream& ser,
+                                                                                             const SerType::SERJSON&);
 
 // ================================= BINARY serialization/deserialization
 namespace Serial {
@@ -205,6 +210,11 @@ template bool CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey<SerType:
     std::ostream& ser, const SerType::SERBINARY&, const CryptoContext<DCRTPoly> cc);
 template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey<SerType::SERBINARY>(
     std::istream& ser, const SerType::SERBINARY&);
+template bool CryptoContextImpl<DCRTPoly>::SerializeEvalEncapsulationKey<SerType::SERBINARY>(std::ostream& ser,
+                                                                                             const SerType::SERBINARY&,
+                                                                                             std::string id);
+template bool CryptoContextImpl<DCRTPoly>::DeserializeEvalEncapsulationKey<SerType::SERBINARY>(
+    std::istream& ser, const SerType::SERBINARY&);
 
 }  // namespace lbcrypto
 
@@ -43,6 +43,7 @@
 #include "encoding/plaintextfactory.h"
 
 #include "key/evalkey.h"
+#include "key/evalkeyregistry.h"
 #include "key/keypair.h"
 
 #include "schemebase/base-pke.h"
@@ -323,10 +324,6 @@ class CryptoContextImpl : public Serializable {
                                            CryptoContextImpl<Element>::GetUniqueValues(existingIndices, indices);
     }
     /**
-   * Get automorphism keys for a specific secret key tag
-   */
-    static std::shared_ptr<std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMapPtr(const std::string& keyID);
-    /**
    * @brief Get automorphism keys for a specific secret key tag and an array of specific indices
    * @param keyID - secret key tag
    * @param indexList - array of specific indices to retrieve key for
@@ -336,9 +333,11 @@ class CryptoContextImpl : public Serializable {
         const std::string& keyID, const std::vector<uint32_t>& indexList);
 
     // cached evalmult keys, by secret key UID
-    static std::map<std::string, std::vector<EvalKey<Element>>> s_evalMultKeyMap;
+    static EvalKeyRegistry<std::vector<EvalKey<Element>>> s_evalMultKeyMap;
     // cached evalautomorphism keys, by secret key UID
-    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> s_evalAutomorphismKeyMap;
+    static EvalKeyRegistry<std::shared_ptr<std::map<usint, EvalKey<Element>>>> s_evalAutomorphismKeyMap;
+    // cached sparse-secret encapsulation keys for bootstrapping, by secret key UID
+    static EvalKeyRegistry<std::vector<EvalKey<Element>>> s_evalEncapsulationKeyMap;
 
 protected:
     // crypto parameters used for this context
@@ -686,7 +685,10 @@ public:
    */
     template <typename ST>
     static bool DeserializeEvalMultKey(std::istream& ser, const ST& sertype) {
-        Serial::Deserialize(CryptoContextImpl<Element>::GetAllEvalMultKeys(), ser, sertype);
+        std::map<std::string, std::vector<EvalKey<Element>>> keyMap;
+        Serial::Deserialize(keyMap, ser, sertype);
+        for (auto& [keyTag, keys] : keyMap)
+            CryptoContextImpl<Element>::s_evalMultKeyMap.Set(keyTag, std::move(keys));
 
         // TODO (dsuponit): should we keep the code below?
         // // The deserialize call created any contexts that needed to be created....
@@ -800,17 +802,15 @@ public:
     template <typename ST>
     static bool SerializeEvalAutomorphismKey(std::ostream& ser, const ST& sertype, std::string id = "") {
         // TODO (dsuponit): do we need Serailize/Deserialized to return bool?
-        std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>* smap;
         std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> omap;
         if (id.length() == 0) {
-            smap = &CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
+            omap = CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
         }
         else {
-            const auto keys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(id);
-            omap[id]        = keys;
-            smap            = &omap;
+            omap[id] = std::make_shared<std::map<usint, EvalKey<Element>>>(
+                *CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(id));
         }
-        Serial::Serialize(*smap, ser, sertype);
+        Serial::Serialize(omap, ser, sertype);
         return true;
     }
 
@@ -946,6 +946,76 @@ public:
     // TODO (dsuponit): move InsertEvalAutomorphismKey() to the private section of the class
     static void InsertEvalAutomorphismKey(const std::shared_ptr<std::map<usint, EvalKey<Element>>> evalKeyMap,
                                           const std::string& keyTag = "");
+
+    /**
+   * SerializeEvalEncapsulationKey for the sparse-secret encapsulation keys of a single secret key or of all
+   * secret keys (see EvalBootstrapKeyGen)
+   *
+   * @param ser - stream to serialize to
+   * @param sertype - type of serialization
+   * @param id for key to serialize - if empty std::string, serialize them all
+   * @return true on success
+   */
+    template <typename ST>
+    static bool SerializeEvalEncapsulationKey(std::ostream& ser, const ST& sertype, std::string id = "") {
+        const auto encapsulationKeys = CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.GetAll();
+        if (id.length() == 0) {
+            Serial::Serialize(encapsulationKeys, ser, sertype);
+        }
+        else {
+            const auto it = encapsulationKeys.find(id);
+            if (it == encapsulationKeys.end())
+                return false;  // no such id
+
+            std::map<std::string, std::vector<EvalKey<Element>>> omap{{it->first, it->second}};
+
+            Serial::Serialize(omap, ser, sertype);
+        }
+
+        return true;
+    }
+
+    /**
+   * DeserializeEvalEncapsulationKey deserialize all keys in the serialization
+   * deserialized keys silently replace any existing matching keys
+   *
+   * @param ser - stream to serialize from
+   * @param sertype - type of serialization
+   * @return true on success
+   */
+    template <typename ST>
+    static bool DeserializeEvalEncapsulationKey(std::istream& ser, const ST& sertype) {
+        std::map<std::string, std::vector<EvalKey<Element>>> keyMap;
+        Serial::Deserialize(keyMap, ser, sertype);
+        for (auto& [keyTag, keys] : keyMap)
+            CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Set(keyTag, std::move(keys));
+        return true;
+    }
+
+    /**
+   * ClearEvalEncapsulationKeys - flush the sparse-secret encapsulation key cache. ClearEvalAutomorphismKeys()
+   * clears it as well, as the keys are generated together by EvalBootstrapKeyGen
+   */
+    static void ClearEvalEncapsulationKeys();
+
+    /**
+   * ClearEvalEncapsulationKeys - flush the sparse-secret encapsulation key cache for a given id
+   * @param id
+   */
+    static void ClearEvalEncapsulationKeys(const std::string& id);
+
+    /**
+   * ClearEvalEncapsulationKeys - flush the sparse-secret encapsulation key cache for a given context
+   * @param cc
+   */
+    static void ClearEvalEncapsulationKeys(const CryptoContext<Element> cc);
+
+    /**
+   * InsertEvalEncapsulationKey - add the given vector of sparse-secret encapsulation keys to the map,
+   * replacing the existing vector if there
+   * @param evalKeyVec vector of keys
+   */
+    static void InsertEvalEncapsulationKey(const std::vector<EvalKey<Element>>& evalKeyVec);
     //------------------------------------------------------------------------------
     // TURN FEATURES ON
     //------------------------------------------------------------------------------
@@ -1053,35 +1123,60 @@ public:
     // KEYS GETTERS
     //------------------------------------------------------------------------------
 
+    // The key maps below are thread safe: keys can be generated, inserted and cleared while other
+    // threads use them. Getters return snapshots that are not affected by later changes: the maps
+    // for all tags and the key vectors are const copies, and the automorphism key map of one tag is
+    // shared with the key cache as a const map that stays valid for as long as it is held.
+    //
+    // NOTE: these getters used to return references into the key caches. The caches cannot be
+    // modified through the getters anymore; use InsertEvalMultKey(), InsertEvalAutomorphismKey(),
+    // InsertEvalSumKey() and the Clear*() methods instead. The copies are returned const so that
+    // code written against the old references fails to compile rather than modify a copy.
+
     /**
-   * Get a map of relinearization keys for all secret keys
+   * Get a snapshot of the relinearization keys for all secret keys
    */
-    static std::map<std::string, std::vector<EvalKey<Element>>>& GetAllEvalMultKeys();
+    static const std::map<std::string, std::vector<EvalKey<Element>>> GetAllEvalMultKeys();
 
     /**
    * Get relinearization keys for a specific secret key tag
    */
-    static const std::vector<EvalKey<Element>>& GetEvalMultKeyVector(const std::string& keyID);
+    static const std::vector<EvalKey<Element>> GetEvalMultKeyVector(const std::string& keyID);
 
     /**
-   * Get a map of automorphism keys for all secret keys
+   * Get a snapshot of the automorphism keys for all secret keys. The maps of the tags are shared with
+   * the key cache and must not be modified.
    */
-    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>& GetAllEvalAutomorphismKeys();
+    static const std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
+    GetAllEvalAutomorphismKeys();
     /**
-   * Get automorphism keys for a specific secret key tag
+   * Get automorphism keys for a specific secret key tag. The map is shared with the key cache; it
+   * stays valid for as long as it is held, even if the keys for keyID are changed meanwhile.
    */
-    static std::map<usint, EvalKey<Element>>& GetEvalAutomorphismKeyMap(const std::string& keyID) {
-        return *(CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID));
+    static std::shared_ptr<const std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMap(
+        const std::string& keyID) {
+        return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID);
     }
     /**
-   * Get a map of summation keys (each is composed of several automorphism keys) for all secret keys
+   * Same as GetEvalAutomorphismKeyMap()
    */
-    static std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>& GetAllEvalSumKeys();
+    static std::shared_ptr<const std::map<usint, EvalKey<Element>>> GetEvalAutomorphismKeyMapPtr(
+        const std::string& keyID);
+    /**
+   * Get a snapshot of the summation keys (each is composed of several automorphism keys) for all secret keys
+   */
+    static const std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>> GetAllEvalSumKeys();
 
     /**
-   * Get a map of summation keys (each is composed of several automorphism keys) for a specific secret key tag
+   * Get a map of summation keys (each is composed of several automorphism keys) for a specific secret key tag.
+   * It is held like the map returned by GetEvalAutomorphismKeyMap().
    */
-    static const std::map<usint, EvalKey<Element>>& GetEvalSumKeyMap(const std::string& id);
+    static std::shared_ptr<const std::map<usint, EvalKey<Element>>> GetEvalSumKeyMap(const std::string& id);
+
+    /**
+   * Get the sparse-secret encapsulation keys for a specific secret key tag (see EvalBootstrapKeyGen)
+   */
+    static const std::vector<EvalKey<Element>> GetEvalEncapsulationKeyVector(const std::string& keyID);
 
     //------------------------------------------------------------------------------
     // PLAINTEXT FACTORY METHODS
@@ -1341,6 +1436,23 @@ public:
         GetScheme()->KeySwitchInPlace(ciphertext, evalKey);
     }
 
+    /**
+   * KeySwitchBatchInPlace - key switches many ciphertexts with the same evaluation key.
+   * With hybrid key switching each block of the key is loaded once per batch instead of
+   * once per ciphertext, and the work is spread across ciphertexts and towers. Degree-2
+   * ciphertexts switched with the relinearization key are relinearized, as with
+   * KeySwitchInPlace.
+   * @param ciphertexts - ciphertexts to switch
+   * @param evalKey - evaluation key used for key switching
+   */
+    void KeySwitchBatchInPlace(std::vector<Ciphertext<Element>>& ciphertexts, const EvalKey<Element> evalKey) const {
+        for (const auto& ciphertext : ciphertexts)
+            ValidateCiphertext(ciphertext);
+        ValidateKey(evalKey);
+
+        GetScheme()->KeySwitchBatchInPlace(ciphertexts, evalKey);
+    }
+
     //------------------------------------------------------------------------------
     // SHE NEGATION Wrapper
     //------------------------------------------------------------------------------
@@ -2118,7 +2230,7 @@ public:
 
     /**
    * Rotates a ciphertext by an index (positive index is a left shift, negative index is a right shift).
-   * Uses a rotation key stored in a crypto context.
+   * Uses a rotation key stored in a crypto context; missing keys are composed as in EvalAtIndex.
    * Calls EvalAtIndex under the hood.
    * @param ciphertext input ciphertext
    * @param index rotation index
@@ -2127,8 +2239,8 @@ public:
     Ciphertext<Element> EvalRotate(ConstCiphertext<Element> ciphertext, int32_t index) const {
         ValidateCiphertext(ciphertext);
 
-        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-        return GetScheme()->EvalAtIndex(ciphertext, index, evalKeyMap);
+        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+        return GetScheme()->EvalAtIndex(ciphertext, index, *evalKeyMap);
     }
 
     /**
@@ -2216,9 +2328,37 @@ public:
    */
     Ciphertext<Element> EvalFastRotationExt(ConstCiphertext<Element> ciphertext, usint index,
                                             const std::shared_ptr<std::vector<Element>> digits, bool addFirst) const {
-        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
 
-        return GetScheme()->EvalFastRotationExt(ciphertext, index, digits, addFirst, evalKeyMap);
+        return GetScheme()->EvalFastRotationExt(ciphertext, index, digits, addFirst, *evalKeyMap);
+    }
+
+    /**
+   * Only supported for CKKS with hybrid key switching.
+   * Computes sum_i weights[i] * EvalRotate(ciphertext, indices[i]) as a hoisted
+   * rotate-and-accumulate: the digit decomposition of the ciphertext is computed
+   * once, all rotated products are accumulated in the extended CRT basis P*Q,
+   * and the sum is scaled down to Q by a single ModDown. This is cheaper than
+   * rotating, multiplying and adding each term separately, which costs one
+   * ModDown per index.
+   *
+   * Index 0 is allowed and needs no rotation key. A weight is used as is if it
+   * is already encoded in the extended basis of the ciphertext level (see
+   * CryptoParametersRNS::GetParamsQlP); otherwise it is re-encoded in that basis
+   * from its packed values.
+   *
+   * @param ciphertext input ciphertext
+   * @param indices the rotation indices
+   * @param weights the plaintext weights, one per rotation index
+   * @return resulting ciphertext
+   */
+    Ciphertext<Element> EvalRotateAndAccumulate(ConstCiphertext<Element> ciphertext,
+                                                const std::vector<int32_t>& indices,
+                                                const std::vector<ConstPlaintext>& weights) const {
+        ValidateCiphertext(ciphertext);
+
+        auto evalKeyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+        return GetScheme()->EvalRotateAndAccumulate(ciphertext, indices, weights, *evalKeyMap);
     }
 
     /**
@@ -2266,6 +2406,21 @@ public:
     void EvalAtIndexKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList,
                            const PublicKey<Element> publicKey = nullptr);
 
+    /**
+   * EvalAtIndexBaseKeyGen generates a logarithmic base set of rotation keys (all
+   * powers of two and the conjugation key) instead of one key per index.
+   * Rotations without a dedicated key are composed from the base set at
+   * evaluation time, at the cost of one extra key switching per additional power
+   * of two. Within memoryBudget, dedicated keys are added for the indices from
+   * indexList that are the most expensive to compose.
+   *
+   * @param privateKey private key.
+   * @param indexList list of indices the application will rotate by.
+   * @param memoryBudget memory budget for all rotation keys, in bytes; the base set is always generated.
+   */
+    void EvalAtIndexBaseKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList,
+                               uint64_t memoryBudget = 0);
+
     // [[deprecated(
     //     "Use EvalAtIndexKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList) instead.")]] void
     // EvalAtIndexKeyGen(const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList,
@@ -2297,7 +2452,10 @@ public:
     // }
     /**
    * Rotates a ciphertext by an index (positive index is a left shift, negative index is a right shift).
-   * Uses a rotation key stored in a crypto context.
+   * Uses a rotation key stored in a crypto context. If there is no key for the index, the rotation is
+   * composed from the stored keys (e.g., the base set from EvalAtIndexBaseKeyGen) at the cost of one
+   * key switching per part, so a missing key is no longer reported as long as a composition exists.
+   * Throws only if the stored keys cannot compose the rotation.
    * @param ciphertext input ciphertext
    * @param index rotation index
    * @return a rotated ciphertext
@@ -3283,6 +3441,7 @@ public:
    * decoding and stores the necessary parameters
    * 2. EvalBootstrapKeyGen: computes and stores the keys for rotations and conjugation
    * 3. EvalBootstrapPrecompute: computes and stores the plaintexts for encoding and decoding if not already done in EvalBootstrapSetup
+   *    (or LoadBootstrapPrecomputation: loads the plaintexts stored by SaveBootstrapPrecomputation instead of steps 1 and 3)
    * 4. EvalBootstrap: refreshes the given ciphertext
    */
 
@@ -3296,10 +3455,15 @@ public:
    * @param slots - number of slots to be bootstrapped
    * @param correctionFactor - value to internally rescale message by to improve precision of bootstrapping. If set to 0, we use the default logic. This value is only used when NATIVE_SIZE=64
    * @param precompute - flag specifying whether to precompute the plaintexts for encoding and decoding.
+   * @param lazyEncoding - flag specifying whether to keep only the (much smaller) diagonals of the FFT-like
+   * encoding and decoding. Every level is then encoded into plaintexts right before it is evaluated, on a
+   * worker thread while the previous level is evaluated, trading some CPU time for memory. Ignored when
+   * both level budgets are 1.
    */
     void EvalBootstrapSetup(std::vector<uint32_t> levelBudget = {5, 4}, std::vector<uint32_t> dim1 = {0, 0},
-                            uint32_t slots = 0, uint32_t correctionFactor = 0, bool precompute = true) {
-        GetScheme()->EvalBootstrapSetup(*this, levelBudget, dim1, slots, correctionFactor, precompute);
+                            uint32_t slots = 0, uint32_t correctionFactor = 0, bool precompute = true,
+                            bool lazyEncoding = false) {
+        GetScheme()->EvalBootstrapSetup(*this, levelBudget, dim1, slots, correctionFactor, precompute, lazyEncoding);
     }
     /**
    * Generates all automorphism keys for EvalBootstrap. Supported in CKKS only.
@@ -3307,21 +3471,56 @@ public:
    *
    * @param privateKey private key.
    * @param slots number of slots to support permutations on
-   */
-    void EvalBootstrapKeyGen(const PrivateKey<Element> privateKey, uint32_t slots) {
+   * @param memoryBudget if nonzero, only the base set of rotation keys plus the dedicated keys that fit
+   * into this many bytes are generated, and the remaining rotations are composed during bootstrapping
+   * (see EvalAtIndexBaseKeyGen). 0 generates a dedicated key for every rotation.
+   * For SPARSE_ENCAPSULATED secrets, the keys switching to and from an ephemeral sparse secret used for the
+   * modulus raising are generated as well. They are kept apart from the automorphism keys (see
+   * GetEvalEncapsulationKeyVector and SerializeEvalEncapsulationKey).
+   */
+    void EvalBootstrapKeyGen(const PrivateKey<Element> privateKey, uint32_t slots, uint64_t memoryBudget = 0) {
         ValidateKey(privateKey);
 
-        auto evalKeys = GetScheme()->EvalBootstrapKeyGen(privateKey, slots);
+        auto evalKeys = GetScheme()->EvalBootstrapKeyGen(privateKey, slots, memoryBudget);
 
         CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+
+        auto encapsulationKeys = GetScheme()->EvalEncapsulationKeyGen(privateKey);
+        if (!encapsulationKeys.empty())
+            CryptoContextImpl<Element>::InsertEvalEncapsulationKey(encapsulationKeys);
     }
     /**
    * Computes the plaintexts for encoding and decoding for both linear and FFT-like methods. Supported in CKKS only.
    *
    * @param slots - number of slots to be bootstrapped
+   * @param lazyEncoding - flag specifying whether to keep only the diagonals of the FFT-like encoding and
+   * decoding (see EvalBootstrapSetup)
+   */
+    void EvalBootstrapPrecompute(uint32_t slots = 0, bool lazyEncoding = false) {
+        GetScheme()->EvalBootstrapPrecompute(*this, slots, lazyEncoding);
+    }
+    /**
+   * Writes the plaintexts for encoding and decoding computed by EvalBootstrapSetup or
+   * EvalBootstrapPrecompute to a file, together with the parameters they were computed for.
+   * Precomputations with lazy encoding are not written. Supported in CKKS only.
+   *
+   * @param filename - the file to write
+   * @param slots - number of slots whose precomputations are written; all precomputed slot counts if 0
+   */
+    void SaveBootstrapPrecomputation(const std::string& filename, uint32_t slots = 0) const {
+        GetScheme()->SaveBootstrapPrecomputation(*this, filename, slots);
+    }
+    /**
+   * Loads a file written by SaveBootstrapPrecomputation in place of calling EvalBootstrapSetup and
+   * EvalBootstrapPrecompute. The file is memory-mapped and its plaintexts are used in place, so
+   * loading costs little more than parsing the description, and processes loading the same file
+   * share one copy of the plaintexts. Throws if the file was written for different parameters.
+   * Supported in CKKS only.
+   *
+   * @param filename - the file to load
    */
-    void EvalBootstrapPrecompute(uint32_t slots = 0) {
-        GetScheme()->EvalBootstrapPrecompute(*this, slots);
+    void LoadBootstrapPrecomputation(const std::string& filename) {
+        GetScheme()->LoadBootstrapPrecomputation(*this, filename);
     }
     /**
    * Defines the bootstrapping evaluation of ciphertext using either the
@@ -3338,6 +3537,24 @@ public:
         return GetScheme()->EvalBootstrap(ciphertext, numIterations, precision);
     }
 
+    /**
+   * Bootstraps many ciphertexts at once. The ciphertexts must have the same number of slots, key tag
+   * and level. The key switchings that use the same key for all ciphertexts are batched, and when
+   * there are more threads than towers the ciphertexts are bootstrapped in parallel.
+   *
+   * @param ciphertexts the input ciphertexts.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm (see EvalBootstrap).
+   * @return the refreshed ciphertexts, in the order of the input.
+   */
+    std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                        uint32_t numIterations = 1, uint32_t precision = 0) const {
+        for (const auto& ciphertext : ciphertexts)
+            ValidateCiphertext(ciphertext);
+
+        return GetScheme()->EvalBootstrapBatch(ciphertexts, numIterations, precision);
+    }
+
     //------------------------------------------------------------------------------
     // Scheme switching Methods
     //------------------------------------------------------------------------------
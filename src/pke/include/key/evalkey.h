@@ -224,6 +224,46 @@ public:
         OPENFHE_THROW("GetAinDCRT operation not supported");
     }
 
+    /**
+   * Keeps a copy of vectors A and B in Montgomery form (see NativeVectorT::ToMontgomeryEq()),
+   * which key switching multiplies with instead of the standard form.
+   * Throws exception, to be overridden by derived class.
+   */
+
+    virtual void EnableMontgomeryForm() {
+        OPENFHE_THROW("EnableMontgomeryForm operation not supported");
+    }
+
+    /**
+   * @return true if EnableMontgomeryForm() was called and the copy is current.
+   */
+
+    virtual bool HasMontgomeryForm() const {
+        return false;
+    }
+
+    /**
+   * Getter function to access Element Vector A in Montgomery form.
+   * Throws exception, to be overridden by derived class.
+   *
+   * @return  Element vector A in Montgomery form.
+   */
+
+    virtual const std::vector<Element>& GetMontgomeryAVector() const {
+        OPENFHE_THROW("GetMontgomeryAVector operation not supported");
+    }
+
+    /**
+   * Getter function to access Element Vector B in Montgomery form.
+   * Throws exception, to be overridden by derived class.
+   *
+   * @return  Element vector B in Montgomery form.
+   */
+
+    virtual const std::vector<Element>& GetMontgomeryBVector() const {
+        OPENFHE_THROW("GetMontgomeryBVector operation not supported");
+    }
+
     virtual void ClearKeys() {
         OPENFHE_THROW("ClearKeys operation is not supported");
     }
@@ -0,0 +1,196 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYREGISTRY_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYREGISTRY_H
+
+#include <array>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief Thread-safe registry of evaluation keys by secret key tag.
+ *
+ * The tags are spread over shards by their hash. Each shard publishes an immutable snapshot of
+ * its map (read-copy-update): a reader takes the current snapshot with one atomic shared_ptr
+ * load, while a writer copies the map of the shard under the lock of the shard, modifies the
+ * copy and publishes it with one atomic shared_ptr store. Readers do not take the lock of the
+ * shard, so they never wait for a writer to copy a map; the atomic shared_ptr operations are not
+ * lock-free though (libstdc++ guards them with a small pool of internal mutexes shared by the
+ * process), so a reader may briefly wait for another atomic load or store of a pointer. Values
+ * handed out to readers stay valid for as long as the readers hold them, even if their tag is replaced or erased in the meantime, so
+ * the values must not be modified once they are registered.
+ *
+ * @tparam Value the value type, cheap to copy (a vector of keys or a shared_ptr to a key map)
+ */
+template <typename Value>
+class EvalKeyRegistry {
+public:
+    using MapType = std::map<std::string, Value>;
+
+    EvalKeyRegistry() {
+        for (auto& shard : m_shards)
+            shard.map = std::make_shared<const MapType>();
+    }
+
+    EvalKeyRegistry(const EvalKeyRegistry&)            = delete;
+    EvalKeyRegistry& operator=(const EvalKeyRegistry&) = delete;
+
+    /**
+     * @brief Looks up the value for a tag without taking the lock of its shard.
+     * @return true if the tag is registered; its value is then copied to value
+     */
+    bool Find(const std::string& keyTag, Value& value) const {
+        auto map = Snapshot(GetShard(keyTag));
+        auto it  = map->find(keyTag);
+        if (it == map->end())
+            return false;
+        value = it->second;
+        return true;
+    }
+
+    bool Contains(const std::string& keyTag) const {
+        return Snapshot(GetShard(keyTag))->count(keyTag) != 0;
+    }
+
+    /**
+     * @brief Registers a value for a tag unless the tag is already registered.
+     * @return true if the value was registered
+     */
+    bool Insert(const std::string& keyTag, Value value) {
+        bool inserted{false};
+        Modify(GetShard(keyTag), [&](MapType& map) { inserted = map.emplace(keyTag, std::move(value)).second; });
+        return inserted;
+    }
+
+    /**
+     * @brief Registers a value for a tag, replacing the registered one.
+     */
+    void Set(const std::string& keyTag, Value value) {
+        Modify(GetShard(keyTag), [&](MapType& map) { map[keyTag] = std::move(value); });
+    }
+
+    /**
+     * @brief Replaces the value for a tag by update(current), where current points to the
+     * registered value or is nullptr. Updates of the tags of one shard are serialized, so none
+     * of them is lost; update must not access the registry.
+     */
+    template <typename F>
+    void Update(const std::string& keyTag, F&& update) {
+        Modify(GetShard(keyTag), [&](MapType& map) {
+            auto it     = map.find(keyTag);
+            Value value = update(it == map.end() ? nullptr : &it->second);
+            map[keyTag] = std::move(value);
+        });
+    }
+
+    void Erase(const std::string& keyTag) {
+        Modify(GetShard(keyTag), [&](MapType& map) { map.erase(keyTag); });
+    }
+
+    /**
+     * @brief Erases all tags for which pred(tag, value) is true.
+     */
+    template <typename Pred>
+    void EraseIf(Pred&& pred) {
+        for (auto& shard : m_shards) {
+            Modify(shard, [&](MapType& map) {
+                for (auto it = map.begin(); it != map.end();) {
+                    if (pred(it->first, it->second))
+                        it = map.erase(it);
+                    else
+                        ++it;
+                }
+            });
+        }
+    }
+
+    void Clear() {
+        for (auto& shard : m_shards)
+            Modify(shard, [](MapType& map) { map.clear(); });
+    }
+
+    /**
+     * @brief Returns a copy of all registered tags and values. Each shard is read atomically, but
+     * a concurrent writer may be seen in some shards and not in others.
+     */
+    MapType GetAll() const {
+        MapType all;
+        for (const auto& shard : m_shards) {
+            auto map = Snapshot(shard);
+            all.insert(map->begin(), map->end());
+        }
+        return all;
+    }
+
+private:
+    static constexpr size_t SHARD_COUNT{16};
+
+    struct Shard {
+        std::mutex writeMutex;
+        std::shared_ptr<const MapType> map;
+    };
+
+    Shard& GetShard(const std::string& keyTag) {
+        return m_shards[std::hash<std::string>{}(keyTag) % SHARD_COUNT];
+    }
+
+    const Shard& GetShard(const std::string& keyTag) const {
+        return m_shards[std::hash<std::string>{}(keyTag) % SHARD_COUNT];
+    }
+
+    static std::shared_ptr<const MapType> Snapshot(const Shard& shard) {
+        return std::atomic_load(&shard.map);
+    }
+
+    template <typename F>
+    static void Modify(Shard& shard, F&& modify) {
+        std::lock_guard<std::mutex> lock(shard.writeMutex);
+        auto map = std::make_shared<MapType>(*Snapshot(shard));
+        modify(*map);
+        std::atomic_store(&shard.map, std::shared_ptr<const MapType>(std::move(map)));
+    }
+
+    std::array<Shard, SHARD_COUNT> m_shards;
+};
+
+}  // namespace lbcrypto
+
+#endif
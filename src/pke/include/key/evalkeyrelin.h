@@ -34,8 +34,13 @@
 
 #include "key/evalkeyrelin-fwd.h"
 #include "key/evalkey.h"
+#include "math/distributiongenerator.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <vector>
 #include <string>
 #include <utility>
@@ -49,6 +54,9 @@
  */
 namespace lbcrypto {
 
+// number of 32-bit words in the seed of a compressed evaluation key (256 bits)
+constexpr uint32_t EVAL_KEY_SEED_SIZE{8};
+
 /**
  * @brief Concrete class for Relinearization keys of RLWE scheme
  * @tparam Element a ring element.
@@ -71,7 +79,7 @@ public:
    *@param &rhs key to copy from
    */
     explicit EvalKeyRelinImpl(const EvalKeyRelinImpl<Element>& rhs)
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(rhs.m_rKey) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(rhs.m_rKey), m_seed(rhs.m_seed) {}
 
     /**
    * Move constructor
@@ -79,7 +87,7 @@ public:
    *@param &rhs key to move from
    */
     explicit EvalKeyRelinImpl(EvalKeyRelinImpl<Element>&& rhs) noexcept
-        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(std::move(rhs.m_rKey)) {}
+        : EvalKeyImpl<Element>(rhs.GetCryptoContext()), m_rKey(std::move(rhs.m_rKey)), m_seed(std::move(rhs.m_seed)) {}
 
     operator bool() const {
         return static_cast<bool>(this->context) && m_rKey.size() != 0;
@@ -93,6 +101,9 @@ public:
     EvalKeyRelinImpl<Element>& operator=(const EvalKeyRelinImpl<Element>& rhs) {
         this->context = rhs.context;
         this->m_rKey  = rhs.m_rKey;
+        this->m_seed  = rhs.m_seed;
+        m_expanded.store(false, std::memory_order_relaxed);
+        ResetMontgomeryForm();
         return *this;
     }
 
@@ -105,6 +116,9 @@ public:
         this->context = rhs.context;
         rhs.context   = 0;
         m_rKey        = std::move(rhs.m_rKey);
+        m_seed        = std::move(rhs.m_seed);
+        m_expanded.store(false, std::memory_order_relaxed);
+        ResetMontgomeryForm();
         return *this;
     }
 
@@ -116,6 +130,8 @@ public:
    */
     virtual void SetAVector(const std::vector<Element>& a) {
         m_rKey.insert(m_rKey.begin() + 0, a);
+        m_seed.clear();
+        ResetMontgomeryForm();
     }
 
     /**
@@ -126,18 +142,91 @@ public:
    */
     virtual void SetAVector(std::vector<Element>&& a) {
         m_rKey.insert(m_rKey.begin() + 0, std::move(a));
+        m_seed.clear();
+        ResetMontgomeryForm();
     }
 
     /**
    * Getter function to access Relinearization Element Vector A.
    * Overrides base class implementation.
    *
+   * For a compressed key loaded without A, the vector is regenerated from the
+   * seed on first access and cached.
+   *
    * @return Element vector A.
    */
     virtual const std::vector<Element>& GetAVector() const {
+        if (!m_seed.empty() && !m_expanded.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(m_expandMutex);
+            if (m_rKey.at(0).empty())
+                m_rKey[0] = ExpandAVector(m_seed, m_rKey.at(1).at(0).GetParams(), m_rKey[1].size());
+            m_expanded.store(true, std::memory_order_release);
+        }
         return m_rKey.at(0);
     }
 
+    /**
+   * Marks the key as compressed: vector A must have been generated by
+   * ExpandAVector(seed, ...), so only the seed is serialized in its place.
+   * Call after SetAVector/SetBVector.
+   *
+   * @param &seed the EVAL_KEY_SEED_SIZE words vector A was expanded from.
+   */
+    void SetASeed(const std::vector<uint32_t>& seed) {
+        m_seed = seed;
+    }
+
+    /**
+   * @return the seed of vector A; empty if the key is not compressed.
+   */
+    const std::vector<uint32_t>& GetASeed() const {
+        return m_seed;
+    }
+
+    /**
+   * Draws a fresh seed for a compressed key from the thread-local PRNG.
+   */
+    static std::vector<uint32_t> GenerateASeed() {
+        std::vector<uint32_t> seed(EVAL_KEY_SEED_SIZE);
+        for (auto& word : seed)
+            word = PseudoRandomNumberGenerator::GetPRNG()();
+        return seed;
+    }
+
+    /**
+   * Deterministically expands a seed into numParts uniformly random elements
+   * in the evaluation representation. The BLAKE2 engine is keyed with the
+   * seed and its output is turned into residues by rejection sampling, tower
+   * by tower, so the same seed yields the same vector A on every platform.
+   *
+   * @param &seed the EVAL_KEY_SEED_SIZE words to expand.
+   * @param &params the parameters of the elements (Q*P for hybrid keys).
+   * @param numParts the number of elements to generate.
+   * @return the expanded vector A.
+   */
+    static std::vector<Element> ExpandAVector(const std::vector<uint32_t>& seed,
+                                              const std::shared_ptr<typename Element::Params>& params,
+                                              size_t numParts) {
+        std::array<uint32_t, 16> key{};
+        std::copy(seed.begin(), seed.end(), key.begin());
+
+        PRNG prng(key);
+
+        const auto& towers = params->GetParams();
+        const uint32_t n   = params->GetRingDimension();
+
+        std::vector<Element> a;
+        a.reserve(numParts);
+        for (size_t part = 0; part < numParts; ++part) {
+            Element element(params, Format::EVALUATION, true);
+            for (size_t i = 0; i < towers.size(); ++i)
+                element.GetAllElements()[i].SetValues(SampleUniform(prng, towers[i]->GetModulus(), n),
+                                                      Format::EVALUATION);
+            a.push_back(std::move(element));
+        }
+        return a;
+    }
+
     /**
    * Setter function to store Relinearization Element Vector B.
    * Overrides base class implementation.
@@ -146,6 +235,7 @@ public:
    */
     virtual void SetBVector(const std::vector<Element>& b) {
         m_rKey.insert(m_rKey.begin() + 1, b);
+        ResetMontgomeryForm();
     }
 
     /**
@@ -156,6 +246,7 @@ public:
    */
     virtual void SetBVector(std::vector<Element>&& b) {
         m_rKey.insert(m_rKey.begin() + 1, std::move(b));
+        ResetMontgomeryForm();
     }
 
     /**
@@ -168,6 +259,53 @@ public:
         return m_rKey.at(1);
     }
 
+    /**
+   * Keeps a copy of vectors A and B in Montgomery form, which the hybrid key switching
+   * multiplies the digits with instead of using Barrett reductions. The copy doubles the
+   * memory of the key; it is neither serialized nor copied with the key and is dropped
+   * when the key is modified. Requires moduli below 2^(w - 1) for a native word of w bits.
+   */
+    virtual void EnableMontgomeryForm() {
+        if (m_montgomery.load(std::memory_order_acquire))
+            return;
+        std::lock_guard<std::mutex> lock(m_montgomeryMutex);
+        if (m_montgomery.load(std::memory_order_relaxed))
+            return;
+        std::vector<std::vector<Element>> montgomery{GetAVector(), GetBVector()};
+        for (auto& part : montgomery) {
+            for (auto& element : part)
+                element.ToMontgomeryEq();
+        }
+        m_rKeyMontgomery = std::move(montgomery);
+        m_montgomery.store(true, std::memory_order_release);
+    }
+
+    virtual bool HasMontgomeryForm() const {
+        return m_montgomery.load(std::memory_order_acquire);
+    }
+
+    /**
+   * Getter function to access vector A in Montgomery form; see EnableMontgomeryForm().
+   *
+   * @return Element vector A in Montgomery form.
+   */
+    virtual const std::vector<Element>& GetMontgomeryAVector() const {
+        if (!HasMontgomeryForm())
+            OPENFHE_THROW("Call EnableMontgomeryForm() before accessing the Montgomery form of the key");
+        return m_rKeyMontgomery[0];
+    }
+
+    /**
+   * Getter function to access vector B in Montgomery form; see EnableMontgomeryForm().
+   *
+   * @return Element vector B in Montgomery form.
+   */
+    virtual const std::vector<Element>& GetMontgomeryBVector() const {
+        if (!HasMontgomeryForm())
+            OPENFHE_THROW("Call EnableMontgomeryForm() before accessing the Montgomery form of the key");
+        return m_rKeyMontgomery[1];
+    }
+
     /**
    * Setter function to store key switch Element.
    * Throws exception, to be overridden by derived class.
@@ -235,6 +373,8 @@ public:
     virtual void ClearKeys() {
         m_rKey.clear();
         m_dcrtKeys.clear();
+        m_seed.clear();
+        ResetMontgomeryForm();
     }
 
     bool key_compare(const EvalKeyImpl<Element>& other) const {
@@ -245,6 +385,11 @@ public:
 
         if (this->m_rKey.size() != oth.m_rKey.size())
             return false;
+        // expand vector A of compressed keys before comparing
+        if (!this->m_seed.empty())
+            this->GetAVector();
+        if (!oth.m_seed.empty())
+            oth.GetAVector();
         for (size_t i = 0; i < this->m_rKey.size(); i++) {
             if (this->m_rKey[i].size() != oth.m_rKey[i].size())
                 return false;
@@ -259,7 +404,14 @@ public:
     template <class Archive>
     void save(Archive& ar, std::uint32_t const version) const {
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        ar(::cereal::make_nvp("s", m_seed));
+        if (m_seed.empty()) {
+            ar(::cereal::make_nvp("k", m_rKey));
+        }
+        else {
+            // vector A is replaced by its seed and regenerated on first use after loading
+            ar(::cereal::make_nvp("k", m_rKey.at(1)));
+        }
     }
 
     template <class Archive>
@@ -269,18 +421,72 @@ public:
                           " is from a later version of the library");
         }
         ar(::cereal::base_class<EvalKeyImpl<Element>>(this));
-        ar(::cereal::make_nvp("k", m_rKey));
+        if (version < 2) {
+            ar(::cereal::make_nvp("k", m_rKey));
+            return;
+        }
+        ar(::cereal::make_nvp("s", m_seed));
+        if (m_seed.empty()) {
+            ar(::cereal::make_nvp("k", m_rKey));
+        }
+        else {
+            std::vector<Element> b;
+            ar(::cereal::make_nvp("k", b));
+            m_rKey.clear();
+            m_rKey.emplace_back();
+            m_rKey.push_back(std::move(b));
+            m_expanded.store(false, std::memory_order_relaxed);
+        }
     }
     std::string SerializedObjectName() const {
         return "EvalKeyRelin";
     }
     static uint32_t SerializedVersion() {
-        return 1;
+        return 2;
     }
 
 private:
+    void ResetMontgomeryForm() {
+        m_montgomery.store(false, std::memory_order_relaxed);
+        m_rKeyMontgomery.clear();
+    }
+
+    // n residues uniform mod q: the bit length of q is read from the stream and values >= q are rejected.
+    // Unlike std::uniform_int_distribution, whose algorithm is implementation-defined, this depends only
+    // on the output of the engine.
+    static NativeVector SampleUniform(PRNG& prng, const NativeInteger& q, uint32_t n) {
+        const uint32_t bits     = q.GetMSB();
+        const uint32_t words    = (bits + 31) / 32;
+        const BasicInteger max  = q.ConvertToInt<BasicInteger>();
+        const BasicInteger mask = (bits % 32 == 0) ? ~BasicInteger(0) : (BasicInteger(1) << bits) - 1;
+
+        NativeVector values(n, q);
+        for (uint32_t i = 0; i < n;) {
+            BasicInteger x = prng();
+            for (uint32_t w = 1; w < words; ++w)
+                x = (x << 32) | prng();
+            x &= mask;
+            if (x < max)
+                values[i++] = NativeInteger(x);
+        }
+        return values;
+    }
+
     // private member to store vector of vector of Element.
-    std::vector<std::vector<Element>> m_rKey;
+    // mutable so that vector A of a compressed key can be expanded lazily
+    mutable std::vector<std::vector<Element>> m_rKey;
+
+    // seed of vector A for compressed keys; empty otherwise
+    std::vector<uint32_t> m_seed;
+
+    // serializes the lazy expansion of vector A; once it is set, vector A is read without locking
+    mutable std::mutex m_expandMutex;
+    mutable std::atomic<bool> m_expanded{false};
+
+    // vectors A and B in Montgomery form once EnableMontgomeryForm() was called
+    std::vector<std::vector<Element>> m_rKeyMontgomery;
+    std::mutex m_montgomeryMutex;
+    std::atomic<bool> m_montgomery{false};
 
     // Used for hybrid key switching
     std::vector<DCRTPoly> m_dcrtKeys;
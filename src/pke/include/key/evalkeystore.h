@@ -0,0 +1,83 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+#include "cryptocontext.h"
+
+#ifndef LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+#define LBCRYPTO_CRYPTO_KEY_EVALKEYSTORE_H
+
+#include "cryptocontext.h"
+
+#include <string>
+
+/**
+ * @namespace lbcrypto
+ * The namespace of lbcrypto
+ */
+namespace lbcrypto {
+
+/**
+ * @brief Binary store of evaluation keys that is memory-mapped copy-on-write and used in place.
+ *
+ * A store holds a cereal description of the EvalMult and EvalAutomorphism key maps with the
+ * polynomial values left out, followed by the raw tower values of every key polynomial laid out
+ * as DCRTPoly::MakeContiguous() lays them out in memory. Loading a store maps the file and makes
+ * each key polynomial a view of its slice of the mapping, so nothing but the description is
+ * parsed or copied and all processes loading the same store share one page-cache copy of the
+ * keys. The mapping is released when the last loaded key is destroyed.
+ *
+ * Values are stored in the native byte order and integer width, so a store can only be loaded
+ * by a build with the same native integer size on a machine with the same byte order. Loaded
+ * keys can be modified in place: the pages written are copied privately and the store is unchanged.
+ */
+class EvalKeyStore {
+public:
+    /**
+     * @brief Writes the EvalMult and EvalAutomorphism (including EvalSum) keys to a store.
+     * Compressed keys are written with their expanded "a" parts so that they can be used in place.
+     *
+     * @param filename the file to write
+     * @param keyTag the secret key tag whose keys are written; all keys if empty
+     */
+    static void Write(const std::string& filename, const std::string& keyTag = "");
+
+    /**
+     * @brief Maps a store and puts its keys into the key maps of CryptoContextImpl,
+     * replacing the existing keys for the same key tags. Crypto contexts are created as needed,
+     * as with the cereal deserialization of keys.
+     *
+     * @param filename the file to load
+     */
+    static void Load(const std::string& filename);
+};
+
+}  // namespace lbcrypto
+
+#endif
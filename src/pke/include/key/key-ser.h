@@ -45,4 +45,8 @@ CEREAL_REGISTER_TYPE(lbcrypto::EvalKeyRelinImpl<lbcrypto::DCRTPoly>);
 CEREAL_REGISTER_POLYMORPHIC_RELATION(lbcrypto::EvalKeyImpl<lbcrypto::DCRTPoly>,
                                      lbcrypto::EvalKeyRelinImpl<lbcrypto::DCRTPoly>);
 
+// the version selects the layout with the seed of a compressed key; without it every key is loaded as version 0
+CEREAL_CLASS_VERSION(lbcrypto::EvalKeyRelinImpl<lbcrypto::DCRTPoly>,
+                     lbcrypto::EvalKeyRelinImpl<lbcrypto::DCRTPoly>::SerializedVersion());
+
 #endif
@@ -96,6 +96,19 @@ public:
         OPENFHE_THROW("KeySwitch is not supported");
     }
 
+    /**
+   * Key switches several ciphertexts with the same key. The default
+   * implementation switches them one at a time.
+   *
+   * @param ciphertexts the ciphertexts to switch in place
+   * @param evalKey the evaluation key shared by all ciphertexts
+   */
+    virtual void KeySwitchBatchInPlace(std::vector<Ciphertext<Element>>& ciphertexts,
+                                       const EvalKey<Element> evalKey) const {
+        for (auto& ciphertext : ciphertexts)
+            KeySwitchInPlace(ciphertext, evalKey);
+    }
+
     virtual Ciphertext<Element> KeySwitchExt(ConstCiphertext<Element> ciphertext, bool addFirst) const {
         OPENFHE_THROW("KeySwitchExt is not supported");
     }
@@ -132,6 +145,25 @@ public:
         const std::shared_ptr<ParmType> paramsQl) const {
         OPENFHE_THROW("EvalFastKeySwitchCoreExt is not supported");
     }
+
+    /**
+   * Inner products of the digits of several ciphertexts with the same key, in the
+   * extended basis. The default implementation computes them one at a time.
+   *
+   * @param digits the digits of every ciphertext, all at the level of paramsQl
+   * @param evalKey the evaluation key shared by all ciphertexts
+   * @param paramsQl the parameters of the ciphertexts
+   * @return the two extended elements of every ciphertext
+   */
+    virtual std::vector<std::shared_ptr<std::vector<Element>>> EvalFastKeySwitchCoreExtBatch(
+        const std::vector<std::shared_ptr<std::vector<Element>>>& digits, const EvalKey<Element> evalKey,
+        const std::shared_ptr<ParmType> paramsQl) const {
+        std::vector<std::shared_ptr<std::vector<Element>>> result;
+        result.reserve(digits.size());
+        for (const auto& d : digits)
+            result.push_back(EvalFastKeySwitchCoreExt(d, evalKey, paramsQl));
+        return result;
+    }
 };
 
 }  // namespace lbcrypto
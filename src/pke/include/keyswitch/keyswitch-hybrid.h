@@ -45,6 +45,7 @@
 #include "keyswitch/keyswitch-rns.h"
 #include "schemebase/rlwe-cryptoparameters.h"
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <memory>
@@ -55,6 +56,19 @@
  */
 namespace lbcrypto {
 
+/**
+ * @brief Instrumentation counters of the hybrid key switching ModUp (digit decomposition and
+ * basis extension); the number of NTTs per key switch is (inverseNTTs + forwardNTTs) / modUps
+ */
+struct KeySwitchStats {
+    // calls to EvalKeySwitchPrecomputeCore
+    uint64_t modUps{0};
+    // towers transformed to the coefficient domain
+    uint64_t inverseNTTs{0};
+    // towers transformed to the evaluation domain
+    uint64_t forwardNTTs{0};
+};
+
 /**
  * @brief Hybrid Keyswitching as described in [
     Homomorphic Evaluation of the AES Circuit(GHS
@@ -84,6 +98,18 @@ public:
 
     void KeySwitchInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly> evalKey) const override;
 
+    /**
+   * Key switches a batch of ciphertexts with the same key. The ModUp and ModDown of
+   * every ciphertext run in parallel across the batch, and the inner product with the
+   * key is tiled over (tower, block of coefficients) so that each block of the key is
+   * loaded once and applied to all ciphertexts of the batch while it is in cache.
+   *
+   * @param ciphertexts the ciphertexts to switch in place; they may be at different levels
+   * @param evalKey the evaluation key shared by all ciphertexts
+   */
+    void KeySwitchBatchInPlace(std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                               const EvalKey<DCRTPoly> evalKey) const override;
+
     Ciphertext<DCRTPoly> KeySwitchExt(ConstCiphertext<DCRTPoly> ciphertext, bool addFirst) const override;
 
     Ciphertext<DCRTPoly> KeySwitchDown(ConstCiphertext<DCRTPoly> ciphertext) const override;
@@ -108,6 +134,23 @@ public:
         const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
         const std::shared_ptr<ParmType> paramsQl) const override;
 
+    /**
+   * Batched inner products with the key, tiled over (tower, block of coefficients) so
+   * that each block of the key is loaded once and applied to all ciphertexts of the
+   * batch while it is in cache.
+   */
+    std::vector<std::shared_ptr<std::vector<DCRTPoly>>> EvalFastKeySwitchCoreExtBatch(
+        const std::vector<std::shared_ptr<std::vector<DCRTPoly>>>& digits, const EvalKey<DCRTPoly> evalKey,
+        const std::shared_ptr<ParmType> paramsQl) const override;
+
+    /////////////////////////////////////////
+    // INSTRUMENTATION
+    /////////////////////////////////////////
+
+    // counters of the ModUps run by the calling thread
+    static KeySwitchStats GetThreadStats();
+    static void ResetThreadStats();
+
     /////////////////////////////////////////
     // SERIALIZATION
     /////////////////////////////////////////
@@ -125,6 +168,14 @@ public:
     std::string SerializedObjectName() const override {
         return "KeySwitchHYBRID";
     }
+
+private:
+    // batched key switching of ciphertexts that all have sizeQl towers
+    void KeySwitchBatchLevelInPlace(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                    const EvalKey<DCRTPoly> evalKey, size_t sizeQl) const;
+
+    // number of coefficients per block of the batched inner product with the key
+    static constexpr uint32_t KEYSWITCH_BATCH_BLOCK_SIZE{1 << 9};
 };
 
 }  // namespace lbcrypto
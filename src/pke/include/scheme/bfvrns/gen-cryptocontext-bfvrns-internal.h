@@ -84,6 +84,7 @@ typename ContextGeneratorType::ContextType genCryptoContextBFVRNSInternal(
 
     // for BFV scheme noise scale is always set to 1
     params->SetNoiseScale(1);
+    params->SetCompressEvalKeys(parameters.GetCompressEvalKeys());
 
     auto scheme = std::make_shared<typename ContextGeneratorType::PublicKeyEncryptionScheme>();
     scheme->SetKeySwitchingTechnique(parameters.GetKeySwitchTechnique());
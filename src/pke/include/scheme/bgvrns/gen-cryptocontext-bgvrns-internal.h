@@ -83,6 +83,7 @@ typename ContextGeneratorType::ContextType genCryptoContextBGVRNSInternal(
 
     // for BGV scheme noise scale is always set to plaintext modulus
     params->SetNoiseScale(parameters.GetPlaintextModulus());
+    params->SetCompressEvalKeys(parameters.GetCompressEvalKeys());
 
     auto numLargeDigits = (parameters.GetMultiplicativeDepth() == 0) ?
                               ComputeNumLargeDigitsPRE(parameters.GetNumLargeDigits(), parameters.GetPRENumHops()) :
@@ -39,6 +39,8 @@
 #include "utils/caller_info.h"
 #include "math/hal/basicint.h"
 
+#include <atomic>
+#include <complex>
 #include <map>
 #include <memory>
 #include <string>
@@ -51,30 +53,49 @@
  */
 namespace lbcrypto {
 
+/**
+ * @brief The rotated diagonals of one level of the FFT-like encoding or decoding, kept unencoded
+ * with lazy encoding and encoded into plaintexts right before the level is evaluated
+ */
+struct CKKSBootstrapDiagonals {
+    // the extended basis the plaintexts of this level are encoded in
+    std::shared_ptr<DCRTPoly::Params> params;
+
+    // the level the plaintexts of this level are encoded at
+    uint32_t level = 0;
+
+    // one diagonal per baby-step giant-step product; empty for the ones not needed
+    std::vector<std::vector<std::complex<double>>> values;
+};
+
 class CKKSBootstrapPrecom {
 public:
     CKKSBootstrapPrecom() {}
 
     CKKSBootstrapPrecom(const CKKSBootstrapPrecom& rhs) {
-        m_dim1         = rhs.m_dim1;
-        m_slots        = rhs.m_slots;
-        m_paramsEnc    = rhs.m_paramsEnc;
-        m_paramsDec    = rhs.m_paramsDec;
-        m_U0Pre        = rhs.m_U0Pre;
-        m_U0hatTPre    = rhs.m_U0hatTPre;
-        m_U0PreFFT     = rhs.m_U0PreFFT;
-        m_U0hatTPreFFT = rhs.m_U0hatTPreFFT;
+        m_dim1          = rhs.m_dim1;
+        m_slots         = rhs.m_slots;
+        m_paramsEnc     = rhs.m_paramsEnc;
+        m_paramsDec     = rhs.m_paramsDec;
+        m_U0Pre         = rhs.m_U0Pre;
+        m_U0hatTPre     = rhs.m_U0hatTPre;
+        m_U0PreFFT      = rhs.m_U0PreFFT;
+        m_U0hatTPreFFT  = rhs.m_U0hatTPreFFT;
+        m_U0PreDiag     = rhs.m_U0PreDiag;
+        m_U0hatTPreDiag = rhs.m_U0hatTPreDiag;
     }
 
     CKKSBootstrapPrecom(CKKSBootstrapPrecom&& rhs) {
-        m_dim1         = rhs.m_dim1;
-        m_slots        = rhs.m_slots;
-        m_paramsEnc    = std::move(rhs.m_paramsEnc);
-        m_paramsDec    = std::move(rhs.m_paramsDec);
-        m_U0Pre        = std::move(rhs.m_U0Pre);
-        m_U0hatTPre    = std::move(rhs.m_U0hatTPre);
-        m_U0PreFFT     = std::move(rhs.m_U0PreFFT);
-        m_U0hatTPreFFT = std::move(rhs.m_U0hatTPreFFT);
+        m_dim1          = rhs.m_dim1;
+        m_slots         = rhs.m_slots;
+        m_paramsEnc     = std::move(rhs.m_paramsEnc);
+        m_paramsDec     = std::move(rhs.m_paramsDec);
+        m_U0Pre         = std::move(rhs.m_U0Pre);
+        m_U0hatTPre     = std::move(rhs.m_U0hatTPre);
+        m_U0PreFFT      = std::move(rhs.m_U0PreFFT);
+        m_U0hatTPreFFT  = std::move(rhs.m_U0hatTPreFFT);
+        m_U0PreDiag     = std::move(rhs.m_U0PreDiag);
+        m_U0hatTPreDiag = std::move(rhs.m_U0hatTPreDiag);
     }
 
     virtual ~CKKSBootstrapPrecom() {}
@@ -112,6 +133,12 @@ public:
     // coefficients corresponding to conj(U0^T); used in encoding
     std::vector<std::vector<ConstPlaintext>> m_U0hatTPreFFT;
 
+    // with lazy encoding, the diagonals m_U0PreFFT would be encoded from; used in decoding
+    std::vector<CKKSBootstrapDiagonals> m_U0PreDiag;
+
+    // with lazy encoding, the diagonals m_U0hatTPreFFT would be encoded from; used in encoding
+    std::vector<CKKSBootstrapDiagonals> m_U0hatTPreDiag;
+
     template <class Archive>
     void save(Archive& ar) const {
         ar(cereal::make_nvp("dim1_Enc", m_dim1));
@@ -143,16 +170,27 @@ public:
 
     void EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::vector<uint32_t> levelBudget,
                             std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor,
-                            bool precompute) override;
+                            bool precompute, bool lazyEncoding) override;
 
     std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> EvalBootstrapKeyGen(const PrivateKey<DCRTPoly> privateKey,
-                                                                            uint32_t slots) override;
+                                                                            uint32_t slots,
+                                                                            uint64_t memoryBudget) override;
 
-    void EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc, uint32_t slots) override;
+    std::vector<EvalKey<DCRTPoly>> EvalEncapsulationKeyGen(const PrivateKey<DCRTPoly> privateKey) override;
+
+    void EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc, uint32_t slots, bool lazyEncoding) override;
+
+    void SaveBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc, const std::string& filename,
+                                     uint32_t slots) const override;
+
+    void LoadBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc, const std::string& filename) override;
 
     Ciphertext<DCRTPoly> EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                        uint32_t precision) const override;
 
+    std::vector<Ciphertext<DCRTPoly>> EvalBootstrapBatch(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                                         uint32_t numIterations, uint32_t precision) const override;
+
     //------------------------------------------------------------------------------
     // Find Rotation Indices
     //------------------------------------------------------------------------------
@@ -179,17 +217,17 @@ public:
                                                               uint32_t orientation = 0, double scale = 1,
                                                               uint32_t L = 0) const;
 
-    std::vector<std::vector<ConstPlaintext>> EvalCoeffsToSlotsPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
-                                                                         const std::vector<std::complex<double>>& A,
-                                                                         const std::vector<uint32_t>& rotGroup,
-                                                                         bool flag_i, double scale = 1,
-                                                                         uint32_t L = 0) const;
+    // if diagonals is not null, the rotated diagonals are stored there instead of being encoded,
+    // and the returned vector is empty
+    std::vector<std::vector<ConstPlaintext>> EvalCoeffsToSlotsPrecompute(
+        const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
+        const std::vector<uint32_t>& rotGroup, bool flag_i, double scale = 1, uint32_t L = 0,
+        std::vector<CKKSBootstrapDiagonals>* diagonals = nullptr) const;
 
-    std::vector<std::vector<ConstPlaintext>> EvalSlotsToCoeffsPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
-                                                                         const std::vector<std::complex<double>>& A,
-                                                                         const std::vector<uint32_t>& rotGroup,
-                                                                         bool flag_i, double scale = 1,
-                                                                         uint32_t L = 0) const;
+    std::vector<std::vector<ConstPlaintext>> EvalSlotsToCoeffsPrecompute(
+        const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
+        const std::vector<uint32_t>& rotGroup, bool flag_i, double scale = 1, uint32_t L = 0,
+        std::vector<CKKSBootstrapDiagonals>* diagonals = nullptr) const;
 
     //------------------------------------------------------------------------------
     // EVALUATION: CoeffsToSlots and SlotsToCoeffs
@@ -227,6 +265,21 @@ public:
 
     static uint32_t GetBootstrapDepth(const std::vector<uint32_t>& levelBudget, SecretKeyDist secretKeyDist);
 
+    /**
+   * Selects how the giant steps of the bootstrapping linear transforms are evaluated. By default the
+   * inner sums stay in the extended basis Q_l*P and only their second element is brought down to Q_l
+   * (one ModDown per giant step). With false, both elements of every inner sum are brought down to Q_l
+   * before the hoisted rotation, as in earlier releases; this is only meant for comparing the two.
+   * Affects all crypto contexts of the process.
+   */
+    static void SetGiantStepsInExtendedBasis(bool flag) {
+        g_giantStepsInExtendedBasis = flag;
+    }
+
+    static bool GetGiantStepsInExtendedBasis() {
+        return g_giantStepsInExtendedBasis;
+    }
+
     std::string SerializedObjectName() const {
         return "FHECKKSRNS";
     }
@@ -239,6 +292,32 @@ private:
                                        const CryptoContextImpl<DCRTPoly>& cc);
     static uint32_t GetModDepthInternal(SecretKeyDist secretKeyDist);
 
+    // bootstraps ciphertexts with the same number of slots, key tag and level; the key switchings are batched
+    // across the ciphertexts
+    std::vector<Ciphertext<DCRTPoly>> EvalBootstrapInternal(const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts,
+                                                            uint32_t numIterations, uint32_t precision) const;
+
+    // runs the bootstrapping from the ciphertexts with the raised modulus: CoeffsToSlots, the approximate
+    // modular reduction and SlotsToCoeffs. The linear transforms run on the whole batch; the other stages
+    // run in parallel across the ciphertexts if acrossBatch is set.
+    std::vector<Ciphertext<DCRTPoly>> EvalBootstrapRaised(std::vector<Ciphertext<DCRTPoly>> raised,
+                                                          const std::shared_ptr<CKKSBootstrapPrecom>& precom,
+                                                          uint32_t correction, double pre, uint64_t scalar,
+                                                          bool acrossBatch) const;
+
+    // CoeffsToSlots and SlotsToCoeffs of ciphertexts with the same number of slots, key tag and level
+    std::vector<Ciphertext<DCRTPoly>> EvalCoeffsToSlotsBatch(const std::vector<std::vector<ConstPlaintext>>& A,
+                                                             std::vector<Ciphertext<DCRTPoly>> ctxts) const;
+
+    std::vector<Ciphertext<DCRTPoly>> EvalSlotsToCoeffsBatch(const std::vector<std::vector<ConstPlaintext>>& A,
+                                                             std::vector<Ciphertext<DCRTPoly>> ctxts) const;
+
+    // one level of CoeffsToSlots or SlotsToCoeffs with g baby steps and b giant steps, applied to every
+    // ciphertext of the batch in place
+    void EvalLinearTransformLevelBatch(std::vector<Ciphertext<DCRTPoly>>& ctxts, const std::vector<ConstPlaintext>& A,
+                                       const std::vector<int32_t>& rotIn, const std::vector<int32_t>& rotOut,
+                                       int32_t g, int32_t b, int32_t numRotations) const;
+
     void AdjustCiphertext(Ciphertext<DCRTPoly>& ciphertext, double correction) const;
 
     void ApplyDoubleAngleIterations(Ciphertext<DCRTPoly>& ciphertext, uint32_t numIt) const;
@@ -247,12 +326,28 @@ private:
                                const std::vector<std::complex<double>>& value, size_t noiseScaleDeg, uint32_t level,
                                usint slots) const;
 
+    // encodes the diagonals of one level kept by lazy encoding, in parallel if requested
+    std::vector<ConstPlaintext> EncodeDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                const CKKSBootstrapDiagonals& diagonals, bool parallel) const;
+
     Ciphertext<DCRTPoly> EvalMultExt(ConstCiphertext<DCRTPoly> ciphertext, ConstPlaintext plaintext) const;
 
     void EvalAddExtInPlace(Ciphertext<DCRTPoly>& ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
 
     Ciphertext<DCRTPoly> EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext1, ConstCiphertext<DCRTPoly> ciphertext2) const;
 
+    // adds the giant-step rotation of the inner sum, both in the extended basis, to the accumulator (double hoisting)
+    void EvalGiantStepExtInPlace(Ciphertext<DCRTPoly>& outer, Ciphertext<DCRTPoly> inner, int32_t rotation) const;
+
+    void EvalGiantStepExtBatchInPlace(std::vector<Ciphertext<DCRTPoly>>& outer,
+                                      std::vector<Ciphertext<DCRTPoly>> inner, int32_t rotation) const;
+
+    // hoisted rotation of every ciphertext of a batch, in the extended basis; the inner products with the
+    // rotation key are batched so that the key is loaded once for all ciphertexts
+    std::vector<Ciphertext<DCRTPoly>> EvalFastRotationExtBatch(
+        const std::vector<Ciphertext<DCRTPoly>>& ciphertexts, usint index,
+        const std::vector<std::shared_ptr<std::vector<DCRTPoly>>>& digits, bool addFirst) const;
+
     EvalKey<DCRTPoly> ConjugateKeyGen(const PrivateKey<DCRTPoly> privateKey) const;
 
     Ciphertext<DCRTPoly> Conjugate(ConstCiphertext<DCRTPoly> ciphertext,
@@ -288,9 +383,16 @@ private:
         3;  // number of double-angle iterations in CKKS bootstrapping. Must be static because it is used in a static function.
     uint32_t m_correctionFactor = 0;  // correction factor, which we scale the message by to improve precision
 
+    // Hamming weight of the ephemeral sparse secret used with SPARSE_ENCAPSULATED; the same as for SPARSE_TERNARY
+    // secrets, which K_SPARSE and the sparse Chebyshev series are chosen for
+    const uint32_t H_SPARSE_ENCAPSULATED = 192;
+
     // key tuple is dim1, levelBudgetEnc, levelBudgetDec
     std::map<uint32_t, std::shared_ptr<CKKSBootstrapPrecom>> m_bootPrecomMap;
 
+    // see SetGiantStepsInExtendedBasis()
+    static inline std::atomic<bool> g_giantStepsInExtendedBasis{true};
+
     // Chebyshev series coefficients for the SPARSE case
     static const inline std::vector<double> g_coefficientsSparse{
         -0.18646470117093214,   0.036680543700430925,    -0.20323558926782626,     0.029327390306199311,
@@ -118,6 +118,11 @@ public:
                                              const std::shared_ptr<std::vector<DCRTPoly>> digits, bool addFirst,
                                              const std::map<usint, EvalKey<DCRTPoly>>& evalKeys) const override;
 
+    Ciphertext<DCRTPoly> EvalRotateAndAccumulate(ConstCiphertext<DCRTPoly> ciphertext,
+                                                 const std::vector<int32_t>& indices,
+                                                 const std::vector<ConstPlaintext>& weights,
+                                                 const std::map<usint, EvalKey<DCRTPoly>>& evalKeys) const override;
+
     usint FindAutomorphismIndex(usint index, usint m) const override;
 
     /////////////////////////////////////
@@ -255,6 +255,17 @@ enum {
 };
 }  // namespace CKKS_BOOT_PARAMS
 
+namespace CKKS_ENCAPSULATION_KEYS {
+/**
+   * Enums representing indices for the vector of keys returned by EvalEncapsulationKeyGen()
+   */
+enum {
+    DENSE_TO_SPARSE,  // switches the first tower of a ciphertext from the main secret to the ephemeral sparse secret
+    SPARSE_TO_DENSE,  // switches the ciphertext with the raised modulus back to the main secret
+    TOTAL_ELEMENTS    // total number of keys in the vector
+};
+}  // namespace CKKS_ENCAPSULATION_KEYS
+
 }  // namespace lbcrypto
 
 #endif
@@ -117,6 +117,7 @@ typename ContextGeneratorType::ContextType genCryptoContextCKKSRNSInternal(
     // for CKKS scheme noise scale is always set to 1
     params->SetNoiseScale(1);
     params->SetFloodingDistributionParameter(floodingNoiseStd);
+    params->SetCompressEvalKeys(parameters.GetCompressEvalKeys());
 
     uint32_t numLargeDigits =
         ComputeNumLargeDigits(parameters.GetNumLargeDigits(), parameters.GetMultiplicativeDepth());
@@ -170,6 +170,10 @@ class Params {
     // COMPACT has stronger security assumption, thus more efficient
     COMPRESSION_LEVEL interactiveBootCompressionLevel;
 
+    // HYBRID key switching only: store the uniformly random "a" part of evaluation keys as a 256-bit seed
+    // it is expanded from. This halves the size of serialized keys; "a" is regenerated on first use after loading
+    bool compressEvalKeys;
+
     void SetToDefaults(SCHEME scheme);
 
 protected:
@@ -346,6 +350,9 @@ public:
     COMPRESSION_LEVEL GetInteractiveBootCompressionLevel() const {
         return interactiveBootCompressionLevel;
     }
+    bool GetCompressEvalKeys() const {
+        return compressEvalKeys;
+    }
 
     // setters
     // They all must be virtual, so any of them can be disabled in the derived class
@@ -436,6 +443,9 @@ public:
     virtual void SetInteractiveBootCompressionLevel(COMPRESSION_LEVEL interactiveBootCompressionLevel0) {
         interactiveBootCompressionLevel = interactiveBootCompressionLevel0;
     }
+    virtual void SetCompressEvalKeys(bool compressEvalKeys0) {
+        compressEvalKeys = compressEvalKeys0;
+    }
 
     friend std::ostream& operator<<(std::ostream& os, const Params& obj);
 };
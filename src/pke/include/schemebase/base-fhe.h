@@ -43,6 +43,7 @@
 #include "scheme/scheme-swch-params.h"
 
 #include <memory>
+#include <string>
 #include <vector>
 #include <map>
 #include <utility>
@@ -81,10 +82,12 @@ public:
    * @param slots - number of slots to be bootstrapped
    * @param correctionFactor - value to rescale message by to improve precision. If set to 0, we use the default logic. This value is only used when NATIVE_SIZE=64
    * @param precompute - flag specifying whether to precompute the plaintexts for encoding and decoding.
+   * @param lazyEncoding - flag specifying whether to keep only the diagonals of the FFT-like encoding and
+   * decoding, and encode them into plaintexts at every bootstrapping.
    */
     virtual void EvalBootstrapSetup(const CryptoContextImpl<Element>& cc, std::vector<uint32_t> levelBudget,
                                     std::vector<uint32_t> dim1, uint32_t slots, uint32_t correctionFactor,
-                                    bool precompute) {
+                                    bool precompute, bool lazyEncoding) {
         OPENFHE_THROW("Not supported");
     }
 
@@ -94,10 +97,23 @@ public:
    *
    * @param privateKey private key.
    * @param slots - number of slots to be bootstrapped
+   * @param memoryBudget - memory budget for the rotation keys in bytes; 0 generates all keys
    * @return the dictionary of evaluation key indices.
    */
     virtual std::shared_ptr<std::map<usint, EvalKey<Element>>> EvalBootstrapKeyGen(const PrivateKey<Element> privateKey,
-                                                                                   uint32_t slots) {
+                                                                                   uint32_t slots,
+                                                                                   uint64_t memoryBudget) {
+        OPENFHE_THROW("Not supported");
+    }
+
+    /**
+   * Virtual function to define the generation of the keys that switch a ciphertext to an ephemeral sparse
+   * secret for the modulus raising of EvalBootstrap and back (sparse-secret encapsulation).
+   *
+   * @param privateKey private key.
+   * @return the keys, or an empty vector if the secret key distribution does not use encapsulation.
+   */
+    virtual std::vector<EvalKey<Element>> EvalEncapsulationKeyGen(const PrivateKey<Element> privateKey) {
         OPENFHE_THROW("Not supported");
     }
 
@@ -105,8 +121,32 @@ public:
    * Computes the plaintexts for encoding and decoding for both linear and FFT-like methods. Supported in CKKS only.
    *
    * @param slots - number of slots to be bootstrapped
+   * @param lazyEncoding - flag specifying whether to keep only the diagonals of the FFT-like encoding and
+   * decoding, and encode them into plaintexts at every bootstrapping.
+   */
+    virtual void EvalBootstrapPrecompute(const CryptoContextImpl<Element>& cc, uint32_t slots, bool lazyEncoding) {
+        OPENFHE_THROW("Not supported");
+    }
+
+    /**
+   * Writes the plaintexts computed by EvalBootstrapPrecompute to a file that can be memory-mapped
+   * by LoadBootstrapPrecomputation. Supported in CKKS only.
+   *
+   * @param filename - the file to write
+   * @param slots - number of slots whose precomputations are written; all if 0
+   */
+    virtual void SaveBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, const std::string& filename,
+                                             uint32_t slots) const {
+        OPENFHE_THROW("Not supported");
+    }
+
+    /**
+   * Maps a file written by SaveBootstrapPrecomputation in place of calling EvalBootstrapSetup and
+   * EvalBootstrapPrecompute. Supported in CKKS only.
+   *
+   * @param filename - the file to load
    */
-    virtual void EvalBootstrapPrecompute(const CryptoContextImpl<Element>& cc, uint32_t slots) {
+    virtual void LoadBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, const std::string& filename) {
         OPENFHE_THROW("Not supported");
     }
 
@@ -130,6 +170,20 @@ public:
         OPENFHE_THROW("EvalBootstrap is not implemented for this scheme");
     }
 
+    /**
+   * Defines the bootstrapping evaluation of several ciphertexts with the same number of slots,
+   * key tag and level
+   *
+   * @param ciphertexts the input ciphertexts.
+   * @param numIterations number of iterations to run iterative bootstrapping (Meta-BTS).
+   * @param precision precision of initial bootstrapping algorithm.
+   * @return the refreshed ciphertexts.
+   */
+    virtual std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                                uint32_t numIterations, uint32_t precision) const {
+        OPENFHE_THROW("EvalBootstrapBatch is not implemented for this scheme");
+    }
+
     /**
    * Sets all parameters for switching from CKKS to FHEW
    *
@@ -607,6 +607,25 @@ public:
         OPENFHE_THROW(errMsg);
     }
 
+    /**
+   * Virtual function for hoisted rotate-and-accumulate: computes
+   * sum_i weights[i] * EvalRotate(ciphertext, indices[i]) with a single
+   * digit decomposition and a single ModDown.
+   *
+   * @param ciphertext the input ciphertext.
+   * @param indices the rotation indices.
+   * @param weights the plaintext weights, one per rotation index.
+   * @param evalKeys the rotation keys.
+   * @return the accumulated ciphertext.
+   */
+    virtual Ciphertext<Element> EvalRotateAndAccumulate(ConstCiphertext<Element> ciphertext,
+                                                        const std::vector<int32_t>& indices,
+                                                        const std::vector<ConstPlaintext>& weights,
+                                                        const std::map<usint, EvalKey<Element>>& evalKeys) const {
+        std::string errMsg = "EvalRotateAndAccumulate is not implemented for this scheme.";
+        OPENFHE_THROW(errMsg);
+    }
+
     /**
    * Generates evaluation keys for a list of indices
    * Currently works only for power-of-two and cyclic-group cyclotomics
@@ -626,12 +645,64 @@ public:
    * @param ciphertext.
    * @param i the index.
    * @param &evalAtIndexKeys - reference to the map of evaluation keys
-   * generated by EvalAtIndexKeyGen.
+   * generated by EvalAtIndexKeyGen. If the map has no key for the index, the
+   * rotation is composed from the keys it has (see FindRotationComposition);
+   * an exception is thrown only if no composition exists.
    * @return resulting ciphertext
    */
     virtual Ciphertext<Element> EvalAtIndex(ConstCiphertext<Element> ciphertext, int32_t index,
                                             const std::map<usint, EvalKey<Element>>& evalKeyMap) const;
 
+    /**
+   * Generates the base set of rotation keys (the rotations by +2^k and -2^k
+   * for all powers of two below m/4 and the conjugation key for automorphism
+   * m-1) plus dedicated keys for as many
+   * indices from indexList as fit into the memory budget; see
+   * PlanRotationKeys. Rotations without a dedicated key are composed from the
+   * base set at evaluation time.
+   *
+   * @param privateKey original private key used for decryption.
+   * @param indexList the rotation indices the application will use.
+   * @param memoryBudget the memory budget for all rotation keys, in bytes.
+   * @return returns the evaluation keys
+   */
+    virtual std::shared_ptr<std::map<usint, EvalKey<Element>>> EvalAtIndexBaseKeyGen(
+        const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList, uint64_t memoryBudget) const;
+
+    /**
+   * Chooses which rotations get a dedicated key when only a limited amount of
+   * memory is available. The base set (+2^k and -2^k for the powers of two
+   * below m/4) is always included, even if it exceeds the budget. The remaining
+   * indices are added in the order of decreasing composition cost (number of
+   * extra key switchings needed to compose them from the base set, i.e., the
+   * weight of their signed-digit form minus one) until the budget is exhausted.
+   * Indices are taken modulo m/4, so equivalent rotations share one key.
+   *
+   * @param indexList the rotation indices the application will use.
+   * @param m the cyclotomic order.
+   * @param keySize the size of one rotation key, in bytes.
+   * @param memoryBudget the memory budget for all rotation keys, in bytes.
+   * @return the rotation indices, reduced to [0, m/4), to generate keys for
+   */
+    static std::vector<int32_t> PlanRotationKeys(const std::vector<int32_t>& indexList, uint32_t m, uint64_t keySize,
+                                                 uint64_t memoryBudget);
+
+    /**
+   * Splits a rotation, taken modulo m/4, into rotations that have keys in
+   * evalKeyMap: the rotation is split into signed powers of two (its
+   * non-adjacent form, or that of the rotation minus m/4), and a stored key for
+   * the remaining rotation ends the split early. Key sets without the negative
+   * powers of two are handled by splitting off positive powers of two. The
+   * shortest composition found is returned; throws if none exists.
+   *
+   * @param index the rotation index.
+   * @param m the cyclotomic order.
+   * @param evalKeyMap the available rotation keys.
+   * @return the rotation indices to apply one after another
+   */
+    std::vector<int32_t> FindRotationComposition(int32_t index, uint32_t m,
+                                                 const std::map<usint, EvalKey<Element>>& evalKeyMap) const;
+
     virtual usint FindAutomorphismIndex(usint index, usint m) const {
         OPENFHE_THROW("FindAutomorphismIndex is not supported for this scheme");
     }
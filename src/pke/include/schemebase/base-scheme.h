@@ -349,6 +349,18 @@ public:
         return;
     }
 
+    virtual void KeySwitchBatchInPlace(std::vector<Ciphertext<Element>>& ciphertexts,
+                                       const EvalKey<Element> evalKey) const {
+        VerifyKeySwitchEnabled(__func__);
+        for (const auto& ciphertext : ciphertexts) {
+            if (!ciphertext)
+                OPENFHE_THROW("Input ciphertext is nullptr");
+        }
+        if (!evalKey)
+            OPENFHE_THROW("Input evaluation key is nullptr");
+        m_KeySwitch->KeySwitchBatchInPlace(ciphertexts, evalKey);
+    }
+
     virtual Ciphertext<Element> KeySwitchDown(ConstCiphertext<Element> ciphertext) const {
         VerifyKeySwitchEnabled(__func__);
         if (!ciphertext)
@@ -377,6 +389,23 @@ public:
         return m_KeySwitch->EvalFastKeySwitchCoreExt(digits, evalKey, params);
     }
 
+    virtual std::vector<std::shared_ptr<std::vector<Element>>> EvalFastKeySwitchCoreExtBatch(
+        const std::vector<std::shared_ptr<std::vector<Element>>>& digits, const EvalKey<Element> evalKey,
+        const std::shared_ptr<ParmType> params) const {
+        VerifyKeySwitchEnabled(__func__);
+        for (const auto& d : digits) {
+            if (nullptr == d)
+                OPENFHE_THROW("Input digits is nullptr");
+            if (d->size() == 0)
+                OPENFHE_THROW("Input digits size is 0");
+        }
+        if (!evalKey)
+            OPENFHE_THROW("Input evaluation key is nullptr");
+        if (!params)
+            OPENFHE_THROW("Input params is nullptr");
+        return m_KeySwitch->EvalFastKeySwitchCoreExtBatch(digits, evalKey, params);
+    }
+
     virtual std::shared_ptr<std::vector<Element>> EvalFastKeySwitchCore(
         const std::shared_ptr<std::vector<Element>> digits, const EvalKey<Element> evalKey,
         const std::shared_ptr<ParmType> params) const {
@@ -932,6 +961,27 @@ public:
 
     /**
    * Only supported for hybrid key switching.
+   * Computes sum_i weights[i] * EvalRotate(ciphertext, indices[i]) keeping all
+   * rotated products in the extended CRT basis P*Q and scaling down once
+   *
+   * @param ciphertext input ciphertext
+   * @param indices the rotation indices
+   * @param weights the plaintext weights, one per rotation index
+   * @param evalKeys the rotation keys
+   * @return resulting ciphertext
+   */
+    virtual Ciphertext<Element> EvalRotateAndAccumulate(ConstCiphertext<Element> ciphertext,
+                                                        const std::vector<int32_t>& indices,
+                                                        const std::vector<ConstPlaintext>& weights,
+                                                        const std::map<uint32_t, EvalKey<Element>>& evalKeys) const {
+        VerifyLeveledSHEEnabled(__func__);
+        if (!ciphertext)
+            OPENFHE_THROW("Input ciphertext is nullptr");
+        return m_LeveledSHE->EvalRotateAndAccumulate(ciphertext, indices, weights, evalKeys);
+    }
+
+    /**
+   * Only supported for hybrid key switching.
    * Scales down the polynomial c0 from extended basis P*Q to Q.
    *
    * @param ciphertext input ciphertext in the extended basis
@@ -955,6 +1005,9 @@ public:
         const PublicKey<Element> publicKey, const PrivateKey<Element> privateKey,
         const std::vector<int32_t>& indexList) const;
 
+    virtual std::shared_ptr<std::map<uint32_t, EvalKey<Element>>> EvalAtIndexBaseKeyGen(
+        const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList, uint64_t memoryBudget) const;
+
     virtual Ciphertext<Element> EvalAtIndex(ConstCiphertext<Element> ciphertext, uint32_t i,
                                             const std::map<uint32_t, EvalKey<Element>>& evalKeyMap) const {
         VerifyLeveledSHEEnabled(__func__);
@@ -1384,21 +1437,40 @@ public:
 
     void EvalBootstrapSetup(const CryptoContextImpl<Element>& cc, const std::vector<uint32_t>& levelBudget = {5, 4},
                             const std::vector<uint32_t>& dim1 = {0, 0}, uint32_t slots = 0,
-                            uint32_t correctionFactor = 0, bool precompute = true) {
+                            uint32_t correctionFactor = 0, bool precompute = true, bool lazyEncoding = false) {
         VerifyFHEEnabled(__func__);
-        m_FHE->EvalBootstrapSetup(cc, levelBudget, dim1, slots, correctionFactor, precompute);
+        m_FHE->EvalBootstrapSetup(cc, levelBudget, dim1, slots, correctionFactor, precompute, lazyEncoding);
         return;
     }
 
     std::shared_ptr<std::map<uint32_t, EvalKey<Element>>> EvalBootstrapKeyGen(const PrivateKey<Element> privateKey,
-                                                                              uint32_t slots) {
+                                                                              uint32_t slots,
+                                                                              uint64_t memoryBudget = 0) {
         VerifyFHEEnabled(__func__);
-        return m_FHE->EvalBootstrapKeyGen(privateKey, slots);
+        return m_FHE->EvalBootstrapKeyGen(privateKey, slots, memoryBudget);
     }
 
-    void EvalBootstrapPrecompute(const CryptoContextImpl<Element>& cc, uint32_t slots = 0) {
+    std::vector<EvalKey<Element>> EvalEncapsulationKeyGen(const PrivateKey<Element> privateKey) {
         VerifyFHEEnabled(__func__);
-        m_FHE->EvalBootstrapPrecompute(cc, slots);
+        return m_FHE->EvalEncapsulationKeyGen(privateKey);
+    }
+
+    void EvalBootstrapPrecompute(const CryptoContextImpl<Element>& cc, uint32_t slots = 0, bool lazyEncoding = false) {
+        VerifyFHEEnabled(__func__);
+        m_FHE->EvalBootstrapPrecompute(cc, slots, lazyEncoding);
+        return;
+    }
+
+    void SaveBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, const std::string& filename,
+                                     uint32_t slots = 0) const {
+        VerifyFHEEnabled(__func__);
+        m_FHE->SaveBootstrapPrecomputation(cc, filename, slots);
+        return;
+    }
+
+    void LoadBootstrapPrecomputation(const CryptoContextImpl<Element>& cc, const std::string& filename) {
+        VerifyFHEEnabled(__func__);
+        m_FHE->LoadBootstrapPrecomputation(cc, filename);
         return;
     }
 
@@ -1408,6 +1480,12 @@ public:
         return m_FHE->EvalBootstrap(ciphertext, numIterations, precision);
     }
 
+    std::vector<Ciphertext<Element>> EvalBootstrapBatch(const std::vector<Ciphertext<Element>>& ciphertexts,
+                                                        uint32_t numIterations = 1, uint32_t precision = 0) const {
+        VerifyFHEEnabled(__func__);
+        return m_FHE->EvalBootstrapBatch(ciphertexts, numIterations, precision);
+    }
+
     // SCHEMESWITCHING methods
 
     LWEPrivateKey EvalCKKStoFHEWSetup(const SchSwchParams& params) {
@@ -72,7 +72,8 @@ protected:
           m_scalTechnique(rhs.m_scalTechnique),
           m_encTechnique(rhs.m_encTechnique),
           m_multTechnique(rhs.m_multTechnique),
-          m_MPIntBootCiphertextCompressionLevel(rhs.m_MPIntBootCiphertextCompressionLevel) {}
+          m_MPIntBootCiphertextCompressionLevel(rhs.m_MPIntBootCiphertextCompressionLevel),
+          m_compressEvalKeys(rhs.m_compressEvalKeys) {}
 
     /**
    * Constructor that initializes values.  Note that it is possible to set
@@ -379,6 +380,35 @@ public:
         return m_paramsP;
     }
 
+    /**
+   * Gets the CRT basis Q^(l) = {q_1,...,q_{l+1}} of a ciphertext with l+1 towers.
+   * Used as the target basis of ModDown in Hybrid key switching
+   *
+   * @param l is the number of towers in the ciphertext minus one.
+   * @return the precomputed CRT params
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsQlHybrid(uint32_t l) const {
+        if (l < m_paramsQlHybrid.size())
+            return m_paramsQlHybrid[l];
+
+        OPENFHE_THROW("CryptoParametersRNS::GetParamsQlHybrid - index out of bounds.");
+    }
+
+    /**
+   * Gets the extended CRT basis Q^(l)*P = {q_1,...,q_{l+1},p_1,...,p_k} of a
+   * ciphertext with l+1 towers.
+   * Used in Hybrid key switching
+   *
+   * @param l is the number of towers in the ciphertext minus one.
+   * @return the precomputed CRT params
+   */
+    const std::shared_ptr<ILDCRTParams<BigInteger>>& GetParamsQlP(uint32_t l) const {
+        if (l < m_paramsQlP.size())
+            return m_paramsQlP[l];
+
+        OPENFHE_THROW("CryptoParametersRNS::GetParamsQlP - index out of bounds.");
+    }
+
     /**
    * Method that returns the number of towers within every digit.
    * This is the alpha parameter from the paper (see documentation
@@ -1346,6 +1376,25 @@ public:
         return m_MPIntBootCiphertextCompressionLevel;
     }
 
+    /////////////////////////////////////
+    // Evaluation key compression
+    /////////////////////////////////////
+    /**
+   * Gets whether HYBRID evaluation keys store their "a" part as a seed
+   * @return m_compressEvalKeys
+   */
+    bool GetCompressEvalKeys() const {
+        return m_compressEvalKeys;
+    }
+
+    /**
+   * Sets whether HYBRID evaluation keys store their "a" part as a seed
+   * @param compressEvalKeys true to generate compressed keys
+   */
+    void SetCompressEvalKeys(bool compressEvalKeys) {
+        m_compressEvalKeys = compressEvalKeys;
+    }
+
 protected:
     /////////////////////////////////////
     // PrecomputeCRTTables
@@ -1418,6 +1467,13 @@ protected:
     // used in GHS key switching
     std::shared_ptr<ILDCRTParams<BigInteger>> m_paramsP;
 
+    // Stores the parameters for Q^(l) = {q_1,...,q_{l+1}}, indexed by l; BFV keeps its own
+    // m_paramsQl for the multiplication, which holds only Q for some multiplication techniques
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsQlHybrid;
+
+    // Stores the parameters for Q^(l)*P = {q_1,...,q_{l+1},p_1,...,p_k}, indexed by l
+    std::vector<std::shared_ptr<ILDCRTParams<BigInteger>>> m_paramsQlP;
+
     // Stores the number of towers per Q_i
     uint32_t m_numPerPartQ = 0;
 
@@ -1773,6 +1829,9 @@ protected:
     /////////////////////////////////////
     COMPRESSION_LEVEL m_MPIntBootCiphertextCompressionLevel;
 
+    // generate HYBRID evaluation keys whose "a" part is expanded from a seed
+    bool m_compressEvalKeys = false;
+
 public:
     /////////////////////////////////////
     // SERIALIZATION
@@ -1789,6 +1848,7 @@ public:
         ar(cereal::make_nvp("ab", m_auxBits));
         ar(cereal::make_nvp("eb", m_extraBits));
         ar(cereal::make_nvp("ccl", m_MPIntBootCiphertextCompressionLevel));
+        ar(cereal::make_nvp("cek", m_compressEvalKeys));
     }
 
     template <class Archive>
@@ -1814,6 +1874,13 @@ public:
         catch (cereal::Exception&) {
             m_MPIntBootCiphertextCompressionLevel = COMPRESSION_LEVEL::SLACK;
         }
+        // m_compressEvalKeys is absent in archives written before it was added
+        try {
+            ar(cereal::make_nvp("cek", m_compressEvalKeys));
+        }
+        catch (cereal::Exception&) {
+            m_compressEvalKeys = false;
+        }
     }
 
     std::string SerializedObjectName() const override {
@@ -44,10 +44,11 @@
 namespace lbcrypto {
 
 template <typename Element>
-std::map<std::string, std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::s_evalMultKeyMap{};
+EvalKeyRegistry<std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::s_evalMultKeyMap{};
 template <typename Element>
-std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
-    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap{};
+EvalKeyRegistry<std::shared_ptr<std::map<usint, EvalKey<Element>>>> CryptoContextImpl<Element>::s_evalAutomorphismKeyMap{};
+template <typename Element>
+EvalKeyRegistry<std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::s_evalEncapsulationKeyMap{};
 
 template <typename Element>
 void CryptoContextImpl<Element>::SetKSTechniqueInScheme() {
@@ -71,11 +72,10 @@ template <typename Element>
 void CryptoContextImpl<Element>::EvalMultKeyGen(const PrivateKey<Element> key) {
     ValidateKey(key);
 
-    if (CryptoContextImpl<Element>::s_evalMultKeyMap.find(key->GetKeyTag()) ==
-        CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+    if (!CryptoContextImpl<Element>::s_evalMultKeyMap.Contains(key->GetKeyTag())) {
         // the key is not found in the map, so the key has to be generated
-        EvalKey<Element> k                                           = GetScheme()->EvalMultKeyGen(key);
-        CryptoContextImpl<Element>::s_evalMultKeyMap[k->GetKeyTag()] = {k};
+        EvalKey<Element> k = GetScheme()->EvalMultKeyGen(key);
+        CryptoContextImpl<Element>::s_evalMultKeyMap.Insert(k->GetKeyTag(), {k});
     }
 }
 
@@ -83,42 +83,34 @@ template <typename Element>
 void CryptoContextImpl<Element>::EvalMultKeysGen(const PrivateKey<Element> key) {
     ValidateKey(key);
 
-    if (CryptoContextImpl<Element>::s_evalMultKeyMap.find(key->GetKeyTag()) ==
-        CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+    if (!CryptoContextImpl<Element>::s_evalMultKeyMap.Contains(key->GetKeyTag())) {
         // the key is not found in the map, so the key has to be generated
-        const std::vector<EvalKey<Element>>& evalKeys                  = GetScheme()->EvalMultKeysGen(key);
-        CryptoContextImpl<Element>::s_evalMultKeyMap[key->GetKeyTag()] = evalKeys;
+        const std::vector<EvalKey<Element>>& evalKeys = GetScheme()->EvalMultKeysGen(key);
+        CryptoContextImpl<Element>::s_evalMultKeyMap.Insert(key->GetKeyTag(), evalKeys);
     }
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys() {
-    CryptoContextImpl<Element>::s_evalMultKeyMap.clear();
+    CryptoContextImpl<Element>::s_evalMultKeyMap.Clear();
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys(const std::string& id) {
-    auto kd = CryptoContextImpl<Element>::s_evalMultKeyMap.find(id);
-    if (kd != CryptoContextImpl<Element>::s_evalMultKeyMap.end())
-        CryptoContextImpl<Element>::s_evalMultKeyMap.erase(kd);
+    CryptoContextImpl<Element>::s_evalMultKeyMap.Erase(id);
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalMultKeys(const CryptoContext<Element> cc) {
-    for (auto it = CryptoContextImpl<Element>::s_evalMultKeyMap.begin();
-         it != CryptoContextImpl<Element>::s_evalMultKeyMap.end();) {
-        if (it->second[0]->GetCryptoContext() == cc) {
-            it = CryptoContextImpl<Element>::s_evalMultKeyMap.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
+    CryptoContextImpl<Element>::s_evalMultKeyMap.EraseIf(
+        [&cc](const std::string&, const std::vector<EvalKey<Element>>& keys) {
+            return keys[0]->GetCryptoContext() == cc;
+        });
 }
 
 template <typename Element>
 void CryptoContextImpl<Element>::InsertEvalMultKey(const std::vector<EvalKey<Element>>& vectorToInsert) {
-    CryptoContextImpl<Element>::GetAllEvalMultKeys()[vectorToInsert[0]->GetKeyTag()] = vectorToInsert;
+    CryptoContextImpl<Element>::s_evalMultKeyMap.Set(vectorToInsert[0]->GetKeyTag(), vectorToInsert);
 }
 
 /////////////////////////////////////////
@@ -168,39 +160,51 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::E
 }
 
 template <typename Element>
-const std::map<usint, EvalKey<Element>>& CryptoContextImpl<Element>::GetEvalSumKeyMap(const std::string& keyID) {
-    return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(keyID);
+std::shared_ptr<const std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalSumKeyMap(
+    const std::string& keyID) {
+    return CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID);
 }
 
 template <typename Element>
-std::map<std::string, std::vector<EvalKey<Element>>>& CryptoContextImpl<Element>::GetAllEvalMultKeys() {
-    return CryptoContextImpl<Element>::s_evalMultKeyMap;
+const std::map<std::string, std::vector<EvalKey<Element>>> CryptoContextImpl<Element>::GetAllEvalMultKeys() {
+    return CryptoContextImpl<Element>::s_evalMultKeyMap.GetAll();
 }
 
 template <typename Element>
-const std::vector<EvalKey<Element>>& CryptoContextImpl<Element>::GetEvalMultKeyVector(const std::string& keyID) {
-    auto ekv = CryptoContextImpl<Element>::s_evalMultKeyMap.find(keyID);
-    if (ekv == CryptoContextImpl<Element>::s_evalMultKeyMap.end()) {
+const std::vector<EvalKey<Element>> CryptoContextImpl<Element>::GetEvalMultKeyVector(const std::string& keyID) {
+    std::vector<EvalKey<Element>> evalKeys;
+    if (!CryptoContextImpl<Element>::s_evalMultKeyMap.Find(keyID, evalKeys)) {
         std::string errMsg(std::string("Call EvalMultKeyGen() to have EvalMultKey available for ID [") + keyID + "].");
         OPENFHE_THROW(errMsg);
     }
-    return ekv->second;
+    return evalKeys;
+}
+
+template <typename Element>
+const std::vector<EvalKey<Element>> CryptoContextImpl<Element>::GetEvalEncapsulationKeyVector(
+    const std::string& keyID) {
+    std::vector<EvalKey<Element>> evalKeys;
+    if (!CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Find(keyID, evalKeys)) {
+        OPENFHE_THROW("Call EvalBootstrapKeyGen() to have the sparse-secret encapsulation keys available for ID [" +
+                      keyID + "].");
+    }
+    return evalKeys;
 }
 
 template <typename Element>
-std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>&
+const std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
 CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys() {
-    return CryptoContextImpl<Element>::s_evalAutomorphismKeyMap;
+    return CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.GetAll();
 }
 
 template <typename Element>
-std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
+std::shared_ptr<const std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(
     const std::string& keyID) {
-    auto ekv = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(keyID);
-    if (ekv == CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end()) {
+    std::shared_ptr<std::map<usint, EvalKey<Element>>> evalKeyMap;
+    if (!CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Find(keyID, evalKeyMap)) {
         OPENFHE_THROW("EvalAutomorphismKeys are not generated for ID [" + keyID + "].");
     }
-    return ekv->second;
+    return evalKeyMap;
 }
 
 template <typename Element>
@@ -209,8 +213,7 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::G
     if (!indexList.size())
         OPENFHE_THROW("indexList is empty");
 
-    std::shared_ptr<std::map<usint, EvalKey<Element>>> keyMap =
-        CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID);
+    auto keyMap = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(keyID);
 
     // create a return map if specific indices are provided
     std::map<usint, EvalKey<Element>> retMap;
@@ -225,7 +228,7 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> CryptoContextImpl<Element>::G
 }
 
 template <typename Element>
-std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>&
+const std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<Element>>>>
 CryptoContextImpl<Element>::GetAllEvalSumKeys() {
     return CryptoContextImpl<Element>::GetAllEvalAutomorphismKeys();
 }
@@ -270,9 +273,19 @@ void CryptoContextImpl<Element>::EvalAtIndexKeyGen(const PrivateKey<Element> pri
     CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
 }
 
+template <typename Element>
+void CryptoContextImpl<Element>::EvalAtIndexBaseKeyGen(const PrivateKey<Element> privateKey,
+                                                       const std::vector<int32_t>& indexList, uint64_t memoryBudget) {
+    ValidateKey(privateKey);
+
+    auto evalKeys = GetScheme()->EvalAtIndexBaseKeyGen(privateKey, indexList, memoryBudget);
+    CryptoContextImpl<Element>::InsertEvalAutomorphismKey(evalKeys, privateKey->GetKeyTag());
+}
+
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
-    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.clear();
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Clear();
+    CryptoContextImpl<Element>::ClearEvalEncapsulationKeys();
 }
 
 /**
@@ -281,9 +294,8 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys() {
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const std::string& id) {
-    auto kd = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(id);
-    if (kd != CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end())
-        CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.erase(kd);
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Erase(id);
+    CryptoContextImpl<Element>::ClearEvalEncapsulationKeys(id);
 }
 
 /**
@@ -293,28 +305,46 @@ void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const std::string& id
  */
 template <typename Element>
 void CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(const CryptoContext<Element> cc) {
-    for (auto it = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.begin();
-         it != CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end();) {
-        if (it->second->begin()->second->GetCryptoContext() == cc) {
-            it = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.EraseIf(
+        [&cc](const std::string&, const std::shared_ptr<std::map<usint, EvalKey<Element>>>& keyMap) {
+            return keyMap->begin()->second->GetCryptoContext() == cc;
+        });
+    CryptoContextImpl<Element>::ClearEvalEncapsulationKeys(cc);
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::ClearEvalEncapsulationKeys() {
+    CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Clear();
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::ClearEvalEncapsulationKeys(const std::string& id) {
+    CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Erase(id);
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::ClearEvalEncapsulationKeys(const CryptoContext<Element> cc) {
+    CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.EraseIf(
+        [&cc](const std::string&, const std::vector<EvalKey<Element>>& keys) {
+            return keys[0]->GetCryptoContext() == cc;
+        });
+}
+
+template <typename Element>
+void CryptoContextImpl<Element>::InsertEvalEncapsulationKey(const std::vector<EvalKey<Element>>& vectorToInsert) {
+    CryptoContextImpl<Element>::s_evalEncapsulationKeyMap.Set(vectorToInsert[0]->GetKeyTag(), vectorToInsert);
 }
 
 template <typename Element>
 std::set<uint32_t> CryptoContextImpl<Element>::GetExistingEvalAutomorphismKeyIndices(const std::string& keyTag) {
-    auto keyMapIt = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(keyTag);
-    if (keyMapIt == CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.end())
+    std::shared_ptr<std::map<usint, EvalKey<Element>>> keyMap;
+    if (!CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Find(keyTag, keyMap))
         // there is no keys for the given id, return empty vector
         return std::set<uint32_t>();
 
     // get all inidices from the existing automorphism key map
-    auto& keyMap = *(keyMapIt->second);
     std::set<uint32_t> indices;
-    for (const auto& [key, _] : keyMap) {
+    for (const auto& [key, _] : *keyMap) {
         indices.insert(key);
     }
 
@@ -341,35 +371,27 @@ void CryptoContextImpl<Element>::InsertEvalAutomorphismKey(
 
     auto mapToInsertIt   = mapToInsert->begin();
     const std::string id = (keyTag.empty()) ? mapToInsertIt->second->GetKeyTag() : keyTag;
-    std::set<uint32_t> existingIndices{CryptoContextImpl<Element>::GetExistingEvalAutomorphismKeyIndices(id)};
-    if (existingIndices.empty()) {
-        // there is no keys for the given id, so we insert full mapToInsert
-        CryptoContextImpl<Element>::s_evalAutomorphismKeyMap[id] = mapToInsert;
-    }
-    else {
-        // get all indices from mapToInsert
-        std::set<uint32_t> newIndices;
-        for (const auto& [key, _] : *mapToInsert) {
-            newIndices.insert(key);
-        }
+    CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.Update(
+        id, [&mapToInsert](const std::shared_ptr<std::map<usint, EvalKey<Element>>>* existing) {
+            // there is no keys for the given id, so we insert a copy of full mapToInsert: the caller keeps
+            // mapToInsert and may change it, while the registered map must not change
+            if (existing == nullptr || (*existing)->empty())
+                return std::make_shared<std::map<usint, EvalKey<Element>>>(*mapToInsert);
 
-        // find all indices in mapToInsert that are not in the exising map and
-        // insert those new indices and their corresponding keys to the existing map
-        std::set<uint32_t> indicesToInsert{CryptoContextImpl<Element>::GetUniqueValues(existingIndices, newIndices)};
-        auto keyMapIt = CryptoContextImpl<Element>::s_evalAutomorphismKeyMap.find(id);
-        auto& keyMap  = *(keyMapIt->second);
-        for (uint32_t indx : indicesToInsert) {
-            keyMap[indx] = (*mapToInsert)[indx];
-        }
-    }
+            // the registered map may be in use by other threads, so the indices of mapToInsert that are
+            // not in it yet are added to a copy of it, which then replaces it
+            auto keyMap = std::make_shared<std::map<usint, EvalKey<Element>>>(**existing);
+            keyMap->insert(mapToInsert->begin(), mapToInsert->end());
+            return keyMap;
+        });
 }
 
 template <typename Element>
 Ciphertext<Element> CryptoContextImpl<Element>::EvalSum(ConstCiphertext<Element> ciphertext, usint batchSize) const {
     ValidateCiphertext(ciphertext);
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-    auto rv          = GetScheme()->EvalSum(ciphertext, batchSize, evalSumKeys);
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    auto rv          = GetScheme()->EvalSum(ciphertext, batchSize, *evalSumKeys);
     return rv;
 }
 
@@ -389,8 +411,8 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalSumCols(
     const std::map<usint, EvalKey<Element>>& evalSumKeysRight) const {
     ValidateCiphertext(ciphertext);
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
-    auto rv          = GetScheme()->EvalSumCols(ciphertext, numCols, evalSumKeys, evalSumKeysRight);
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    auto rv          = GetScheme()->EvalSumCols(ciphertext, numCols, *evalSumKeys, evalSumKeysRight);
     return rv;
 }
 
@@ -406,9 +428,9 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalAtIndex(ConstCiphertext<Elem
         return rv;
     }
 
-    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
 
-    auto rv = GetScheme()->EvalAtIndex(ciphertext, index, evalAutomorphismKeys);
+    auto rv = GetScheme()->EvalAtIndex(ciphertext, index, *evalAutomorphismKeys);
     return rv;
 }
 
@@ -417,9 +439,10 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalMerge(
     const std::vector<Ciphertext<Element>>& ciphertextVector) const {
     ValidateCiphertext(ciphertextVector[0]);
 
-    auto evalAutomorphismKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ciphertextVector[0]->GetKeyTag());
+    auto evalAutomorphismKeys =
+        CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ciphertextVector[0]->GetKeyTag());
 
-    auto rv = GetScheme()->EvalMerge(ciphertextVector, evalAutomorphismKeys);
+    auto rv = GetScheme()->EvalMerge(ciphertextVector, *evalAutomorphismKeys);
 
     return rv;
 }
@@ -433,10 +456,10 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(ConstCiphertext
             "Information passed to EvalInnerProduct was not generated "
             "with this crypto context");
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ct1->GetKeyTag());
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ct1->GetKeyTag());
     auto ek          = CryptoContextImpl<Element>::GetEvalMultKeyVector(ct1->GetKeyTag());
 
-    auto rv = GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, evalSumKeys, ek[0]);
+    auto rv = GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, *evalSumKeys, ek[0]);
     return rv;
 }
 
@@ -449,9 +472,9 @@ Ciphertext<Element> CryptoContextImpl<Element>::EvalInnerProduct(ConstCiphertext
             "Information passed to EvalInnerProduct was not generated "
             "with this crypto context");
 
-    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMap(ct1->GetKeyTag());
+    auto evalSumKeys = CryptoContextImpl<Element>::GetEvalAutomorphismKeyMapPtr(ct1->GetKeyTag());
 
-    auto rv = GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, evalSumKeys);
+    auto rv = GetScheme()->EvalInnerProduct(ct1, ct2, batchSize, *evalSumKeys);
     return rv;
 }
 
@@ -32,6 +32,7 @@
 #include "cryptocontextfactory.h"
 #include "schemebase/base-scheme.h"
 #include "scheme/scheme-id.h"
+#include "utils/parallel.h"
 
 namespace lbcrypto {
 
@@ -69,6 +70,9 @@ CryptoContext<Element> CryptoContextFactory<Element>::GetContext(std::shared_ptr
     CryptoContext<Element> cc = FindContext(params, scheme);
     // if the context is not found we should create one
     if (nullptr == cc) {
+        // pick the kernel grains for this machine once, before the first context is used
+        if (OpenFHEParallelControls.IsAutotuneEnabled())
+            OpenFHEParallelControls.Autotune();
         cc = std::make_shared<CryptoContextImpl<Element>>(params, scheme, schemeId);
         AddContext(cc);
     }
@@ -0,0 +1,198 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+#include "cryptocontext.h"
+#include "key/evalkeystore.h"
+
+#include "cryptocontext-ser.h"
+#include "key/key-ser.h"
+#include "utils/mappedfile.h"
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lbcrypto {
+
+namespace {
+
+using EvalMultKeyMap         = std::map<std::string, std::vector<EvalKey<DCRTPoly>>>;
+using EvalAutomorphismKeyMap = std::map<std::string, std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>>>;
+
+constexpr char STORE_MAGIC[8]{'O', 'F', 'H', 'E', 'E', 'V', 'K', 'S'};
+constexpr uint32_t STORE_VERSION{1};
+
+// the keys of both maps in the order their values are stored
+template <typename F>
+void ForEachKey(const EvalMultKeyMap& multKeys, const EvalAutomorphismKeyMap& automorphismKeys, F&& f) {
+    for (const auto& [tag, keys] : multKeys) {
+        for (const auto& key : keys)
+            f(key);
+    }
+    for (const auto& [tag, keys] : automorphismKeys) {
+        for (const auto& [index, key] : *keys)
+            f(key);
+    }
+}
+
+// a key with the same context, tag and polynomial shapes, but no values
+EvalKey<DCRTPoly> Describe(const EvalKey<DCRTPoly>& key) {
+    auto shapesOf = [](const std::vector<DCRTPoly>& polys) {
+        std::vector<DCRTPoly> shapes;
+        shapes.reserve(polys.size());
+        for (const auto& poly : polys)
+            shapes.emplace_back(poly.GetParams(), poly.GetFormat(), false);
+        return shapes;
+    };
+    auto description = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(key->GetCryptoContext());
+    description->SetKeyTag(key->GetKeyTag());
+    description->SetAVector(shapesOf(key->GetAVector()));
+    description->SetBVector(shapesOf(key->GetBVector()));
+    return description;
+}
+
+// a key whose polynomials are views of the stored values starting at the given offset
+EvalKey<DCRTPoly> Attach(const EvalKey<DCRTPoly>& description, const uint8_t* data,
+                         const std::shared_ptr<const uint8_t>& mapping, uint64_t dataSize, uint64_t& offset) {
+    auto viewsOf = [&](const std::vector<DCRTPoly>& shapes) {
+        std::vector<DCRTPoly> polys;
+        polys.reserve(shapes.size());
+        for (const auto& shape : shapes)
+            polys.push_back(AttachMapped(shape, data, mapping, dataSize, offset));
+        return polys;
+    };
+    auto key = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(description->GetCryptoContext());
+    key->SetKeyTag(description->GetKeyTag());
+    key->SetAVector(viewsOf(description->GetAVector()));
+    key->SetBVector(viewsOf(description->GetBVector()));
+    return key;
+}
+
+}  // namespace
+
+void EvalKeyStore::Write(const std::string& filename, const std::string& keyTag) {
+    EvalMultKeyMap multKeys;
+    EvalAutomorphismKeyMap automorphismKeys;
+    for (const auto& [tag, keys] : CryptoContextImpl<DCRTPoly>::GetAllEvalMultKeys()) {
+        if (keyTag.empty() || tag == keyTag)
+            multKeys[tag] = keys;
+    }
+    for (const auto& [tag, keys] : CryptoContextImpl<DCRTPoly>::GetAllEvalAutomorphismKeys()) {
+        if (keyTag.empty() || tag == keyTag)
+            automorphismKeys[tag] = keys;
+    }
+    if (multKeys.empty() && automorphismKeys.empty())
+        OPENFHE_THROW("No evaluation keys found for ID [" + keyTag + "].");
+
+    EvalMultKeyMap multDescriptions;
+    for (const auto& [tag, keys] : multKeys) {
+        auto& descriptions = multDescriptions[tag];
+        for (const auto& key : keys)
+            descriptions.push_back(Describe(key));
+    }
+    EvalAutomorphismKeyMap automorphismDescriptions;
+    for (const auto& [tag, keys] : automorphismKeys) {
+        auto descriptions = std::make_shared<std::map<usint, EvalKey<DCRTPoly>>>();
+        for (const auto& [index, key] : *keys)
+            (*descriptions)[index] = Describe(key);
+        automorphismDescriptions[tag] = descriptions;
+    }
+
+    std::stringstream description;
+    Serial::Serialize(multDescriptions, description, SerType::BINARY);
+    Serial::Serialize(automorphismDescriptions, description, SerType::BINARY);
+    const std::string descriptionBytes = description.str();
+
+    uint64_t dataSize{0};
+    ForEachKey(multKeys, automorphismKeys, [&dataSize](const EvalKey<DCRTPoly>& key) {
+        for (const auto& poly : key->GetAVector())
+            dataSize += MappedSize(poly);
+        for (const auto& poly : key->GetBVector())
+            dataSize += MappedSize(poly);
+    });
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        OPENFHE_THROW("Can not open " + filename);
+    WriteMappedFileHeader(file, STORE_MAGIC, STORE_VERSION, sizeof(NativeInteger), descriptionBytes, dataSize);
+    ForEachKey(multKeys, automorphismKeys, [&file](const EvalKey<DCRTPoly>& key) {
+        for (const auto& poly : key->GetAVector())
+            WriteMapped(file, poly);
+        for (const auto& poly : key->GetBVector())
+            WriteMapped(file, poly);
+    });
+    if (!file)
+        OPENFHE_THROW("Error writing the key store to " + filename);
+}
+
+void EvalKeyStore::Load(const std::string& filename) {
+    uint64_t size{0};
+    auto mapping = MapFile(filename, size);
+
+    auto header = ReadMappedFileHeader(filename, mapping.get(), size, STORE_MAGIC, STORE_VERSION, sizeof(NativeInteger),
+                                       "key store");
+
+    EvalMultKeyMap multDescriptions;
+    EvalAutomorphismKeyMap automorphismDescriptions;
+    std::istringstream description(
+        std::string(reinterpret_cast<const char*>(mapping.get()) + sizeof(header), header.descriptionSize));
+    Serial::Deserialize(multDescriptions, description, SerType::BINARY);
+    Serial::Deserialize(automorphismDescriptions, description, SerType::BINARY);
+
+    const uint8_t* data = mapping.get() + header.dataOffset;
+    uint64_t offset{0};
+    EvalMultKeyMap multKeys;
+    for (const auto& [tag, descriptions] : multDescriptions) {
+        auto& keys = multKeys[tag];
+        for (const auto& d : descriptions)
+            keys.push_back(Attach(d, data, mapping, header.dataSize, offset));
+    }
+    EvalAutomorphismKeyMap automorphismKeys;
+    for (const auto& [tag, descriptions] : automorphismDescriptions) {
+        auto keys = std::make_shared<std::map<usint, EvalKey<DCRTPoly>>>();
+        for (const auto& [index, d] : *descriptions)
+            (*keys)[index] = Attach(d, data, mapping, header.dataSize, offset);
+        automorphismKeys[tag] = keys;
+    }
+    if (offset != header.dataSize)
+        OPENFHE_THROW("the key store " + filename + " does not match its description");
+
+    for (const auto& [tag, keys] : multKeys)
+        CryptoContextImpl<DCRTPoly>::InsertEvalMultKey(keys);
+    for (const auto& [tag, keys] : automorphismKeys) {
+        CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys(tag);
+        CryptoContextImpl<DCRTPoly>::InsertEvalAutomorphismKey(keys, tag);
+    }
+}
+
+}  // namespace lbcrypto
@@ -43,8 +43,27 @@
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "ciphertext.h"
 
+#include "utils/parallel.h"
+#include "utils/vectorpool.h"
+
+#include <algorithm>
+#include <map>
+
 namespace lbcrypto {
 
+namespace {
+// ModUp counters of the calling thread
+thread_local KeySwitchStats tlsKeySwitchStats;
+}  // namespace
+
+KeySwitchStats KeySwitchHYBRID::GetThreadStats() {
+    return tlsKeySwitchStats;
+}
+
+void KeySwitchHYBRID::ResetThreadStats() {
+    tlsKeySwitchStats = KeySwitchStats();
+}
+
 EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPoly> oldKey,
                                                         const PrivateKey<DCRTPoly> newKey) const {
     return KeySwitchHYBRID::KeySwitchGenInternal(oldKey, newKey, nullptr);
@@ -99,9 +118,17 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
     std::vector<NativeInteger> PModq = cryptoParams->GetPModq();
     size_t numPerPartQ               = cryptoParams->GetNumPerPartQ();
 
+    // a compressed key derives all "a" parts from one seed, so only the seed needs to be stored
+    std::vector<uint32_t> seed;
+    if (ekPrev == nullptr && cryptoParams->GetCompressEvalKeys()) {
+        seed = EvalKeyRelinImpl<DCRTPoly>::GenerateASeed();
+        av   = EvalKeyRelinImpl<DCRTPoly>::ExpandAVector(seed, paramsQP, numPartQ);
+    }
+
     for (size_t part = 0; part < numPartQ; ++part) {
-        DCRTPoly a = (ekPrev == nullptr) ? DCRTPoly(dug, paramsQP, Format::EVALUATION) :  // single-key HE
-                                           ekPrev->GetAVector()[part];                                      // threshold HE
+        DCRTPoly a = !seed.empty()        ? av[part] :                                   // compressed key
+                     (ekPrev == nullptr) ? DCRTPoly(dug, paramsQP, Format::EVALUATION) :  // single-key HE
+                                           ekPrev->GetAVector()[part];                    // threshold HE
         DCRTPoly e(dgg, paramsQP, Format::EVALUATION);
         DCRTPoly b(paramsQP, Format::EVALUATION, true);
 
@@ -130,6 +157,8 @@ EvalKey<DCRTPoly> KeySwitchHYBRID::KeySwitchGenInternal(const PrivateKey<DCRTPol
 
     ek->SetAVector(std::move(av));
     ek->SetBVector(std::move(bv));
+    if (!seed.empty())
+        ek->SetASeed(seed);
     ek->SetKeyTag(newKey->GetKeyTag());
     return ek;
 }
@@ -227,17 +256,145 @@ void KeySwitchHYBRID::KeySwitchInPlace(Ciphertext<DCRTPoly>& ciphertext, const E
     cv.resize(2);
 }
 
+void KeySwitchHYBRID::KeySwitchBatchInPlace(std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                            const EvalKey<DCRTPoly> ek) const {
+    // the extended basis depends on the level, so the batch is processed one level at a time
+    std::map<size_t, std::vector<Ciphertext<DCRTPoly>>> levels;
+    for (const auto& ciphertext : ciphertexts)
+        levels[ciphertext->GetElements()[0].GetNumOfElements()].push_back(ciphertext);
+
+    for (const auto& level : levels)
+        KeySwitchBatchLevelInPlace(level.second, ek, level.first);
+}
+
+void KeySwitchHYBRID::KeySwitchBatchLevelInPlace(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                                 const EvalKey<DCRTPoly> ek, size_t sizeQl) const {
+    VectorPoolScope poolScope;
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(ek->GetCryptoParameters());
+
+    const uint32_t batch = ciphertexts.size();
+    // ModUp and ModDown are parallel internally; they are spread across the ciphertexts
+    // instead once the batch is large enough to keep all threads busy
+    const bool acrossBatch = batch >= static_cast<uint32_t>(OpenFHEParallelControls.GetMachineThreads());
+
+    std::vector<std::shared_ptr<std::vector<DCRTPoly>>> digits(batch);
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(batch)) if (acrossBatch)
+    for (uint32_t k = 0; k < batch; ++k) {
+        std::vector<DCRTPoly>& cv = ciphertexts[k]->GetElements();
+        for (auto& c : cv)
+            c.SetFormat(Format::EVALUATION);
+        digits[k] = EvalKeySwitchPrecomputeCore((cv.size() == 2) ? cv[1] : cv[2], cryptoParams);
+    }
+
+    const auto& paramsQl = cryptoParams->GetParamsQlHybrid(sizeQl - 1);
+    auto cTilda          = EvalFastKeySwitchCoreExtBatch(digits, ek, paramsQl);
+    digits.clear();
+
+    PlaintextModulus t = (cryptoParams->GetNoiseScale() == 1) ? 0 : cryptoParams->GetPlaintextModulus();
+
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(batch)) if (acrossBatch)
+    for (uint32_t k = 0; k < batch; ++k) {
+        DCRTPoly ct0 = (*cTilda[k])[0].ApproxModDown(
+            paramsQl, cryptoParams->GetParamsP(), cryptoParams->GetPInvModq(), cryptoParams->GetPInvModqPrecon(),
+            cryptoParams->GetPHatInvModp(), cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
+            cryptoParams->GetModqBarrettMu(), cryptoParams->GettInvModp(), cryptoParams->GettInvModpPrecon(), t,
+            cryptoParams->GettModqPrecon());
+        DCRTPoly ct1 = (*cTilda[k])[1].ApproxModDown(
+            paramsQl, cryptoParams->GetParamsP(), cryptoParams->GetPInvModq(), cryptoParams->GetPInvModqPrecon(),
+            cryptoParams->GetPHatInvModp(), cryptoParams->GetPHatInvModpPrecon(), cryptoParams->GetPHatModq(),
+            cryptoParams->GetModqBarrettMu(), cryptoParams->GettInvModp(), cryptoParams->GettInvModpPrecon(), t,
+            cryptoParams->GettModqPrecon());
+
+        std::vector<DCRTPoly>& cv = ciphertexts[k]->GetElements();
+        cv[0].SetFormat(ct0.GetFormat());
+        cv[0] += ct0;
+
+        cv[1].SetFormat(ct1.GetFormat());
+        if (cv.size() > 2) {
+            cv[1] += ct1;
+        }
+        else {
+            cv[1] = std::move(ct1);
+        }
+        cv.resize(2);
+    }
+}
+
+std::vector<std::shared_ptr<std::vector<DCRTPoly>>> KeySwitchHYBRID::EvalFastKeySwitchCoreExtBatch(
+    const std::vector<std::shared_ptr<std::vector<DCRTPoly>>>& digits, const EvalKey<DCRTPoly> evalKey,
+    const std::shared_ptr<ParmType> paramsQl) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
+    // with a key kept in Montgomery form the products need no Barrett reduction
+    const bool montgomery           = evalKey->HasMontgomeryForm();
+    const std::vector<DCRTPoly>& bv = montgomery ? evalKey->GetMontgomeryBVector() : evalKey->GetBVector();
+    const std::vector<DCRTPoly>& av = montgomery ? evalKey->GetMontgomeryAVector() : evalKey->GetAVector();
+
+    const uint32_t batch     = digits.size();
+    const auto paramsQlP     = (*digits[0])[0].GetParams();
+    const uint32_t sizeQl    = paramsQl->GetParams().size();
+    const uint32_t sizeQlP   = paramsQlP->GetParams().size();
+    const uint32_t sizeQ     = cryptoParams->GetElementParams()->GetParams().size();
+    const uint32_t numDigits = digits[0]->size();
+    const uint32_t ringDim   = paramsQlP->GetRingDimension();
+    const uint32_t nBlocks   = (ringDim + KEYSWITCH_BATCH_BLOCK_SIZE - 1) / KEYSWITCH_BATCH_BLOCK_SIZE;
+
+    std::vector<DCRTPoly> cTilda0(batch, DCRTPoly(paramsQlP, Format::EVALUATION, true));
+    std::vector<DCRTPoly> cTilda1(batch, DCRTPoly(paramsQlP, Format::EVALUATION, true));
+
+    // Inner product with the key, tiled over (tower, block): the blocks of the key towers
+    // are loaded once and multiplied into the digits of all ciphertexts of the batch
+    const uint32_t items = sizeQlP * nBlocks;
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(items))
+    for (uint32_t item = 0; item < items; ++item) {
+        const uint32_t i      = item / nBlocks;
+        const uint32_t kBegin = (item % nBlocks) * KEYSWITCH_BATCH_BLOCK_SIZE;
+        const uint32_t kEnd   = std::min(ringDim, kBegin + KEYSWITCH_BATCH_BLOCK_SIZE);
+        // the key towers are those of Q followed by those of P
+        const uint32_t keyIdx = (i < sizeQl) ? i : sizeQ + (i - sizeQl);
+
+        const NativeInteger& q     = paramsQlP->GetParams()[i]->GetModulus();
+        const auto mu              = q.ComputeMu();
+        const NativeInteger negInv = montgomery ? q.ComputeMontgomeryNegInv() : NativeInteger(0);
+        for (uint32_t j = 0; j < numDigits; ++j) {
+            const NativeVector& bji = bv[j].GetElementAtIndex(keyIdx).GetValues();
+            const NativeVector& aji = av[j].GetElementAtIndex(keyIdx).GetValues();
+            for (uint32_t k = 0; k < batch; ++k) {
+                const NativeVector& cji = (*digits[k])[j].GetElementAtIndex(i).GetValues();
+                NativePoly& acc0        = cTilda0[k].GetAllElements()[i];
+                NativePoly& acc1        = cTilda1[k].GetAllElements()[i];
+                if (montgomery) {
+                    for (uint32_t x = kBegin; x < kEnd; ++x) {
+                        acc0[x].ModAddFastEq(cji[x].ModMulMontgomery(bji[x], q, negInv), q);
+                        acc1[x].ModAddFastEq(cji[x].ModMulMontgomery(aji[x], q, negInv), q);
+                    }
+                }
+                else {
+                    for (uint32_t x = kBegin; x < kEnd; ++x) {
+                        acc0[x].ModAddFastEq(cji[x].ModMulFast(bji[x], q, mu), q);
+                        acc1[x].ModAddFastEq(cji[x].ModMulFast(aji[x], q, mu), q);
+                    }
+                }
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<std::vector<DCRTPoly>>> result(batch);
+    for (uint32_t k = 0; k < batch; ++k) {
+        result[k] = std::make_shared<std::vector<DCRTPoly>>(
+            std::initializer_list<DCRTPoly>{std::move(cTilda0[k]), std::move(cTilda1[k])});
+    }
+    return result;
+}
+
 Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchExt(ConstCiphertext<DCRTPoly> ciphertext, bool addFirst) const {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
 
-    const auto paramsQl  = cv[0].GetParams();
-    const auto paramsP   = cryptoParams->GetParamsP();
-    const auto paramsQlP = cv[0].GetExtendedCRTBasis(paramsP);
+    size_t sizeQl         = cv[0].GetNumOfElements();
+    const auto& paramsQlP = cryptoParams->GetParamsQlP(sizeQl - 1);
 
-    size_t sizeQl = paramsQl->GetParams().size();
-    usint sizeCv  = cv.size();
+    usint sizeCv = cv.size();
     std::vector<DCRTPoly> resultElements(sizeCv);
     for (usint k = 0; k < sizeCv; k++) {
         resultElements[k] = DCRTPoly(paramsQlP, Format::EVALUATION, true);
@@ -260,15 +417,8 @@ Ciphertext<DCRTPoly> KeySwitchHYBRID::KeySwitchDown(ConstCiphertext<DCRTPoly> ci
     const auto paramsP   = cryptoParams->GetParamsP();
     const auto paramsQlP = ciphertext->GetElements()[0].GetParams();
 
-    // TODO : (Andrey) precompute paramsQl in cryptoparameters
-    usint sizeQl = paramsQlP->GetParams().size() - paramsP->GetParams().size();
-    std::vector<NativeInteger> moduliQ(sizeQl);
-    std::vector<NativeInteger> rootsQ(sizeQl);
-    for (size_t i = 0; i < sizeQl; i++) {
-        moduliQ[i] = paramsQlP->GetParams()[i]->GetModulus();
-        rootsQ[i]  = paramsQlP->GetParams()[i]->GetRootOfUnity();
-    }
-    auto paramsQl = std::make_shared<typename DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
+    usint sizeQl         = paramsQlP->GetParams().size() - paramsP->GetParams().size();
+    const auto& paramsQl = cryptoParams->GetParamsQlHybrid(sizeQl - 1);
 
     auto cTilda = ciphertext->GetElements();
 
@@ -299,15 +449,8 @@ DCRTPoly KeySwitchHYBRID::KeySwitchDownFirstElement(ConstCiphertext<DCRTPoly> ci
     const auto paramsP   = cryptoParams->GetParamsP();
     const auto paramsQlP = cTilda[0].GetParams();
 
-    // TODO : (Andrey) precompute paramsQl in cryptoparameters
-    usint sizeQl = paramsQlP->GetParams().size() - paramsP->GetParams().size();
-    std::vector<NativeInteger> moduliQ(sizeQl);
-    std::vector<NativeInteger> rootsQ(sizeQl);
-    for (size_t i = 0; i < sizeQl; i++) {
-        moduliQ[i] = paramsQlP->GetParams()[i]->GetModulus();
-        rootsQ[i]  = paramsQlP->GetParams()[i]->GetRootOfUnity();
-    }
-    auto paramsQl = std::make_shared<typename DCRTPoly::Params>(2 * paramsQlP->GetRingDimension(), moduliQ, rootsQ);
+    usint sizeQl         = paramsQlP->GetParams().size() - paramsP->GetParams().size();
+    const auto& paramsQl = cryptoParams->GetParamsQlHybrid(sizeQl - 1);
 
     PlaintextModulus t = (cryptoParams->GetNoiseScale() == 1) ? 0 : cryptoParams->GetPlaintextModulus();
 
@@ -328,14 +471,14 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::KeySwitchCore(const DCRT
 
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeCore(
     const DCRTPoly& c, std::shared_ptr<CryptoParametersBase<DCRTPoly>> cryptoParamsBase) const {
+    VectorPoolScope poolScope;
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cryptoParamsBase);
 
-    const std::shared_ptr<ParmType> paramsQl  = c.GetParams();
-    const std::shared_ptr<ParmType> paramsP   = cryptoParams->GetParamsP();
-    const std::shared_ptr<ParmType> paramsQlP = c.GetExtendedCRTBasis(paramsP);
+    size_t sizeQl = c.GetNumOfElements();
+    size_t sizeP  = cryptoParams->GetParamsP()->GetParams().size();
+
+    const std::shared_ptr<ParmType>& paramsQlP = cryptoParams->GetParamsQlP(sizeQl - 1);
 
-    size_t sizeQl  = paramsQl->GetParams().size();
-    size_t sizeP   = paramsP->GetParams().size();
     size_t sizeQlP = sizeQl + sizeP;
 
     uint32_t alpha = cryptoParams->GetNumPerPartQ();
@@ -344,6 +487,12 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
     if (numPartQl > cryptoParams->GetNumberOfQPartitions())
         numPartQl = cryptoParams->GetNumberOfQPartitions();
 
+    // The input is brought to the coefficient domain once, by a single batched INTT of all of its
+    // towers, and the digits are cut from the result, so every tower of c is transformed exactly once
+    DCRTPoly cCoef = c.Clone();
+    cCoef.SetFormat(Format::COEFFICIENT);
+    auto& cCoefTowers = cCoef.GetAllElements();
+
     std::vector<DCRTPoly> partsCt(numPartQl);
 
     // Digit decomposition
@@ -364,48 +513,63 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
 
             auto params = DCRTPoly::Params(paramsPartQ->GetCyclotomicOrder(), moduli, roots);
 
-            partsCt[part] = DCRTPoly(std::make_shared<ParmType>(params), Format::EVALUATION, true);
+            partsCt[part] = DCRTPoly(std::make_shared<ParmType>(params), Format::COEFFICIENT, true);
         }
         else {
-            partsCt[part] = DCRTPoly(cryptoParams->GetParamsPartQ(part), Format::EVALUATION, true);
+            partsCt[part] = DCRTPoly(cryptoParams->GetParamsPartQ(part), Format::COEFFICIENT, true);
         }
 
+        // cCoef is not needed afterwards, so its towers are moved
         usint sizePartQl   = partsCt[part].GetNumOfElements();
         usint startPartIdx = alpha * part;
         for (uint32_t i = 0, idx = startPartIdx; i < sizePartQl; i++, idx++) {
-            partsCt[part].SetElementAtIndex(i, c.GetElementAtIndex(idx));
+            partsCt[part].SetElementAtIndex(i, std::move(cCoefTowers[idx]));
         }
     }
 
     std::vector<DCRTPoly> partsCtCompl(numPartQl);
-    std::vector<DCRTPoly> partsCtExt(numPartQl);
+    std::vector<DCRTPoly*> newTowers(numPartQl);
+    uint64_t sizeNewTowers = 0;
 
     for (uint32_t part = 0; part < numPartQl; part++) {
-        auto partCtClone = partsCt[part].Clone();
-        partCtClone.SetFormat(Format::COEFFICIENT);
-
         uint32_t sizePartQl = partsCt[part].GetNumOfElements();
-        partsCtCompl[part]  = partCtClone.ApproxSwitchCRTBasis(
+        partsCtCompl[part]  = partsCt[part].ApproxSwitchCRTBasis(
             cryptoParams->GetParamsPartQ(part), cryptoParams->GetParamsComplPartQ(sizeQl - 1, part),
             cryptoParams->GetPartQlHatInvModq(part, sizePartQl - 1),
             cryptoParams->GetPartQlHatInvModqPrecon(part, sizePartQl - 1),
             cryptoParams->GetPartQlHatModp(sizeQl - 1, part),
             cryptoParams->GetmodComplPartqBarrettMu(sizeQl - 1, part));
+        newTowers[part] = &partsCtCompl[part];
+        sizeNewTowers += partsCtCompl[part].GetNumOfElements();
+    }
+
+    // Only the towers generated by the basis extensions need an NTT; they are
+    // transformed for all digits by a single batched call
+    DCRTPoly::SwitchFormat(newTowers);
 
-        partsCtCompl[part].SetFormat(Format::EVALUATION);
+    tlsKeySwitchStats.modUps++;
+    tlsKeySwitchStats.inverseNTTs += sizeQl;
+    tlsKeySwitchStats.forwardNTTs += sizeNewTowers;
 
-        partsCtExt[part] = DCRTPoly(paramsQlP, Format::EVALUATION, true);
+    std::vector<DCRTPoly> partsCtExt(numPartQl);
+
+    for (uint32_t part = 0; part < numPartQl; part++) {
+        // the towers of the digit itself are still available in the evaluation domain from c;
+        // partsCtCompl[part] is not needed afterwards, so its towers are moved
+        partsCtExt[part] = DCRTPoly(paramsQlP, Format::EVALUATION);
 
+        usint sizePartQl   = partsCt[part].GetNumOfElements();
         usint startPartIdx = alpha * part;
         usint endPartIdx   = startPartIdx + sizePartQl;
+        auto& complTowers  = partsCtCompl[part].GetAllElements();
         for (usint i = 0; i < startPartIdx; i++) {
-            partsCtExt[part].SetElementAtIndex(i, partsCtCompl[part].GetElementAtIndex(i));
+            partsCtExt[part].SetElementAtIndex(i, std::move(complTowers[i]));
         }
-        for (usint i = startPartIdx, idx = 0; i < endPartIdx; i++, idx++) {
-            partsCtExt[part].SetElementAtIndex(i, partsCt[part].GetElementAtIndex(idx));
+        for (usint i = startPartIdx; i < endPartIdx; i++) {
+            partsCtExt[part].SetElementAtIndex(i, c.GetElementAtIndex(i));
         }
         for (usint i = endPartIdx; i < sizeQlP; ++i) {
-            partsCtExt[part].SetElementAtIndex(i, partsCtCompl[part].GetElementAtIndex(i - sizePartQl));
+            partsCtExt[part].SetElementAtIndex(i, std::move(complTowers[i - sizePartQl]));
         }
     }
 
@@ -415,6 +579,7 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalKeySwitchPrecomputeC
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
+    VectorPoolScope poolScope;
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
 
     std::shared_ptr<std::vector<DCRTPoly>> cTilda = EvalFastKeySwitchCoreExt(digits, evalKey, paramsQl);
@@ -439,9 +604,12 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCore(
 std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt(
     const std::shared_ptr<std::vector<DCRTPoly>> digits, const EvalKey<DCRTPoly> evalKey,
     const std::shared_ptr<ParmType> paramsQl) const {
-    const auto cryptoParams         = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
-    const std::vector<DCRTPoly>& bv = evalKey->GetBVector();
-    const std::vector<DCRTPoly>& av = evalKey->GetAVector();
+    VectorPoolScope poolScope;
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(evalKey->GetCryptoParameters());
+    // with a key kept in Montgomery form the products need no Barrett reduction
+    const bool montgomery           = evalKey->HasMontgomeryForm();
+    const std::vector<DCRTPoly>& bv = montgomery ? evalKey->GetMontgomeryBVector() : evalKey->GetBVector();
+    const std::vector<DCRTPoly>& av = montgomery ? evalKey->GetMontgomeryAVector() : evalKey->GetAVector();
 
     const std::shared_ptr<ParmType> paramsP   = cryptoParams->GetParamsP();
     const std::shared_ptr<ParmType> paramsQlP = (*digits)[0].GetParams();
@@ -453,6 +621,29 @@ std::shared_ptr<std::vector<DCRTPoly>> KeySwitchHYBRID::EvalFastKeySwitchCoreExt
     DCRTPoly cTilda0(paramsQlP, Format::EVALUATION, true);
     DCRTPoly cTilda1(paramsQlP, Format::EVALUATION, true);
 
+    if (montgomery) {
+        const uint32_t ringDim = paramsQlP->GetRingDimension();
+        for (usint i = 0; i < sizeQlP; i++) {
+            // the key towers are those of Q followed by those of P
+            const usint idx            = (i < sizeQl) ? i : sizeQ + (i - sizeQl);
+            const NativeInteger& q     = paramsQlP->GetParams()[i]->GetModulus();
+            const NativeInteger negInv = q.ComputeMontgomeryNegInv();
+            NativePoly& acc0           = cTilda0.GetAllElements()[i];
+            NativePoly& acc1           = cTilda1.GetAllElements()[i];
+            for (uint32_t j = 0; j < digits->size(); j++) {
+                const NativeVector& cji = (*digits)[j].GetElementAtIndex(i).GetValues();
+                const NativeVector& bji = bv[j].GetElementAtIndex(idx).GetValues();
+                const NativeVector& aji = av[j].GetElementAtIndex(idx).GetValues();
+                for (uint32_t x = 0; x < ringDim; ++x) {
+                    acc0[x].ModAddFastEq(cji[x].ModMulMontgomery(bji[x], q, negInv), q);
+                    acc1[x].ModAddFastEq(cji[x].ModMulMontgomery(aji[x], q, negInv), q);
+                }
+            }
+        }
+        return std::make_shared<std::vector<DCRTPoly>>(
+            std::initializer_list<DCRTPoly>{std::move(cTilda0), std::move(cTilda1)});
+    }
+
     for (uint32_t j = 0; j < digits->size(); j++) {
         const DCRTPoly& cj = (*digits)[j];
         const DCRTPoly& bj = bv[j];
@@ -323,35 +323,22 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalMult(ConstCiphertext<DCRTPoly> cipher
         cvMult[1] -= cvMult[2];
         cvMult[1] -= cvMult[0];
     }
-    else {  // if size of any of the ciphertexts > 2
-        std::vector<bool> isFirstAdd(cvMultSize, true);
-
-        for (size_t i = 0; i < cv1Size; i++) {
-            for (size_t j = 0; j < cv2Size; j++) {
-                if (isFirstAdd[i + j] == true) {
-                    cvMult[i + j]     = cv1[i] * cv2[j];
-                    isFirstAdd[i + j] = false;
-                }
-                else {
-                    cvMult[i + j] += cv1[i] * cv2[j];
-                }
-            }
-        }
-    }
-#else
-    std::vector<bool> isFirstAdd(cvMultSize, true);
-    for (size_t i = 0; i < cv1Size; i++) {
-        for (size_t j = 0; j < cv2Size; j++) {
-            if (isFirstAdd[i + j] == true) {
-                cvMult[i + j]     = cv1[i] * cv2[j];
-                isFirstAdd[i + j] = false;
-            }
-            else {
-                cvMult[i + j] += cv1[i] * cv2[j];
+    else  // if size of any of the ciphertexts > 2
+#endif
+    {
+        // every element of the tensor product, sum_{i+j=k} cv1[i] * cv2[j], is accumulated in one fused pass
+        // over each tower, so the products are never stored as separate polynomials
+        for (size_t k = 0; k < cvMultSize; k++) {
+            std::vector<const DCRTPoly*> operands;
+            std::vector<std::vector<const DCRTPoly*>> keys;
+            for (size_t i = (k < cv2Size) ? 0 : k - cv2Size + 1; i < cv1Size && i <= k; i++) {
+                operands.push_back(&cv1[i]);
+                keys.push_back({&cv2[k - i]});
             }
+            cvMult[k] = DCRTPoly(cv1[0].GetParams(), Format::EVALUATION, true);
+            DCRTPoly::MultiplyAccumulate(operands, keys, {&cvMult[k]});
         }
     }
-#endif
 
     if (cryptoParams->GetMultiplicationTechnique() == HPS) {
         for (size_t i = 0; i < cvMultSize; i++) {
@@ -815,11 +802,20 @@ Ciphertext<DCRTPoly> LeveledSHEBFVRNS::EvalFastRotation(ConstCiphertext<DCRTPoly
 
     uint32_t autoIndex = FindAutomorphismIndex(index, m);
 
-    auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    auto evalKeys          = cc->GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    const auto& evalKeyMap = *evalKeys;
     // verify if the key autoIndex exists in the evalKeyMap
     auto evalKeyIterator = evalKeyMap.find(autoIndex);
     if (evalKeyIterator == evalKeyMap.end()) {
-        OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
+        // a rotation without a dedicated key is composed from the base set: the first part reuses the digits,
+        // the others are applied to its result one after another
+        auto parts = FindRotationComposition(static_cast<int32_t>(index), m, evalKeyMap);
+        if (parts.empty())
+            return ciphertext->Clone();
+        auto result = EvalFastRotation(ciphertext, parts[0], m, digits);
+        for (size_t i = 1; i < parts.size(); ++i)
+            result = EvalAutomorphism(result, FindAutomorphismIndex(parts[i], m), evalKeyMap);
+        return result;
     }
     auto evalKey = evalKeyIterator->second;
 
@@ -68,6 +68,7 @@ KeyPair<DCRTPoly> PKEBFVRNS::KeyGenInternal(CryptoContext<DCRTPoly> cc, bool mak
             s = DCRTPoly(dgg, paramsPK, Format::EVALUATION);
             break;
         case UNIFORM_TERNARY:
+        case SPARSE_ENCAPSULATED:
             s = DCRTPoly(tug, paramsPK, Format::EVALUATION);
             break;
         case SPARSE_TERNARY:
@@ -0,0 +1,268 @@
+//==================================================================================
+// BSD 2-Clause License
+//
+// Copyright (c) 2014-2022, NJIT, Duality Technologies Inc. and other contributors
+//
+// All rights reserved.
+//
+// Author TPOC: contact@openfhe.org
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+//    list of conditions and the following disclaimer.
+//
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+//    this list of conditions and the following disclaimer in the documentation
+//    and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+// FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+// DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+// SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+// CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+// OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+// OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//==================================================================================
+
+/*
+  Memory-mapped storage of the CKKS bootstrapping precomputations
+ */
+
+#include "scheme/ckksrns/ckksrns-fhe.h"
+
+#include "cryptocontext.h"
+#include "cryptocontext-ser.h"
+#include "encoding/ckkspackedencoding.h"
+#include "scheme/ckksrns/ckksrns-cryptoparameters.h"
+#include "utils/mappedfile.h"
+
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace lbcrypto {
+
+namespace {
+
+constexpr char PRECOM_MAGIC[8]{'O', 'F', 'H', 'E', 'B', 'T', 'P', 'C'};
+constexpr uint32_t PRECOM_VERSION{1};
+
+// everything besides the bootstrapping parameters of a slot count that the plaintexts depend on
+struct ParameterSet {
+    uint32_t cyclotomicOrder{0};
+    std::vector<NativeInteger> moduliQ;
+    std::vector<NativeInteger> moduliP;
+    uint32_t scalingTechnique{0};
+    uint32_t secretKeyDist{0};
+
+    ParameterSet() = default;
+
+    explicit ParameterSet(const CryptoContextImpl<DCRTPoly>& cc) {
+        const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
+        cyclotomicOrder         = cc.GetCyclotomicOrder();
+        for (const auto& p : cryptoParams->GetElementParams()->GetParams())
+            moduliQ.push_back(p->GetModulus());
+        for (const auto& p : cryptoParams->GetParamsP()->GetParams())
+            moduliP.push_back(p->GetModulus());
+        scalingTechnique = cryptoParams->GetScalingTechnique();
+        secretKeyDist    = cryptoParams->GetSecretKeyDist();
+    }
+
+    bool operator==(const ParameterSet& rhs) const {
+        return cyclotomicOrder == rhs.cyclotomicOrder && moduliQ == rhs.moduliQ && moduliP == rhs.moduliP &&
+               scalingTechnique == rhs.scalingTechnique && secretKeyDist == rhs.secretKeyDist;
+    }
+
+    template <class Archive>
+    void serialize(Archive& ar) {
+        ar(cyclotomicOrder, moduliQ, moduliP, scalingTechnique, secretKeyDist);
+    }
+};
+
+// a plaintext with the shape of its element, but no values
+struct StoredPlaintext {
+    bool present{false};
+    DCRTPoly shape;
+    double scalingFactor{1};
+    uint32_t level{0};
+    uint32_t noiseScaleDeg{1};
+    uint32_t slots{0};
+
+    template <class Archive>
+    void serialize(Archive& ar) {
+        ar(present, shape, scalingFactor, level, noiseScaleDeg, slots);
+    }
+};
+
+struct StoredPrecom {
+    uint32_t dim1{0};
+    uint32_t slots{0};
+    std::vector<int32_t> paramsEnc;
+    std::vector<int32_t> paramsDec;
+    std::vector<StoredPlaintext> U0Pre;
+    std::vector<StoredPlaintext> U0hatTPre;
+    std::vector<std::vector<StoredPlaintext>> U0PreFFT;
+    std::vector<std::vector<StoredPlaintext>> U0hatTPreFFT;
+
+    template <class Archive>
+    void serialize(Archive& ar) {
+        ar(dim1, slots, paramsEnc, paramsDec, U0Pre, U0hatTPre, U0PreFFT, U0hatTPreFFT);
+    }
+};
+
+// describes the plaintexts of a precomputation and collects their elements in the order they are stored
+std::vector<StoredPlaintext> Describe(const std::vector<ConstPlaintext>& plaintexts, std::vector<const DCRTPoly*>& elements) {
+    std::vector<StoredPlaintext> descriptions(plaintexts.size());
+    for (size_t i = 0; i < plaintexts.size(); ++i) {
+        const auto& pt = plaintexts[i];
+        if (pt == nullptr)
+            continue;
+        const auto& element = pt->GetElement<DCRTPoly>();
+        auto& d             = descriptions[i];
+        d.present           = true;
+        d.shape             = DCRTPoly(element.GetParams(), element.GetFormat(), false);
+        d.scalingFactor     = pt->GetScalingFactor();
+        d.level             = pt->GetLevel();
+        d.noiseScaleDeg     = pt->GetNoiseScaleDeg();
+        d.slots             = pt->GetSlots();
+        elements.push_back(&element);
+    }
+    return descriptions;
+}
+
+StoredPrecom Describe(const CKKSBootstrapPrecom& precom, std::vector<const DCRTPoly*>& elements) {
+    StoredPrecom stored;
+    stored.dim1      = precom.m_dim1;
+    stored.slots     = precom.m_slots;
+    stored.paramsEnc = precom.m_paramsEnc;
+    stored.paramsDec = precom.m_paramsDec;
+    stored.U0Pre     = Describe(precom.m_U0Pre, elements);
+    stored.U0hatTPre = Describe(precom.m_U0hatTPre, elements);
+    for (const auto& level : precom.m_U0PreFFT)
+        stored.U0PreFFT.push_back(Describe(level, elements));
+    for (const auto& level : precom.m_U0hatTPreFFT)
+        stored.U0hatTPreFFT.push_back(Describe(level, elements));
+    return stored;
+}
+
+// plaintexts whose elements are views of the stored values starting at the given offset
+std::vector<ConstPlaintext> Attach(const CryptoContextImpl<DCRTPoly>& cc,
+                                   const std::vector<StoredPlaintext>& descriptions, const uint8_t* data,
+                                   const std::shared_ptr<const uint8_t>& mapping, uint64_t dataSize,
+                                   uint64_t& offset) {
+    std::vector<ConstPlaintext> plaintexts(descriptions.size());
+    for (size_t i = 0; i < descriptions.size(); ++i) {
+        const auto& d = descriptions[i];
+        if (!d.present)
+            continue;
+        auto pt = std::make_shared<CKKSPackedEncoding>(d.shape.GetParams(), cc.GetEncodingParams());
+        pt->GetElement<DCRTPoly>() = AttachMapped(d.shape, data, mapping, dataSize, offset);
+        pt->SetScalingFactor(d.scalingFactor);
+        pt->SetLevel(d.level);
+        pt->SetNoiseScaleDeg(d.noiseScaleDeg);
+        pt->SetSlots(d.slots);
+        plaintexts[i] = pt;
+    }
+    return plaintexts;
+}
+
+std::shared_ptr<CKKSBootstrapPrecom> Attach(const CryptoContextImpl<DCRTPoly>& cc, const StoredPrecom& stored,
+                                            const uint8_t* data, const std::shared_ptr<const uint8_t>& mapping,
+                                            uint64_t dataSize, uint64_t& offset) {
+    auto precom         = std::make_shared<CKKSBootstrapPrecom>();
+    precom->m_dim1      = stored.dim1;
+    precom->m_slots     = stored.slots;
+    precom->m_paramsEnc = stored.paramsEnc;
+    precom->m_paramsDec = stored.paramsDec;
+    precom->m_U0Pre     = Attach(cc, stored.U0Pre, data, mapping, dataSize, offset);
+    precom->m_U0hatTPre = Attach(cc, stored.U0hatTPre, data, mapping, dataSize, offset);
+    for (const auto& level : stored.U0PreFFT)
+        precom->m_U0PreFFT.push_back(Attach(cc, level, data, mapping, dataSize, offset));
+    for (const auto& level : stored.U0hatTPreFFT)
+        precom->m_U0hatTPreFFT.push_back(Attach(cc, level, data, mapping, dataSize, offset));
+    return precom;
+}
+
+bool IsPrecomputed(const CKKSBootstrapPrecom& precom) {
+    return !precom.m_U0Pre.empty() || !precom.m_U0PreFFT.empty();
+}
+
+}  // namespace
+
+void FHECKKSRNS::SaveBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc, const std::string& filename,
+                                             uint32_t slots) const {
+    std::vector<StoredPrecom> entries;
+    std::vector<const DCRTPoly*> elements;
+    for (const auto& [s, precom] : m_bootPrecomMap) {
+        if ((slots == 0 || s == slots) && precom != nullptr && IsPrecomputed(*precom))
+            entries.push_back(Describe(*precom, elements));
+    }
+    if (entries.empty()) {
+        std::string errorMsg(std::string("Precomputations for ") + (slots ? std::to_string(slots) : "any number of") +
+                             std::string(" slots were not generated") +
+                             std::string(" Need to call EvalBootstrapSetup and EvalBootstrapPrecompute to proceed"));
+        OPENFHE_THROW(errorMsg);
+    }
+
+    std::stringstream description;
+    Serial::Serialize(ParameterSet(cc), description, SerType::BINARY);
+    Serial::Serialize(m_correctionFactor, description, SerType::BINARY);
+    Serial::Serialize(entries, description, SerType::BINARY);
+
+    uint64_t dataSize{0};
+    for (const auto* element : elements)
+        dataSize += MappedSize(*element);
+
+    std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+        OPENFHE_THROW("Can not open " + filename);
+    WriteMappedFileHeader(file, PRECOM_MAGIC, PRECOM_VERSION, sizeof(NativeInteger), description.str(), dataSize);
+    for (const auto* element : elements)
+        WriteMapped(file, *element);
+    if (!file)
+        OPENFHE_THROW("Error writing the bootstrapping precomputations to " + filename);
+}
+
+void FHECKKSRNS::LoadBootstrapPrecomputation(const CryptoContextImpl<DCRTPoly>& cc, const std::string& filename) {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
+
+    if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
+        OPENFHE_THROW("CKKS Bootstrapping is only supported for the Hybrid key switching method.");
+
+    uint64_t size{0};
+    auto mapping = MapFile(filename, size);
+    auto header  = ReadMappedFileHeader(filename, mapping.get(), size, PRECOM_MAGIC, PRECOM_VERSION,
+                                        sizeof(NativeInteger), "bootstrapping precomputation file");
+
+    ParameterSet parameters;
+    uint32_t correctionFactor{0};
+    std::vector<StoredPrecom> entries;
+    std::istringstream description(
+        std::string(reinterpret_cast<const char*>(mapping.get()) + sizeof(header), header.descriptionSize));
+    Serial::Deserialize(parameters, description, SerType::BINARY);
+    if (!(parameters == ParameterSet(cc)))
+        OPENFHE_THROW(filename + " was written for a different parameter set");
+    Serial::Deserialize(correctionFactor, description, SerType::BINARY);
+    Serial::Deserialize(entries, description, SerType::BINARY);
+
+    const uint8_t* data = mapping.get() + header.dataOffset;
+    uint64_t offset{0};
+    std::vector<std::shared_ptr<CKKSBootstrapPrecom>> precoms;
+    for (const auto& stored : entries)
+        precoms.push_back(Attach(cc, stored, data, mapping, header.dataSize, offset));
+    if (offset != header.dataSize)
+        OPENFHE_THROW("the bootstrapping precomputation file " + filename + " does not match its description");
+
+    for (const auto& precom : precoms)
+        m_bootPrecomMap[precom->m_slots] = precom;
+    m_correctionFactor = correctionFactor;
+}
+
+}  // namespace lbcrypto
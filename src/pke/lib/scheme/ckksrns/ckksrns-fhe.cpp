@@ -33,6 +33,7 @@
 
 #include "scheme/ckksrns/ckksrns-fhe.h"
 
+#include "key/evalkeyrelin.h"
 #include "key/privatekey.h"
 #include "scheme/ckksrns/ckksrns-cryptoparameters.h"
 #include "schemebase/base-scheme.h"
@@ -49,19 +50,156 @@
 #include "utils/utilities.h"
 #include "scheme/ckksrns/ckksrns-utils.h"
 
+#include <algorithm>
 #include <cmath>
+#include <exception>
+#include <functional>
+#include <future>
 #include <memory>
+#include <set>
+#include <utility>
 #include <vector>
 
 namespace lbcrypto {
 
+namespace {
+
+// Hands out the plaintexts of a lazily encoded linear transform one level at a time, in the order the
+// levels are evaluated. The next level is encoded on a worker thread while the current one is evaluated,
+// so at most two levels of plaintexts exist at any time. encode(s, parallel) encodes level s; the worker
+// runs it sequentially, as an OpenMP team of its own would compete with the one evaluating the level.
+class LazyLevelEncoder {
+public:
+    LazyLevelEncoder(std::function<std::vector<ConstPlaintext>(int32_t, bool)> encode, int32_t step, int32_t end)
+        : m_encode(std::move(encode)), m_step(step), m_end(end) {}
+
+    const std::vector<ConstPlaintext>& Get(int32_t s) {
+        m_current = m_next.valid() ? m_next.get() : m_encode(s, true);
+        if (s + m_step != m_end)
+            m_next = std::async(std::launch::async, m_encode, s + m_step, false);
+        return m_current;
+    }
+
+private:
+    std::function<std::vector<ConstPlaintext>(int32_t, bool)> m_encode;
+    int32_t m_step;
+    int32_t m_end;
+    std::vector<ConstPlaintext> m_current;
+    // declared last so that a pending encoding is waited for before anything it uses is destroyed
+    std::future<std::vector<ConstPlaintext>> m_next;
+};
+
+// With sparse-secret encapsulation the modulus raising runs under a sparse secret, so the approximate
+// modular reduction is the one for sparse secrets
+bool IsSparseBootstrap(SecretKeyDist secretKeyDist) {
+    return secretKeyDist == SPARSE_TERNARY || secretKeyDist == SPARSE_ENCAPSULATED;
+}
+
+// The dense-to-sparse encapsulation key is only applied to the first tower of a ciphertext, so it is generated
+// over {q_0, p} instead of Q*P, where p is an NTT-friendly prime of the size of q_0 that is neither in Q nor in P.
+// Its modulus of about 2*log2(q_0) bits is what keeps an RLWE sample under the sparse secret secure.
+std::shared_ptr<DCRTPoly::Params> GetEncapsulationParams(const std::shared_ptr<CryptoParametersCKKSRNS>& cryptoParams) {
+    const auto& towerQ0 = cryptoParams->GetElementParams()->GetParams()[0];
+    const uint32_t m    = towerQ0->GetCyclotomicOrder();
+
+    std::set<NativeInteger> used;
+    for (const auto& tower : cryptoParams->GetElementParams()->GetParams())
+        used.insert(tower->GetModulus());
+    if (cryptoParams->GetParamsP() != nullptr) {
+        for (const auto& tower : cryptoParams->GetParamsP()->GetParams())
+            used.insert(tower->GetModulus());
+    }
+
+    auto p = LastPrime<NativeInteger>(towerQ0->GetModulus().GetMSB(), m);
+    while (used.find(p) != used.end())
+        p = PreviousPrime<NativeInteger>(p, m);
+
+    std::vector<NativeInteger> moduli{towerQ0->GetModulus(), p};
+    std::vector<NativeInteger> roots{towerQ0->GetRootOfUnity(), RootOfUnity<NativeInteger>(m, p)};
+    return std::make_shared<DCRTPoly::Params>(m, moduli, roots);
+}
+
+// the centered representatives of the coefficients of x, a tower for q_0 in COEFFICIENT format, in {q_0, p}
+DCRTPoly ExtendToEncapsulationParams(const NativePoly& x, const std::shared_ptr<DCRTPoly::Params>& paramsQ0P) {
+    const auto& towerP = paramsQ0P->GetParams()[1];
+    auto xp            = x;
+    xp.SwitchModulus(towerP->GetModulus(), towerP->GetRootOfUnity(), 0, 0);
+
+    DCRTPoly result(paramsQ0P, Format::COEFFICIENT, true);
+    result.SetElementAtIndex(0, x);
+    result.SetElementAtIndex(1, std::move(xp));
+    result.SetFormat(Format::EVALUATION);
+    return result;
+}
+
+// Switches a ciphertext with one tower from the main secret to the ephemeral sparse secret with the key over
+// {q_0, p}: c_1 is extended to {q_0, p} and multiplied by the key, and the products are divided by p, as in
+// hybrid key switching with one digit.
+void KeySwitchToSparseInPlace(Ciphertext<DCRTPoly>& ciphertext, const EvalKey<DCRTPoly>& evalKey) {
+    std::vector<DCRTPoly>& cv = ciphertext->GetElements();
+
+    const DCRTPoly& a             = evalKey->GetAVector()[0];
+    const DCRTPoly& b             = evalKey->GetBVector()[0];
+    const auto paramsQ0P          = b.GetParams();
+    const auto& towerQ0           = paramsQ0P->GetParams()[0];
+    const NativeInteger pInvModq0 = paramsQ0P->GetParams()[1]->GetModulus().ModInverse(towerQ0->GetModulus());
+
+    NativePoly c1 = cv[1].GetElementAtIndex(0);
+    c1.SetFormat(Format::COEFFICIENT);
+    const DCRTPoly c1Ext = ExtendToEncapsulationParams(c1, paramsQ0P);
+
+    // (x mod q_0 - [x]_p) / p mod q_0, where [x]_p is the centered representative of x mod p
+    auto modDown = [&](DCRTPoly x) {
+        x.SetFormat(Format::COEFFICIENT);
+        NativePoly xp = x.GetElementAtIndex(1);
+        xp.SwitchModulus(towerQ0->GetModulus(), towerQ0->GetRootOfUnity(), 0, 0);
+        NativePoly result = x.GetElementAtIndex(0) - xp;
+        result *= pInvModq0;
+        result.SetFormat(Format::EVALUATION);
+        return result;
+    };
+
+    cv[0].SetElementAtIndex(0, cv[0].GetElementAtIndex(0) + modDown(c1Ext * b));
+    cv[1].SetElementAtIndex(0, modDown(c1Ext * a));
+}
+
+// Calls f(i) for every i in [0, n), e.g. for every ciphertext of a batch, in parallel if requested. Exceptions
+// cannot leave an OpenMP region, so in the parallel loop the first one thrown is kept and rethrown after it.
+template <typename F>
+void ForEachIndex(uint32_t n, bool parallel, F f) {
+    if (parallel) {
+        std::exception_ptr error;
+#pragma omp parallel for num_threads(OpenFHEParallelControls.GetThreadLimit(n))
+        for (uint32_t i = 0; i < n; ++i) {
+            try {
+                f(i);
+            }
+            catch (...) {
+#pragma omp critical
+                {
+                    if (!error)
+                        error = std::current_exception();
+                }
+            }
+        }
+        if (error)
+            std::rethrow_exception(error);
+    }
+    else {
+        for (uint32_t i = 0; i < n; ++i)
+            f(i);
+    }
+}
+
+}  // namespace
+
 //------------------------------------------------------------------------------
 // Bootstrap Wrapper
 //------------------------------------------------------------------------------
 
 void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::vector<uint32_t> levelBudget,
                                     std::vector<uint32_t> dim1, uint32_t numSlots, uint32_t correctionFactor,
-                                    bool precompute) {
+                                    bool precompute, bool lazyEncoding) {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
@@ -161,7 +299,7 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
 
         uint128_t factor = ((uint128_t)1 << ((uint32_t)std::round(std::log2(qDouble))));
         double pre       = qDouble / factor;
-        double k         = (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ? K_SPARSE : 1.0;
+        double k         = IsSparseBootstrap(cryptoParams->GetSecretKeyDist()) ? K_SPARSE : 1.0;
         double scaleEnc  = pre / k;
         double scaleDec  = 1 / pre;
 
@@ -206,14 +344,16 @@ void FHECKKSRNS::EvalBootstrapSetup(const CryptoContextImpl<DCRTPoly>& cc, std::
             }
         }
         else {
-            precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
-            precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec);
+            auto encDiag           = lazyEncoding ? &precom->m_U0hatTPreDiag : nullptr;
+            auto decDiag           = lazyEncoding ? &precom->m_U0PreDiag : nullptr;
+            precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc, encDiag);
+            precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec, decDiag);
         }
     }
 }
 
 std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapKeyGen(
-    const PrivateKey<DCRTPoly> privateKey, uint32_t slots) {
+    const PrivateKey<DCRTPoly> privateKey, uint32_t slots, uint64_t memoryBudget) {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(privateKey->GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
@@ -228,16 +368,73 @@ std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> FHECKKSRNS::EvalBootstrapKey
     if (slots == 0)
         slots = M / 4;
     // computing all indices for baby-step giant-step procedure
-    auto algo     = cc->GetScheme();
-    auto evalKeys = algo->EvalAtIndexKeyGen(nullptr, privateKey, FindBootstrapRotationIndices(slots, M));
+    auto algo = cc->GetScheme();
+    // under a memory budget, rotations without a dedicated key are composed from the base set
+    std::shared_ptr<std::map<usint, EvalKey<DCRTPoly>>> evalKeys;
+    if (memoryBudget != 0) {
+        evalKeys = algo->EvalAtIndexBaseKeyGen(privateKey, FindBootstrapRotationIndices(slots, M), memoryBudget);
+    }
+    else {
+        evalKeys = algo->EvalAtIndexKeyGen(nullptr, privateKey, FindBootstrapRotationIndices(slots, M));
 
-    auto conjKey       = ConjugateKeyGen(privateKey);
-    (*evalKeys)[M - 1] = conjKey;
+        auto conjKey       = ConjugateKeyGen(privateKey);
+        (*evalKeys)[M - 1] = conjKey;
+    }
 
     return evalKeys;
 }
 
-void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc, uint32_t numSlots) {
+std::vector<EvalKey<DCRTPoly>> FHECKKSRNS::EvalEncapsulationKeyGen(const PrivateKey<DCRTPoly> privateKey) {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(privateKey->GetCryptoParameters());
+    if (cryptoParams->GetSecretKeyDist() != SPARSE_ENCAPSULATED)
+        return {};
+
+    auto cc = privateKey->GetCryptoContext();
+
+    // the ephemeral sparse secret only exists inside these two keys
+    DCRTPoly::TugType tug;
+    auto sparseKey = std::make_shared<PrivateKeyImpl<DCRTPoly>>(cc);
+    sparseKey->SetPrivateElement(
+        DCRTPoly(tug, cryptoParams->GetElementParams(), Format::EVALUATION, H_SPARSE_ENCAPSULATED));
+
+    // dense to sparse: b = -a * s_sparse + e + p * s_dense over {q_0, p}. A key over Q*P would be an RLWE
+    // sample under the sparse secret at the full modulus (and give away P * s_dense there).
+    const auto paramsQ0P = GetEncapsulationParams(cryptoParams);
+    auto extend          = [&paramsQ0P](const DCRTPoly& s) {
+        NativePoly s0 = s.GetElementAtIndex(0);
+        s0.SetFormat(Format::COEFFICIENT);
+        return ExtendToEncapsulationParams(s0, paramsQ0P);
+    };
+    const DCRTPoly sDense  = extend(privateKey->GetPrivateElement());
+    const DCRTPoly sSparse = extend(sparseKey->GetPrivateElement());
+
+    DCRTPoly::DugType dug;
+    DCRTPoly a(dug, paramsQ0P, Format::EVALUATION);
+    DCRTPoly e(cryptoParams->GetDiscreteGaussianGenerator(), paramsQ0P, Format::EVALUATION);
+    // p * s_dense vanishes mod p
+    const NativeInteger& q0 = paramsQ0P->GetParams()[0]->GetModulus();
+    DCRTPoly pDense(paramsQ0P, Format::EVALUATION, true);
+    pDense.SetElementAtIndex(0, sDense.GetElementAtIndex(0).Times(paramsQ0P->GetParams()[1]->GetModulus().Mod(q0)));
+
+    DCRTPoly b = e - a * sSparse + pDense;
+
+    auto denseToSparse = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(cc);
+    denseToSparse->SetAVector({std::move(a)});
+    denseToSparse->SetBVector({std::move(b)});
+    denseToSparse->SetKeyTag(privateKey->GetKeyTag());
+
+    // sparse to dense: an encryption under the main secret, which is as secure as any other switching key
+    auto sparseToDense = cc->GetScheme()->KeySwitchGen(sparseKey, privateKey);
+    sparseToDense->SetKeyTag(privateKey->GetKeyTag());
+
+    std::vector<EvalKey<DCRTPoly>> keys(CKKS_ENCAPSULATION_KEYS::TOTAL_ELEMENTS);
+    keys[CKKS_ENCAPSULATION_KEYS::DENSE_TO_SPARSE] = std::move(denseToSparse);
+    keys[CKKS_ENCAPSULATION_KEYS::SPARSE_TO_DENSE] = std::move(sparseToDense);
+    return keys;
+}
+
+void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc, uint32_t numSlots,
+                                         bool lazyEncoding) {
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(cc.GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
@@ -287,7 +484,7 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
 
     uint128_t factor = ((uint128_t)1 << ((uint32_t)std::round(std::log2(qDouble))));
     double pre       = qDouble / factor;
-    double k         = (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) ? K_SPARSE : 1.0;
+    double k         = IsSparseBootstrap(cryptoParams->GetSecretKeyDist()) ? K_SPARSE : 1.0;
     double scaleEnc  = pre / k;
     double scaleDec  = 1 / pre;
 
@@ -332,14 +529,46 @@ void FHECKKSRNS::EvalBootstrapPrecompute(const CryptoContextImpl<DCRTPoly>& cc,
         }
     }
     else {
-        precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc);
-        precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec);
+        // with lazy encoding, the plaintexts are encoded from the diagonals in EvalCoeffsToSlots and EvalSlotsToCoeffs
+        precom->m_U0hatTPreDiag.clear();
+        precom->m_U0PreDiag.clear();
+        auto encDiag           = lazyEncoding ? &precom->m_U0hatTPreDiag : nullptr;
+        auto decDiag           = lazyEncoding ? &precom->m_U0PreDiag : nullptr;
+        precom->m_U0hatTPreFFT = EvalCoeffsToSlotsPrecompute(cc, ksiPows, rotGroup, false, scaleEnc, lEnc, encDiag);
+        precom->m_U0PreFFT     = EvalSlotsToCoeffsPrecompute(cc, ksiPows, rotGroup, false, scaleDec, lDec, decDiag);
     }
 }
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphertext, uint32_t numIterations,
                                                uint32_t precision) const {
-    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+    return EvalBootstrapInternal({ciphertext}, numIterations, precision)[0];
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalBootstrapBatch(const std::vector<Ciphertext<DCRTPoly>>& ciphertexts,
+                                                                 uint32_t numIterations, uint32_t precision) const {
+    if (ciphertexts.empty())
+        return {};
+
+    const auto& first = ciphertexts[0];
+    for (const auto& ciphertext : ciphertexts) {
+        if (ciphertext->GetCryptoContext() != first->GetCryptoContext())
+            OPENFHE_THROW("All ciphertexts bootstrapped in a batch must use the same crypto context.");
+        if (ciphertext->GetKeyTag() != first->GetKeyTag())
+            OPENFHE_THROW("All ciphertexts bootstrapped in a batch must be encrypted with the same key.");
+        if (ciphertext->GetSlots() != first->GetSlots())
+            OPENFHE_THROW("All ciphertexts bootstrapped in a batch must have the same number of slots.");
+        if (ciphertext->GetElements()[0].GetNumOfElements() != first->GetElements()[0].GetNumOfElements())
+            OPENFHE_THROW("All ciphertexts bootstrapped in a batch must be at the same level.");
+    }
+
+    return EvalBootstrapInternal(std::vector<ConstCiphertext<DCRTPoly>>(ciphertexts.begin(), ciphertexts.end()),
+                                 numIterations, precision);
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalBootstrapInternal(
+    const std::vector<ConstCiphertext<DCRTPoly>>& ciphertexts, uint32_t numIterations, uint32_t precision) const {
+    const auto cryptoParams =
+        std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertexts[0]->GetCryptoParameters());
 
     if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
         OPENFHE_THROW("CKKS Bootstrapping is only supported for the Hybrid key switching method.");
@@ -351,17 +580,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         OPENFHE_THROW("CKKS Iterative Bootstrapping is only supported for 1 or 2 iterations.");
     }
 
-#ifdef BOOTSTRAPTIMING
-    TimeVar t;
-    double timeEncode(0.0);
-    double timeModReduce(0.0);
-    double timeDecode(0.0);
-#endif
-
-    auto cc        = ciphertext->GetCryptoContext();
-    uint32_t M     = cc->GetCyclotomicOrder();
-    uint32_t L0    = cryptoParams->GetElementParams()->GetParams().size();
-    auto initSizeQ = ciphertext->GetElements()[0].GetNumOfElements();
+    auto cc              = ciphertexts[0]->GetCryptoContext();
+    auto algo            = cc->GetScheme();
+    uint32_t M           = cc->GetCyclotomicOrder();
+    uint32_t L0          = cryptoParams->GetElementParams()->GetParams().size();
+    auto initSizeQ       = ciphertexts[0]->GetElements()[0].GetNumOfElements();
+    const uint32_t batch = ciphertexts.size();
 
     if (numIterations > 1) {
         // Step 1: Get the input.
@@ -369,48 +593,63 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
         // Step 2: Scale up by powerOfTwoModulus, and extend the modulus to powerOfTwoModulus * q.
         // Note that we extend the modulus implicitly without any code calls because the value always stays 0.
-        Ciphertext<DCRTPoly> ctScaledUp = ciphertext->Clone();
-        // We multiply by powerOfTwoModulus, and leave the last CRT value to be 0 (mod powerOfTwoModulus).
-        cc->GetScheme()->MultByIntegerInPlace(ctScaledUp, powerOfTwoModulus);
-        ctScaledUp->SetLevel(L0 - ctScaledUp->GetElements()[0].GetNumOfElements());
-
-        // Step 3: Bootstrap the initial ciphertext.
-        auto ctInitialBootstrap = cc->EvalBootstrap(ciphertext, numIterations - 1, precision);
-        cc->GetScheme()->ModReduceInternalInPlace(ctInitialBootstrap, BASE_NUM_LEVELS_TO_DROP);
-
-        // Step 4: Scale up by powerOfTwoModulus.
-        cc->GetScheme()->MultByIntegerInPlace(ctInitialBootstrap, powerOfTwoModulus);
-
-        // Step 5: Mod-down to powerOfTwoModulus * q
-        // We mod down, and leave the last CRT value to be 0 because it's divisible by powerOfTwoModulus.
-        auto ctBootstrappedScaledDown = ctInitialBootstrap->Clone();
-        auto bootstrappingSizeQ       = ctBootstrappedScaledDown->GetElements()[0].GetNumOfElements();
+        std::vector<Ciphertext<DCRTPoly>> ctScaledUp(batch);
+        for (uint32_t i = 0; i < batch; ++i) {
+            ctScaledUp[i] = ciphertexts[i]->Clone();
+            // We multiply by powerOfTwoModulus, and leave the last CRT value to be 0 (mod powerOfTwoModulus).
+            algo->MultByIntegerInPlace(ctScaledUp[i], powerOfTwoModulus);
+            ctScaledUp[i]->SetLevel(L0 - ctScaledUp[i]->GetElements()[0].GetNumOfElements());
+        }
+
+        // Step 3: Bootstrap the initial ciphertexts.
+        auto ctInitialBootstrap = EvalBootstrapInternal(ciphertexts, numIterations - 1, precision);
+
+        std::vector<ConstCiphertext<DCRTPoly>> ctBootstrappingError(batch);
+        for (uint32_t i = 0; i < batch; ++i) {
+            algo->ModReduceInternalInPlace(ctInitialBootstrap[i], BASE_NUM_LEVELS_TO_DROP);
+
+            // Step 4: Scale up by powerOfTwoModulus.
+            algo->MultByIntegerInPlace(ctInitialBootstrap[i], powerOfTwoModulus);
+
+            // Step 5: Mod-down to powerOfTwoModulus * q
+            // We mod down, and leave the last CRT value to be 0 because it's divisible by powerOfTwoModulus.
+            auto ctBootstrappedScaledDown = ctInitialBootstrap[i]->Clone();
+            auto bootstrappingSizeQ       = ctBootstrappedScaledDown->GetElements()[0].GetNumOfElements();
+
+            // If we start with more towers, than we obtain from bootstrapping, return the original ciphertexts.
+            // All ciphertexts are at the same level, so this holds for all of them or for none.
+            if (bootstrappingSizeQ <= initSizeQ) {
+                std::vector<Ciphertext<DCRTPoly>> result(batch);
+                for (uint32_t j = 0; j < batch; ++j)
+                    result[j] = ciphertexts[j]->Clone();
+                return result;
+            }
+            for (auto& cv : ctBootstrappedScaledDown->GetElements()) {
+                cv.DropLastElements(bootstrappingSizeQ - initSizeQ);
+            }
+            ctBootstrappedScaledDown->SetLevel(L0 - ctBootstrappedScaledDown->GetElements()[0].GetNumOfElements());
 
-        // If we start with more towers, than we obtain from bootstrapping, return the original ciphertext.
-        if (bootstrappingSizeQ <= initSizeQ) {
-            return ciphertext->Clone();
-        }
-        for (auto& cv : ctBootstrappedScaledDown->GetElements()) {
-            cv.DropLastElements(bootstrappingSizeQ - initSizeQ);
+            // Step 6 and 7: Calculate the bootstrapping error by subtracting the original ciphertext from the bootstrapped ciphertext. Mod down to q is done implicitly.
+            ctBootstrappingError[i] = cc->EvalSub(ctBootstrappedScaledDown, ctScaledUp[i]);
         }
-        ctBootstrappedScaledDown->SetLevel(L0 - ctBootstrappedScaledDown->GetElements()[0].GetNumOfElements());
 
-        // Step 6 and 7: Calculate the bootstrapping error by subtracting the original ciphertext from the bootstrapped ciphertext. Mod down to q is done implicitly.
-        auto ctBootstrappingError = cc->EvalSub(ctBootstrappedScaledDown, ctScaledUp);
+        // Step 8: Bootstrap the errors.
+        auto ctBootstrappedError = EvalBootstrapInternal(ctBootstrappingError, 1, 0);
 
-        // Step 8: Bootstrap the error.
-        auto ctBootstrappedError = cc->EvalBootstrap(ctBootstrappingError, 1, 0);
-        cc->GetScheme()->ModReduceInternalInPlace(ctBootstrappedError, BASE_NUM_LEVELS_TO_DROP);
+        std::vector<Ciphertext<DCRTPoly>> finalCiphertexts(batch);
+        for (uint32_t i = 0; i < batch; ++i) {
+            algo->ModReduceInternalInPlace(ctBootstrappedError[i], BASE_NUM_LEVELS_TO_DROP);
 
-        // Step 9: Subtract the bootstrapped error from the initial bootstrap to get even lower error.
-        auto finalCiphertext = cc->EvalSub(ctInitialBootstrap, ctBootstrappedError);
+            // Step 9: Subtract the bootstrapped error from the initial bootstrap to get even lower error.
+            finalCiphertexts[i] = cc->EvalSub(ctInitialBootstrap[i], ctBootstrappedError[i]);
 
-        // Step 10: Scale back down by powerOfTwoModulus to get the original message.
-        cc->EvalMultInPlace(finalCiphertext, static_cast<double>(1) / powerOfTwoModulus);
-        return finalCiphertext;
+            // Step 10: Scale back down by powerOfTwoModulus to get the original message.
+            cc->EvalMultInPlace(finalCiphertexts[i], static_cast<double>(1) / powerOfTwoModulus);
+        }
+        return finalCiphertexts;
     }
 
-    uint32_t slots = ciphertext->GetSlots();
+    uint32_t slots = ciphertexts[0]->GetSlots();
 
     auto pair = m_bootPrecomMap.find(slots);
     if (pair == m_bootPrecomMap.end()) {
@@ -420,7 +659,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         OPENFHE_THROW(errorMsg);
     }
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
-    size_t N                                          = cc->GetRingDimension();
 
     auto elementParamsRaised = *(cryptoParams->GetElementParams());
 
@@ -460,6 +698,10 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     double pre      = 1. / post;
     uint64_t scalar = std::llround(post);
 
+    // A bootstrapping is parallel across the towers of the raised ciphertext internally. When there are more
+    // threads than towers, the spare threads are used by bootstrapping several ciphertexts at once instead.
+    const bool acrossBatch = batch > 1 && static_cast<uint32_t>(OpenFHEParallelControls.GetMachineThreads()) > sizeQ;
+
     //------------------------------------------------------------------------------
     // RAISING THE MODULUS
     //------------------------------------------------------------------------------
@@ -470,31 +712,84 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     // it's being raised to.
     // Increasing the modulus
 
-    Ciphertext<DCRTPoly> raised = ciphertext->Clone();
-    auto algo                   = cc->GetScheme();
-    algo->ModReduceInternalInPlace(raised, raised->GetNoiseScaleDeg() - 1);
+    std::vector<Ciphertext<DCRTPoly>> raised(batch);
+    ForEachIndex(batch, acrossBatch, [&](uint32_t i) {
+        raised[i] = ciphertexts[i]->Clone();
+        algo->ModReduceInternalInPlace(raised[i], raised[i]->GetNoiseScaleDeg() - 1);
+        AdjustCiphertext(raised[i], correction);
+    });
+
+    // With sparse-secret encapsulation, the modulus is raised under the ephemeral sparse secret, for which the
+    // overflows are much smaller. Only the first tower is raised, so it is the only one switched to that secret,
+    // with a key over q_0 and one auxiliary prime. Switching back at the raised modulus is batched.
+    const bool encapsulated = (cryptoParams->GetSecretKeyDist() == SPARSE_ENCAPSULATED);
+    std::vector<EvalKey<DCRTPoly>> encapsulationKeys;
+    if (encapsulated) {
+        encapsulationKeys = cc->GetEvalEncapsulationKeyVector(raised[0]->GetKeyTag());
+        ForEachIndex(batch, acrossBatch, [&](uint32_t k) {
+            for (auto& cv : raised[k]->GetElements())
+                cv.DropLastElements(cv.GetNumOfElements() - 1);
+            KeySwitchToSparseInPlace(raised[k], encapsulationKeys[CKKS_ENCAPSULATION_KEYS::DENSE_TO_SPARSE]);
+        });
+    }
+
+    ForEachIndex(batch, acrossBatch, [&](uint32_t k) {
+        auto ctxtDCRT = raised[k]->GetElements();
+
+        // We only use the level 0 ciphertext here. All other towers are automatically ignored to make
+        // CKKS bootstrapping faster.
+        for (size_t i = 0; i < ctxtDCRT.size(); i++) {
+            DCRTPoly temp(elementParamsRaisedPtr, COEFFICIENT);
+            ctxtDCRT[i].SetFormat(COEFFICIENT);
+            temp = ctxtDCRT[i].GetElementAtIndex(0);
+            temp.SetFormat(EVALUATION);
+            ctxtDCRT[i] = temp;
+        }
+
+        raised[k]->SetElements(ctxtDCRT);
+        raised[k]->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());
+    });
+
+    // back to the main secret, at the raised modulus
+    if (encapsulated)
+        algo->KeySwitchBatchInPlace(raised, encapsulationKeys[CKKS_ENCAPSULATION_KEYS::SPARSE_TO_DENSE]);
 
-    AdjustCiphertext(raised, correction);
-    auto ctxtDCRT = raised->GetElements();
+#ifdef BOOTSTRAPTIMING
+    std::cerr << "\nNumber of levels at the beginning of bootstrapping: "
+              << raised[0]->GetElements()[0].GetNumOfElements() - 1 << std::endl;
+#endif
+
+    auto result = EvalBootstrapRaised(std::move(raised), precom, correction, pre, scalar, acrossBatch);
 
-    // We only use the level 0 ciphertext here. All other towers are automatically ignored to make
-    // CKKS bootstrapping faster.
-    for (size_t i = 0; i < ctxtDCRT.size(); i++) {
-        DCRTPoly temp(elementParamsRaisedPtr, COEFFICIENT);
-        ctxtDCRT[i].SetFormat(COEFFICIENT);
-        temp = ctxtDCRT[i].GetElementAtIndex(0);
-        temp.SetFormat(EVALUATION);
-        ctxtDCRT[i] = temp;
+    // If we start with more towers, than we obtain from bootstrapping, return the original ciphertexts.
+    for (uint32_t i = 0; i < batch; ++i) {
+        if (result[i]->GetElements()[0].GetNumOfElements() <= initSizeQ)
+            result[i] = ciphertexts[i]->Clone();
     }
 
-    raised->SetElements(ctxtDCRT);
-    raised->SetLevel(L0 - ctxtDCRT[0].GetNumOfElements());
+    return result;
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalBootstrapRaised(std::vector<Ciphertext<DCRTPoly>> raised,
+                                                                  const std::shared_ptr<CKKSBootstrapPrecom>& precom,
+                                                                  uint32_t correction, double pre, uint64_t scalar,
+                                                                  bool acrossBatch) const {
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(raised[0]->GetCryptoParameters());
 
 #ifdef BOOTSTRAPTIMING
-    std::cerr << "\nNumber of levels at the beginning of bootstrapping: "
-              << raised->GetElements()[0].GetNumOfElements() - 1 << std::endl;
+    TimeVar t;
+    double timeEncode(0.0);
+    double timeModReduce(0.0);
+    double timeDecode(0.0);
 #endif
 
+    auto cc              = raised[0]->GetCryptoContext();
+    auto algo            = cc->GetScheme();
+    uint32_t M           = cc->GetCyclotomicOrder();
+    size_t N             = cc->GetRingDimension();
+    uint32_t slots       = raised[0]->GetSlots();
+    const uint32_t batch = raised.size();
+
     //------------------------------------------------------------------------------
     // SETTING PARAMETERS FOR APPROXIMATE MODULAR REDUCTION
     //------------------------------------------------------------------------------
@@ -503,7 +798,7 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     std::vector<double> coefficients;
     double k = 0;
 
-    if (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY) {
+    if (IsSparseBootstrap(cryptoParams->GetSecretKeyDist())) {
         coefficients = g_coefficientsSparse;
         // k = K_SPARSE;
         k = 1.0;  // do not divide by k as we already did it during precomputation
@@ -515,16 +810,19 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
 
     double constantEvalMult = pre * (1.0 / (k * N));
 
-    cc->EvalMultInPlace(raised, constantEvalMult);
+    ForEachIndex(batch, acrossBatch, [&](uint32_t i) { cc->EvalMultInPlace(raised[i], constantEvalMult); });
 
     // no linear transformations are needed for Chebyshev series as the range has been normalized to [-1,1]
     double coeffLowerBound = -1;
     double coeffUpperBound = 1;
 
-    Ciphertext<DCRTPoly> ctxtDec;
+    std::vector<Ciphertext<DCRTPoly>> ctxtEnc(batch);
+    std::vector<Ciphertext<DCRTPoly>> ctxtDec(batch);
 
     bool isLTBootstrap = (precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1) &&
                          (precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET] == 1);
+    // The linear transforms run on the whole batch, so that every rotation key is applied to all ciphertexts at
+    // once; the stages in between are independent per ciphertext.
     if (slots == M / 4) {
         //------------------------------------------------------------------------------
         // FULLY PACKED CASE
@@ -539,60 +837,74 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         //------------------------------------------------------------------------------
 
         // need to call internal modular reduction so it also works for FLEXIBLEAUTO
-        algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
+        for (auto& ciphertext : raised)
+            algo->ModReduceInternalInPlace(ciphertext, BASE_NUM_LEVELS_TO_DROP);
 
         // only one linear transform is needed as the other one can be derived
-        auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
-
-        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
-        auto conj       = Conjugate(ctxtEnc, evalKeyMap);
-        auto ctxtEncI   = cc->EvalSub(ctxtEnc, conj);
-        cc->EvalAddInPlace(ctxtEnc, conj);
-        algo->MultByMonomialInPlace(ctxtEncI, 3 * M / 4);
-
-        if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {
-            while (ctxtEnc->GetNoiseScaleDeg() > 1) {
-                cc->ModReduceInPlace(ctxtEnc);
-                cc->ModReduceInPlace(ctxtEncI);
-            }
+        if (isLTBootstrap) {
+            ForEachIndex(batch, acrossBatch,
+                         [&](uint32_t i) { ctxtEnc[i] = EvalLinearTransform(precom->m_U0hatTPre, raised[i]); });
         }
         else {
-            if (ctxtEnc->GetNoiseScaleDeg() == 2) {
-                algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
-                algo->ModReduceInternalInPlace(ctxtEncI, BASE_NUM_LEVELS_TO_DROP);
-            }
+            ctxtEnc = EvalCoeffsToSlotsBatch(precom->m_U0hatTPreFFT, std::move(raised));
         }
 
-        //------------------------------------------------------------------------------
-        // Running Approximate Mod Reduction
-        //------------------------------------------------------------------------------
+        auto evalKeys = cc->GetEvalAutomorphismKeyMapPtr(ctxtEnc[0]->GetKeyTag());
+        ForEachIndex(batch, acrossBatch, [&](uint32_t i) {
+            auto conj     = Conjugate(ctxtEnc[i], *evalKeys);
+            auto ctxtEncI = cc->EvalSub(ctxtEnc[i], conj);
+            cc->EvalAddInPlace(ctxtEnc[i], conj);
+            algo->MultByMonomialInPlace(ctxtEncI, 3 * M / 4);
 
-        // Evaluate Chebyshev series for the sine wave
-        ctxtEnc  = cc->EvalChebyshevSeries(ctxtEnc, coefficients, coeffLowerBound, coeffUpperBound);
-        ctxtEncI = cc->EvalChebyshevSeries(ctxtEncI, coefficients, coeffLowerBound, coeffUpperBound);
+            if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {
+                while (ctxtEnc[i]->GetNoiseScaleDeg() > 1) {
+                    cc->ModReduceInPlace(ctxtEnc[i]);
+                    cc->ModReduceInPlace(ctxtEncI);
+                }
+            }
+            else {
+                if (ctxtEnc[i]->GetNoiseScaleDeg() == 2) {
+                    algo->ModReduceInternalInPlace(ctxtEnc[i], BASE_NUM_LEVELS_TO_DROP);
+                    algo->ModReduceInternalInPlace(ctxtEncI, BASE_NUM_LEVELS_TO_DROP);
+                }
+            }
 
-        // Double-angle iterations
-        if ((cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY) ||
-            (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY)) {
-            if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
-                algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
-                algo->ModReduceInternalInPlace(ctxtEncI, BASE_NUM_LEVELS_TO_DROP);
+            //------------------------------------------------------------------------------
+            // Running Approximate Mod Reduction
+            //------------------------------------------------------------------------------
+
+            // Evaluate Chebyshev series for the sine wave
+            ctxtEnc[i] = cc->EvalChebyshevSeries(ctxtEnc[i], coefficients, coeffLowerBound, coeffUpperBound);
+            ctxtEncI   = cc->EvalChebyshevSeries(ctxtEncI, coefficients, coeffLowerBound, coeffUpperBound);
+
+            // Double-angle iterations
+            if ((cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY) ||
+                IsSparseBootstrap(cryptoParams->GetSecretKeyDist())) {
+                if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+                    algo->ModReduceInternalInPlace(ctxtEnc[i], BASE_NUM_LEVELS_TO_DROP);
+                    algo->ModReduceInternalInPlace(ctxtEncI, BASE_NUM_LEVELS_TO_DROP);
+                }
+                uint32_t numIter;
+                if (cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY)
+                    numIter = R_UNIFORM;
+                else
+                    numIter = R_SPARSE;
+                ApplyDoubleAngleIterations(ctxtEnc[i], numIter);
+                ApplyDoubleAngleIterations(ctxtEncI, numIter);
             }
-            uint32_t numIter;
-            if (cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY)
-                numIter = R_UNIFORM;
-            else
-                numIter = R_SPARSE;
-            ApplyDoubleAngleIterations(ctxtEnc, numIter);
-            ApplyDoubleAngleIterations(ctxtEncI, numIter);
-        }
 
-        algo->MultByMonomialInPlace(ctxtEncI, M / 4);
-        cc->EvalAddInPlace(ctxtEnc, ctxtEncI);
+            algo->MultByMonomialInPlace(ctxtEncI, M / 4);
+            cc->EvalAddInPlace(ctxtEnc[i], ctxtEncI);
+
+            // scale the message back up after Chebyshev interpolation
+            algo->MultByIntegerInPlace(ctxtEnc[i], scalar);
 
-        // scale the message back up after Chebyshev interpolation
-        algo->MultByIntegerInPlace(ctxtEnc, scalar);
+            // In the case of FLEXIBLEAUTO, we need one extra tower for SlotsToCoeffs
+            // TODO: See if we can remove the extra level in FLEXIBLEAUTO
+            if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+                algo->ModReduceInternalInPlace(ctxtEnc[i], BASE_NUM_LEVELS_TO_DROP);
+            }
+        });
 
 #ifdef BOOTSTRAPTIMING
         timeModReduce = TOC(t);
@@ -608,15 +920,14 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         // Running SlotToCoeff
         //------------------------------------------------------------------------------
 
-        // In the case of FLEXIBLEAUTO, we need one extra tower
-        // TODO: See if we can remove the extra level in FLEXIBLEAUTO
-        if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
-            algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
-        }
-
         // Only one linear transform is needed
-        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
-                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        if (isLTBootstrap) {
+            ForEachIndex(batch, acrossBatch,
+                         [&](uint32_t i) { ctxtDec[i] = EvalLinearTransform(precom->m_U0Pre, ctxtEnc[i]); });
+        }
+        else {
+            ctxtDec = EvalSlotsToCoeffsBatch(precom->m_U0PreFFT, std::move(ctxtEnc));
+        }
     }
     else {
         //------------------------------------------------------------------------------
@@ -627,10 +938,12 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         // Running PartialSum
         //------------------------------------------------------------------------------
 
-        for (uint32_t j = 1; j < N / (2 * slots); j <<= 1) {
-            auto temp = cc->EvalRotate(raised, j * slots);
-            cc->EvalAddInPlace(raised, temp);
-        }
+        ForEachIndex(batch, acrossBatch, [&](uint32_t i) {
+            for (uint32_t j = 1; j < N / (2 * slots); j <<= 1) {
+                auto temp = cc->EvalRotate(raised[i], j * slots);
+                cc->EvalAddInPlace(raised[i], temp);
+            }
+        });
 
 #ifdef BOOTSTRAPTIMING
         TIC(t);
@@ -640,25 +953,33 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         // Running CoeffsToSlots
         //------------------------------------------------------------------------------
 
-        algo->ModReduceInternalInPlace(raised, BASE_NUM_LEVELS_TO_DROP);
+        for (auto& ciphertext : raised)
+            algo->ModReduceInternalInPlace(ciphertext, BASE_NUM_LEVELS_TO_DROP);
 
-        auto ctxtEnc = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0hatTPre, raised) :
-                                         EvalCoeffsToSlots(precom->m_U0hatTPreFFT, raised);
+        if (isLTBootstrap) {
+            ForEachIndex(batch, acrossBatch,
+                         [&](uint32_t i) { ctxtEnc[i] = EvalLinearTransform(precom->m_U0hatTPre, raised[i]); });
+        }
+        else {
+            ctxtEnc = EvalCoeffsToSlotsBatch(precom->m_U0hatTPreFFT, std::move(raised));
+        }
 
-        auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ctxtEnc->GetKeyTag());
-        auto conj       = Conjugate(ctxtEnc, evalKeyMap);
-        cc->EvalAddInPlace(ctxtEnc, conj);
+        auto evalKeys = cc->GetEvalAutomorphismKeyMapPtr(ctxtEnc[0]->GetKeyTag());
+        ForEachIndex(batch, acrossBatch, [&](uint32_t i) {
+            auto conj = Conjugate(ctxtEnc[i], *evalKeys);
+            cc->EvalAddInPlace(ctxtEnc[i], conj);
 
-        if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {
-            while (ctxtEnc->GetNoiseScaleDeg() > 1) {
-                cc->ModReduceInPlace(ctxtEnc);
+            if (cryptoParams->GetScalingTechnique() == FIXEDMANUAL) {
+                while (ctxtEnc[i]->GetNoiseScaleDeg() > 1) {
+                    cc->ModReduceInPlace(ctxtEnc[i]);
+                }
             }
-        }
-        else {
-            if (ctxtEnc->GetNoiseScaleDeg() == 2) {
-                algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
+            else {
+                if (ctxtEnc[i]->GetNoiseScaleDeg() == 2) {
+                    algo->ModReduceInternalInPlace(ctxtEnc[i], BASE_NUM_LEVELS_TO_DROP);
+                }
             }
-        }
+        });
 
 #ifdef BOOTSTRAPTIMING
         timeEncode = TOC(t);
@@ -674,25 +995,33 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         // Running Approximate Mod Reduction
         //------------------------------------------------------------------------------
 
-        // Evaluate Chebyshev series for the sine wave
-        ctxtEnc = cc->EvalChebyshevSeries(ctxtEnc, coefficients, coeffLowerBound, coeffUpperBound);
+        ForEachIndex(batch, acrossBatch, [&](uint32_t i) {
+            // Evaluate Chebyshev series for the sine wave
+            ctxtEnc[i] = cc->EvalChebyshevSeries(ctxtEnc[i], coefficients, coeffLowerBound, coeffUpperBound);
 
-        // Double-angle iterations
-        if ((cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY) ||
-            (cryptoParams->GetSecretKeyDist() == SPARSE_TERNARY)) {
-            if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
-                algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
+            // Double-angle iterations
+            if ((cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY) ||
+                IsSparseBootstrap(cryptoParams->GetSecretKeyDist())) {
+                if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+                    algo->ModReduceInternalInPlace(ctxtEnc[i], BASE_NUM_LEVELS_TO_DROP);
+                }
+                uint32_t numIter;
+                if (cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY)
+                    numIter = R_UNIFORM;
+                else
+                    numIter = R_SPARSE;
+                ApplyDoubleAngleIterations(ctxtEnc[i], numIter);
             }
-            uint32_t numIter;
-            if (cryptoParams->GetSecretKeyDist() == UNIFORM_TERNARY)
-                numIter = R_UNIFORM;
-            else
-                numIter = R_SPARSE;
-            ApplyDoubleAngleIterations(ctxtEnc, numIter);
-        }
 
-        // scale the message back up after Chebyshev interpolation
-        algo->MultByIntegerInPlace(ctxtEnc, scalar);
+            // scale the message back up after Chebyshev interpolation
+            algo->MultByIntegerInPlace(ctxtEnc[i], scalar);
+
+            // In the case of FLEXIBLEAUTO, we need one extra tower for SlotsToCoeffs
+            // TODO: See if we can remove the extra level in FLEXIBLEAUTO
+            if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
+                algo->ModReduceInternalInPlace(ctxtEnc[i], BASE_NUM_LEVELS_TO_DROP);
+            }
+        });
 
 #ifdef BOOTSTRAPTIMING
         timeModReduce = TOC(t);
@@ -708,23 +1037,24 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
         // Running SlotsToCoeffs
         //------------------------------------------------------------------------------
 
-        // In the case of FLEXIBLEAUTO, we need one extra tower
-        // TODO: See if we can remove the extra level in FLEXIBLEAUTO
-        if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL) {
-            algo->ModReduceInternalInPlace(ctxtEnc, BASE_NUM_LEVELS_TO_DROP);
-        }
-
         // linear transform for decoding
-        ctxtDec = (isLTBootstrap) ? EvalLinearTransform(precom->m_U0Pre, ctxtEnc) :
-                                    EvalSlotsToCoeffs(precom->m_U0PreFFT, ctxtEnc);
+        if (isLTBootstrap) {
+            ForEachIndex(batch, acrossBatch,
+                         [&](uint32_t i) { ctxtDec[i] = EvalLinearTransform(precom->m_U0Pre, ctxtEnc[i]); });
+        }
+        else {
+            ctxtDec = EvalSlotsToCoeffsBatch(precom->m_U0PreFFT, std::move(ctxtEnc));
+        }
 
-        cc->EvalAddInPlace(ctxtDec, cc->EvalRotate(ctxtDec, slots));
+        ForEachIndex(batch, acrossBatch,
+                     [&](uint32_t i) { cc->EvalAddInPlace(ctxtDec[i], cc->EvalRotate(ctxtDec[i], slots)); });
     }
 
 #if NATIVEINT != 128
     // 64-bit only: scale back the message to its original scale.
     uint64_t corFactor = (uint64_t)1 << std::llround(correction);
-    algo->MultByIntegerInPlace(ctxtDec, corFactor);
+    for (auto& ciphertext : ctxtDec)
+        algo->MultByIntegerInPlace(ciphertext, corFactor);
 #endif
 
 #ifdef BOOTSTRAPTIMING
@@ -733,13 +1063,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalBootstrap(ConstCiphertext<DCRTPoly> ciphert
     std::cout << "Decoding time: " << timeDecode / 1000.0 << " s" << std::endl;
 #endif
 
-    auto bootstrappingNumTowers = ctxtDec->GetElements()[0].GetNumOfElements();
-
-    // If we start with more towers, than we obtain from bootstrapping, return the original ciphertext.
-    if (bootstrappingNumTowers <= initSizeQ) {
-        return ciphertext->Clone();
-    }
-
     return ctxtDec;
 }
 
@@ -1174,7 +1497,8 @@ std::vector<ConstPlaintext> FHECKKSRNS::EvalLinearTransformPrecompute(
 
 std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
-    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
+    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L,
+    std::vector<CKKSBootstrapDiagonals>* diagonals) const {
     uint32_t slots = rotGroup.size();
 
     auto pair = m_bootPrecomMap.find(slots);
@@ -1262,6 +1586,23 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
         sizeQ--;
     }
 
+    // level s is encoded in the basis paramsVector[s - stop] at level level0 - s, or only its rotated
+    // diagonals are kept for lazy encoding
+    if (diagonals != nullptr) {
+        diagonals->assign(levelBudget, CKKSBootstrapDiagonals());
+        for (int32_t s = levelBudget - 1; s >= std::max(stop, 0); s--) {
+            (*diagonals)[s].params = paramsVector[s - stop];
+            (*diagonals)[s].level  = level0 - s;
+            (*diagonals)[s].values.resize(result[s].size());
+        }
+    }
+    auto encode = [&](int32_t s, int32_t k, std::vector<std::complex<double>>&& rotated) {
+        if (diagonals != nullptr)
+            (*diagonals)[s].values[k] = std::move(rotated);
+        else
+            result[s][k] = MakeAuxPlaintext(cc, paramsVector[s - stop], rotated, 1, level0 - s, rotated.size());
+    };
+
     if (slots == M / 4) {
         //------------------------------------------------------------------------------
         // fully-packed mode
@@ -1285,10 +1626,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                             }
                         }
 
-                        auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
-
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1, level0 - s, rotateTemp.size());
+                        encode(s, g * i + j, Rotate(coeff[s][g * i + j], rot));
                     }
                 }
             }
@@ -1304,9 +1642,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                             coeff[stop][gRem * i + j][k] *= scale;
                         }
 
-                        auto rotateTemp = Rotate(coeff[stop][gRem * i + j], rot);
-                        result[stop][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[0], rotateTemp, 1, level0, rotateTemp.size());
+                        encode(stop, gRem * i + j, Rotate(coeff[stop][gRem * i + j], rot));
                     }
                 }
             }
@@ -1340,9 +1676,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                             }
                         }
 
-                        auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s - stop], rotateTemp, 1, level0 - s, rotateTemp.size());
+                        encode(s, g * i + j, Rotate(clearTemp, rot));
                     }
                 }
             }
@@ -1362,20 +1696,21 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalCoeffsToSlotsPrecompute
                             clearTemp[k] *= scale;
                         }
 
-                        auto rotateTemp = Rotate(clearTemp, rot);
-                        result[stop][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[0], rotateTemp, 1, level0, rotateTemp.size());
+                        encode(stop, gRem * i + j, Rotate(clearTemp, rot));
                     }
                 }
             }
         }
     }
+    if (diagonals != nullptr)
+        return {};
     return result;
 }
 
 std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute(
     const CryptoContextImpl<DCRTPoly>& cc, const std::vector<std::complex<double>>& A,
-    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L) const {
+    const std::vector<uint32_t>& rotGroup, bool flag_i, double scale, uint32_t L,
+    std::vector<CKKSBootstrapDiagonals>* diagonals) const {
     uint32_t slots = rotGroup.size();
 
     auto pair = m_bootPrecomMap.find(slots);
@@ -1461,6 +1796,23 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
         sizeQ--;
     }
 
+    // level s is encoded in the basis paramsVector[s] at level level0 + s, or only its rotated
+    // diagonals are kept for lazy encoding
+    if (diagonals != nullptr) {
+        diagonals->assign(levelBudget, CKKSBootstrapDiagonals());
+        for (int32_t s = 0; s < levelBudget; s++) {
+            (*diagonals)[s].params = paramsVector[s];
+            (*diagonals)[s].level  = level0 + s;
+            (*diagonals)[s].values.resize(result[s].size());
+        }
+    }
+    auto encode = [&](int32_t s, int32_t k, std::vector<std::complex<double>>&& rotated) {
+        if (diagonals != nullptr)
+            (*diagonals)[s].values[k] = std::move(rotated);
+        else
+            result[s][k] = MakeAuxPlaintext(cc, paramsVector[s], rotated, 1, level0 + s, rotated.size());
+    };
+
     if (slots == M / 4) {
         // fully-packed
         auto coeff = CoeffDecodingCollapse(A, rotGroup, levelBudget, flag_i);
@@ -1478,9 +1830,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                             }
                         }
 
-                        auto rotateTemp = Rotate(coeff[s][g * i + j], rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        encode(s, g * i + j, Rotate(coeff[s][g * i + j], rot));
                     }
                 }
             }
@@ -1497,9 +1847,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                             coeff[s][gRem * i + j][k] *= scale;
                         }
 
-                        auto rotateTemp = Rotate(coeff[s][gRem * i + j], rot);
-                        result[s][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        encode(s, gRem * i + j, Rotate(coeff[s][gRem * i + j], rot));
                     }
                 }
             }
@@ -1530,9 +1878,7 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                             }
                         }
 
-                        auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][g * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        encode(s, g * i + j, Rotate(clearTemp, rot));
                     }
                 }
             }
@@ -1553,14 +1899,14 @@ std::vector<std::vector<ConstPlaintext>> FHECKKSRNS::EvalSlotsToCoeffsPrecompute
                             clearTemp[k] *= scale;
                         }
 
-                        auto rotateTemp = Rotate(clearTemp, rot);
-                        result[s][gRem * i + j] =
-                            MakeAuxPlaintext(cc, paramsVector[s], rotateTemp, 1, level0 + s, rotateTemp.size());
+                        encode(s, gRem * i + j, Rotate(clearTemp, rot));
                     }
                 }
             }
         }
     }
+    if (diagonals != nullptr)
+        return {};
     return result;
 }
 
@@ -1586,9 +1932,6 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
     uint32_t bStep = (precom->m_dim1 == 0) ? ceil(sqrt(slots)) : precom->m_dim1;
     uint32_t gStep = ceil(static_cast<double>(slots) / bStep);
 
-    uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
-
     // computes the NTTs for each CRT limb (for the hoisted automorphisms used
     // later on)
     auto digits = cc->EvalFastRotationPrecompute(ct);
@@ -1601,9 +1944,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
         fastRotation[j - 1] = cc->EvalFastRotationExt(ct, j, digits, true);
     }
 
+    // the giant steps are accumulated in the extended basis and brought down to Q_l once
     Ciphertext<DCRTPoly> result;
-    DCRTPoly first;
-
     for (uint32_t j = 0; j < gStep; j++) {
         Ciphertext<DCRTPoly> inner = EvalMultExt(cc->KeySwitchExt(ct, true), A[bStep * j]);
         for (uint32_t i = 1; i < bStep; i++) {
@@ -1612,38 +1954,22 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalLinearTransform(const std::vector<ConstPlai
             }
         }
 
-        if (j == 0) {
-            first         = cc->KeySwitchDownFirstElement(inner);
-            auto elements = inner->GetElements();
-            elements[0].SetValuesToZero();
-            inner->SetElements(elements);
-            result = inner;
-        }
-        else {
-            inner = cc->KeySwitchDown(inner);
-            // Find the automorphism index that corresponds to rotation index index.
-            usint autoIndex = FindAutomorphismIndex2nComplex(bStep * j, M);
-            std::vector<usint> map(N);
-            PrecomputeAutoMap(N, autoIndex, &map);
-            DCRTPoly firstCurrent = inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-            first += firstCurrent;
-
-            auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-            EvalAddExtInPlace(result, cc->EvalFastRotationExt(inner, bStep * j, innerDigits, false));
-        }
+        EvalGiantStepExtInPlace(result, std::move(inner), bStep * j);
     }
 
-    result        = cc->KeySwitchDown(result);
-    auto elements = result->GetElements();
-    elements[0] += first;
-    result->SetElements(elements);
+    result = cc->KeySwitchDown(result);
 
     return result;
 }
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector<ConstPlaintext>>& A,
                                                    ConstCiphertext<DCRTPoly> ctxt) const {
-    uint32_t slots = ctxt->GetSlots();
+    return EvalCoeffsToSlotsBatch(A, {ctxt->Clone()})[0];
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalCoeffsToSlotsBatch(const std::vector<std::vector<ConstPlaintext>>& A,
+                                                                     std::vector<Ciphertext<DCRTPoly>> ctxts) const {
+    uint32_t slots = ctxts[0]->GetSlots();
 
     auto pair = m_bootPrecomMap.find(slots);
     if (pair == m_bootPrecomMap.end()) {
@@ -1654,9 +1980,8 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
     }
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
 
-    auto cc    = ctxt->GetCryptoContext();
+    auto cc    = ctxts[0]->GetCryptoContext();
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsEnc[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -1717,143 +2042,39 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalCoeffsToSlots(const std::vector<std::vector
         }
     }
 
-    Ciphertext<DCRTPoly> result = ctxt->Clone();
+    // with lazy encoding A is empty, and every level is encoded from its diagonals right before it is evaluated
+    const bool lazy = A.empty() && !precom->m_U0hatTPreDiag.empty();
+    LazyLevelEncoder lazyLevels(
+        [&](int32_t s, bool parallel) { return EncodeDiagonals(*cc, precom->m_U0hatTPreDiag[s], parallel); }, -1, -1);
 
     // hoisted automorphisms
     for (int32_t s = levelBudget - 1; s > stop; s--) {
         if (s != levelBudget - 1) {
-            algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
+            for (auto& ctxt : ctxts)
+                algo->ModReduceInternalInPlace(ctxt, BASE_NUM_LEVELS_TO_DROP);
         }
-
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(g);
-#pragma omp parallel for
-        for (int32_t j = 0; j < g; j++) {
-            if (rot_in[s][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < b; i++) {
-            // for the first iteration with j=0:
-            int32_t G                  = g * i;
-            Ciphertext<DCRTPoly> inner = EvalMultExt(fastRotation[0], A[s][G]);
-            // continue the loop
-            for (int32_t j = 1; j < g; j++) {
-                if ((G + j) != int32_t(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        EvalLinearTransformLevelBatch(ctxts, lazy ? lazyLevels.Get(s) : A[s], rot_in[s], rot_out[s], g, b,
+                                      numRotations);
     }
 
     if (flagRem) {
-        algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
-
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(gRem);
-
-#pragma omp parallel for
-        for (int32_t j = 0; j < gRem; j++) {
-            if (rot_in[stop][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[stop][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < bRem; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[stop][GRem]);
-            // continue the loop
-            for (int32_t j = 1; j < gRem; j++) {
-                if ((GRem + j) != int32_t(numRotationsRem)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[stop][GRem + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[stop][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[stop][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[stop][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        for (auto& ctxt : ctxts)
+            algo->ModReduceInternalInPlace(ctxt, BASE_NUM_LEVELS_TO_DROP);
+        EvalLinearTransformLevelBatch(ctxts, lazy ? lazyLevels.Get(stop) : A[stop], rot_in[stop], rot_out[stop], gRem,
+                                      bRem, numRotationsRem);
     }
 
-    return result;
+    return ctxts;
 }
 
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector<ConstPlaintext>>& A,
                                                    ConstCiphertext<DCRTPoly> ctxt) const {
-    uint32_t slots = ctxt->GetSlots();
+    return EvalSlotsToCoeffsBatch(A, {ctxt->Clone()})[0];
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalSlotsToCoeffsBatch(const std::vector<std::vector<ConstPlaintext>>& A,
+                                                                     std::vector<Ciphertext<DCRTPoly>> ctxts) const {
+    uint32_t slots = ctxts[0]->GetSlots();
 
     auto pair = m_bootPrecomMap.find(slots);
     if (pair == m_bootPrecomMap.end()) {
@@ -1865,10 +2086,9 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
 
     const std::shared_ptr<CKKSBootstrapPrecom> precom = pair->second;
 
-    auto cc = ctxt->GetCryptoContext();
+    auto cc = ctxts[0]->GetCryptoContext();
 
     uint32_t M = cc->GetCyclotomicOrder();
-    uint32_t N = cc->GetRingDimension();
 
     int32_t levelBudget     = precom->m_paramsDec[CKKS_BOOT_PARAMS::LEVEL_BUDGET];
     int32_t layersCollapse  = precom->m_paramsDec[CKKS_BOOT_PARAMS::LAYERS_COLL];
@@ -1929,139 +2149,83 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalSlotsToCoeffs(const std::vector<std::vector
         }
     }
 
+    // with lazy encoding A is empty, and every level is encoded from its diagonals right before it is evaluated
+    const bool lazy = A.empty() && !precom->m_U0PreDiag.empty();
+    LazyLevelEncoder lazyLevels(
+        [&](int32_t s, bool parallel) { return EncodeDiagonals(*cc, precom->m_U0PreDiag[s], parallel); }, 1,
+        levelBudget);
+
     //  No need for Encrypted Bit Reverse
-    Ciphertext<DCRTPoly> result = ctxt->Clone();
 
     // hoisted automorphisms
     for (int32_t s = 0; s < levelBudget - flagRem; s++) {
         if (s != 0) {
-            algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
+            for (auto& ctxt : ctxts)
+                algo->ModReduceInternalInPlace(ctxt, BASE_NUM_LEVELS_TO_DROP);
         }
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(g);
-#pragma omp parallel for
-        for (int32_t j = 0; j < g; j++) {
-            if (rot_in[s][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
-
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < b; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t G = g * i;
-            inner     = EvalMultExt(fastRotation[0], A[s][G]);
-            // continue the loop
-            for (int32_t j = 1; j < g; j++) {
-                if ((G + j) != int32_t(numRotations)) {
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][G + j]));
-                }
-            }
-
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
-                }
-            }
-        }
-
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        EvalLinearTransformLevelBatch(ctxts, lazy ? lazyLevels.Get(s) : A[s], rot_in[s], rot_out[s], g, b,
+                                      numRotations);
     }
 
     if (flagRem) {
-        algo->ModReduceInternalInPlace(result, BASE_NUM_LEVELS_TO_DROP);
-        // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
-        auto digits = cc->EvalFastRotationPrecompute(result);
-        std::vector<Ciphertext<DCRTPoly>> fastRotation(gRem);
-
+        for (auto& ctxt : ctxts)
+            algo->ModReduceInternalInPlace(ctxt, BASE_NUM_LEVELS_TO_DROP);
         int32_t s = levelBudget - flagRem;
-#pragma omp parallel for
-        for (int32_t j = 0; j < gRem; j++) {
-            if (rot_in[s][j] != 0) {
-                fastRotation[j] = cc->EvalFastRotationExt(result, rot_in[s][j], digits, true);
-            }
-            else {
-                fastRotation[j] = cc->KeySwitchExt(result, true);
-            }
-        }
+        EvalLinearTransformLevelBatch(ctxts, lazy ? lazyLevels.Get(s) : A[s], rot_in[s], rot_out[s], gRem, bRem,
+                                      numRotationsRem);
+    }
 
-        Ciphertext<DCRTPoly> outer;
-        DCRTPoly first;
-        for (int32_t i = 0; i < bRem; i++) {
-            Ciphertext<DCRTPoly> inner;
-            // for the first iteration with j=0:
-            int32_t GRem = gRem * i;
-            inner        = EvalMultExt(fastRotation[0], A[s][GRem]);
-            // continue the loop
-            for (int32_t j = 1; j < gRem; j++) {
-                if ((GRem + j) != int32_t(numRotationsRem))
-                    EvalAddExtInPlace(inner, EvalMultExt(fastRotation[j], A[s][GRem + j]));
-            }
+    return ctxts;
+}
 
-            if (i == 0) {
-                first         = cc->KeySwitchDownFirstElement(inner);
-                auto elements = inner->GetElements();
-                elements[0].SetValuesToZero();
-                inner->SetElements(elements);
-                outer = inner;
-            }
-            else {
-                if (rot_out[s][i] != 0) {
-                    inner = cc->KeySwitchDown(inner);
-                    // Find the automorphism index that corresponds to rotation index index.
-                    usint autoIndex = FindAutomorphismIndex2nComplex(rot_out[s][i], M);
-                    std::vector<usint> map(N);
-                    PrecomputeAutoMap(N, autoIndex, &map);
-                    first += inner->GetElements()[0].AutomorphismTransform(autoIndex, map);
-                    auto innerDigits = cc->EvalFastRotationPrecompute(inner);
-                    EvalAddExtInPlace(outer, cc->EvalFastRotationExt(inner, rot_out[s][i], innerDigits, false));
-                }
-                else {
-                    first += cc->KeySwitchDownFirstElement(inner);
-                    auto elements = inner->GetElements();
-                    elements[0].SetValuesToZero();
-                    inner->SetElements(elements);
-                    EvalAddExtInPlace(outer, inner);
+void FHECKKSRNS::EvalLinearTransformLevelBatch(std::vector<Ciphertext<DCRTPoly>>& ctxts,
+                                               const std::vector<ConstPlaintext>& A, const std::vector<int32_t>& rotIn,
+                                               const std::vector<int32_t>& rotOut, int32_t g, int32_t b,
+                                               int32_t numRotations) const {
+    auto cc              = ctxts[0]->GetCryptoContext();
+    const uint32_t batch = ctxts.size();
+
+    // computes the NTTs for each CRT limb (for the hoisted automorphisms used later on)
+    std::vector<std::shared_ptr<std::vector<DCRTPoly>>> digits(batch);
+    for (uint32_t k = 0; k < batch; k++)
+        digits[k] = cc->EvalFastRotationPrecompute(ctxts[k]);
+
+    // fastRotation[j][k] is the j-th baby step of the k-th ciphertext; each rotation key is applied to the
+    // whole batch at once
+    std::vector<std::vector<Ciphertext<DCRTPoly>>> fastRotation(g);
+    ForEachIndex(g, true, [&](uint32_t j) {
+        if (rotIn[j] != 0) {
+            fastRotation[j] = EvalFastRotationExtBatch(ctxts, rotIn[j], digits, true);
+        }
+        else {
+            fastRotation[j].resize(batch);
+            for (uint32_t k = 0; k < batch; k++)
+                fastRotation[j][k] = cc->KeySwitchExt(ctxts[k], true);
+        }
+    });
+    digits.clear();
+
+    // the giant steps are accumulated in the extended basis and brought down to Q_l once
+    std::vector<Ciphertext<DCRTPoly>> outer(batch);
+    for (int32_t i = 0; i < b; i++) {
+        // for the first iteration with j=0:
+        int32_t G = g * i;
+        std::vector<Ciphertext<DCRTPoly>> inner(batch);
+        for (uint32_t k = 0; k < batch; k++) {
+            inner[k] = EvalMultExt(fastRotation[0][k], A[G]);
+            // continue the loop
+            for (int32_t j = 1; j < g; j++) {
+                if ((G + j) != numRotations) {
+                    EvalAddExtInPlace(inner[k], EvalMultExt(fastRotation[j][k], A[G + j]));
                 }
             }
         }
 
-        result                          = cc->KeySwitchDown(outer);
-        std::vector<DCRTPoly>& elements = result->GetElements();
-        elements[0] += first;
+        EvalGiantStepExtBatchInPlace(outer, std::move(inner), rotOut[i]);
     }
 
-    return result;
+    for (uint32_t k = 0; k < batch; k++)
+        ctxts[k] = cc->KeySwitchDown(outer[k]);
 }
 
 uint32_t FHECKKSRNS::GetBootstrapDepth(uint32_t approxModDepth, const std::vector<uint32_t>& levelBudget,
@@ -2457,6 +2621,18 @@ Plaintext FHECKKSRNS::MakeAuxPlaintext(const CryptoContextImpl<DCRTPoly>& cc, co
 }
 #endif
 
+std::vector<ConstPlaintext> FHECKKSRNS::EncodeDiagonals(const CryptoContextImpl<DCRTPoly>& cc,
+                                                        const CKKSBootstrapDiagonals& diagonals,
+                                                        bool parallel) const {
+    std::vector<ConstPlaintext> result(diagonals.values.size());
+    ForEachIndex(diagonals.values.size(), parallel, [&](uint32_t k) {
+        const auto& diagonal = diagonals.values[k];
+        if (!diagonal.empty())
+            result[k] = MakeAuxPlaintext(cc, diagonals.params, diagonal, 1, diagonals.level, diagonal.size());
+    });
+    return result;
+}
+
 Ciphertext<DCRTPoly> FHECKKSRNS::EvalMultExt(ConstCiphertext<DCRTPoly> ciphertext, ConstPlaintext plaintext) const {
     Ciphertext<DCRTPoly> result = ciphertext->Clone();
     std::vector<DCRTPoly>& cv   = result->GetElements();
@@ -2488,6 +2664,143 @@ Ciphertext<DCRTPoly> FHECKKSRNS::EvalAddExt(ConstCiphertext<DCRTPoly> ciphertext
     return result;
 }
 
+void FHECKKSRNS::EvalGiantStepExtInPlace(Ciphertext<DCRTPoly>& outer, Ciphertext<DCRTPoly> inner,
+                                         int32_t rotation) const {
+    std::vector<Ciphertext<DCRTPoly>> outers{outer};
+    EvalGiantStepExtBatchInPlace(outers, {std::move(inner)}, rotation);
+    outer = std::move(outers[0]);
+}
+
+void FHECKKSRNS::EvalGiantStepExtBatchInPlace(std::vector<Ciphertext<DCRTPoly>>& outer,
+                                              std::vector<Ciphertext<DCRTPoly>> inner, int32_t rotation) const {
+    const uint32_t batch = inner.size();
+    if (!outer[0]) {
+        if (rotation == 0) {
+            outer = std::move(inner);
+            return;
+        }
+        // the first giant step is rotated as well: it is added to a zero accumulator in Q_l*P
+        for (uint32_t k = 0; k < batch; k++) {
+            const auto paramsQlP = inner[k]->GetElements()[0].GetParams();
+            outer[k]             = inner[k]->CloneZero();
+            outer[k]->SetElements(
+                {DCRTPoly(paramsQlP, Format::EVALUATION, true), DCRTPoly(paramsQlP, Format::EVALUATION, true)});
+        }
+    }
+    if (rotation == 0) {
+        for (uint32_t k = 0; k < batch; k++)
+            EvalAddExtInPlace(outer[k], inner[k]);
+        return;
+    }
+
+    const auto cc = inner[0]->GetCryptoContext();
+    if (!g_giantStepsInExtendedBasis) {
+        // the single-hoisted giant step of earlier releases: both elements of the inner sum are brought down
+        // to Q_l, and the rotated first element is lifted back to Q_l*P by the hoisted rotation
+        std::vector<Ciphertext<DCRTPoly>> innerQl(batch);
+        std::vector<std::shared_ptr<std::vector<DCRTPoly>>> digits(batch);
+        for (uint32_t k = 0; k < batch; k++) {
+            innerQl[k] = cc->KeySwitchDown(inner[k]);
+            digits[k]  = cc->EvalFastRotationPrecompute(innerQl[k]);
+        }
+        inner.clear();
+
+        auto rotated = EvalFastRotationExtBatch(innerQl, rotation, digits, true);
+        for (uint32_t k = 0; k < batch; k++)
+            EvalAddExtInPlace(outer[k], rotated[k]);
+        return;
+    }
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(inner[0]->GetCryptoParameters());
+
+    usint N         = cryptoParams->GetElementParams()->GetRingDimension();
+    usint M         = cryptoParams->GetElementParams()->GetCyclotomicOrder();
+    usint autoIndex = FindAutomorphismIndex2nComplex(rotation, M);
+    std::vector<usint> map(N);
+    PrecomputeAutoMap(N, autoIndex, &map);
+
+    const auto paramsP   = cryptoParams->GetParamsP();
+    usint sizeQl         = inner[0]->GetElements()[1].GetNumOfElements() - paramsP->GetParams().size();
+    const auto& paramsQl = cryptoParams->GetParamsQlHybrid(sizeQl - 1);
+    PlaintextModulus t   = (cryptoParams->GetNoiseScale() == 1) ? 0 : cryptoParams->GetPlaintextModulus();
+
+    std::vector<Ciphertext<DCRTPoly>> innerQl(batch);
+    std::vector<std::shared_ptr<std::vector<DCRTPoly>>> digits(batch);
+    for (uint32_t k = 0; k < batch; k++) {
+        const std::vector<DCRTPoly>& cv = inner[k]->GetElements();
+
+        // the first element is rotated in Q_l*P and brought down to Q_l with the accumulator
+        outer[k]->GetElements()[0] += cv[0].AutomorphismTransform(autoIndex, map);
+
+        // only the second element needs to be in Q_l, for the digit decomposition of the hoisted rotation:
+        // this is the single ModDown of the giant step
+        DCRTPoly c1 =
+            cv[1].ApproxModDown(paramsQl, paramsP, cryptoParams->GetPInvModq(), cryptoParams->GetPInvModqPrecon(),
+                                cryptoParams->GetPHatInvModp(), cryptoParams->GetPHatInvModpPrecon(),
+                                cryptoParams->GetPHatModq(), cryptoParams->GetModqBarrettMu(),
+                                cryptoParams->GettInvModp(), cryptoParams->GettInvModpPrecon(), t,
+                                cryptoParams->GettModqPrecon());
+
+        innerQl[k] = inner[k]->CloneZero();
+        innerQl[k]->SetElements({DCRTPoly(paramsQl, Format::EVALUATION, true), std::move(c1)});
+        digits[k] = cc->EvalFastRotationPrecompute(innerQl[k]);
+    }
+    inner.clear();
+
+    auto rotated = EvalFastRotationExtBatch(innerQl, rotation, digits, false);
+    for (uint32_t k = 0; k < batch; k++)
+        EvalAddExtInPlace(outer[k], rotated[k]);
+}
+
+std::vector<Ciphertext<DCRTPoly>> FHECKKSRNS::EvalFastRotationExtBatch(
+    const std::vector<Ciphertext<DCRTPoly>>& ciphertexts, usint index,
+    const std::vector<std::shared_ptr<std::vector<DCRTPoly>>>& digits, bool addFirst) const {
+    const auto cc           = ciphertexts[0]->GetCryptoContext();
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertexts[0]->GetCryptoParameters());
+    auto algo               = cc->GetScheme();
+    auto evalKeys           = cc->GetEvalAutomorphismKeyMapPtr(ciphertexts[0]->GetKeyTag());
+    const uint32_t batch    = ciphertexts.size();
+
+    usint N = cryptoParams->GetElementParams()->GetRingDimension();
+    usint M = cryptoParams->GetElementParams()->GetCyclotomicOrder();
+
+    // Find the automorphism index that corresponds to rotation index index.
+    usint autoIndex = FindAutomorphismIndex2nComplex(index, M);
+
+    std::vector<Ciphertext<DCRTPoly>> result(batch);
+    auto evalKeyIterator = evalKeys->find(autoIndex);
+    if (evalKeyIterator == evalKeys->end()) {
+        // no dedicated key: the rotation is composed from the base set one ciphertext at a time
+        for (uint32_t k = 0; k < batch; k++)
+            result[k] = algo->EvalFastRotationExt(ciphertexts[k], index, digits[k], addFirst, *evalKeys);
+        return result;
+    }
+
+    const auto paramsQl = ciphertexts[0]->GetElements()[0].GetParams();
+    size_t sizeQl       = paramsQl->GetParams().size();
+    auto cTilda         = algo->EvalFastKeySwitchCoreExtBatch(digits, evalKeyIterator->second, paramsQl);
+
+    std::vector<usint> vec(N);
+    PrecomputeAutoMap(N, autoIndex, &vec);
+
+    for (uint32_t k = 0; k < batch; k++) {
+        std::vector<DCRTPoly>& parts = *cTilda[k];
+        if (addFirst) {
+            DCRTPoly psiC0 = DCRTPoly(parts[0].GetParams(), Format::EVALUATION, true);
+            auto cMult     = ciphertexts[k]->GetElements()[0].TimesNoCheck(cryptoParams->GetPModq());
+            for (usint i = 0; i < sizeQl; i++) {
+                psiC0.SetElementAtIndex(i, cMult.GetElementAtIndex(i));
+            }
+            parts[0] += psiC0;
+        }
+
+        result[k] = ciphertexts[k]->CloneZero();
+        result[k]->SetElements(
+            {parts[0].AutomorphismTransform(autoIndex, vec), parts[1].AutomorphismTransform(autoIndex, vec)});
+    }
+    return result;
+}
+
 EvalKey<DCRTPoly> FHECKKSRNS::ConjugateKeyGen(const PrivateKey<DCRTPoly> privateKey) const {
     const auto cc = privateKey->GetCryptoContext();
     auto algo     = cc->GetScheme();
@@ -42,6 +42,11 @@ CKKS implementation. See https://eprint.iacr.org/2020/1118 for details.
 
 #include "schemebase/base-scheme.h"
 
+#include "utils/vectorpool.h"
+
+#include <algorithm>
+#include <cmath>
+
 namespace lbcrypto {
 
 /////////////////////////////////////////
@@ -105,6 +110,7 @@ void LeveledSHECKKSRNS::EvalMultInPlace(Ciphertext<DCRTPoly>& ciphertext, double
 /////////////////////////////////////
 
 void LeveledSHECKKSRNS::ModReduceInternalInPlace(Ciphertext<DCRTPoly>& ciphertext, size_t levels) const {
+    VectorPoolScope poolScope;
     const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
 
     std::vector<DCRTPoly>& cv = ciphertext->GetElements();
@@ -452,18 +458,41 @@ Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalFastRotationExt(ConstCiphertext<DCRT
     // Find the automorphism index that corresponds to rotation index index.
     usint autoIndex = FindAutomorphismIndex2nComplex(index, M);
 
+    auto algo = cc->GetScheme();
+
     // Retrieve the automorphism key that corresponds to the auto index.
     auto evalKeyIterator = evalKeys.find(autoIndex);
     if (evalKeyIterator == evalKeys.end()) {
-        OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
+        // No dedicated key: compose the rotation in Q_l from the base set and lift the result to Q_l*P.
+        // The first part is key switched with the hoisted digits, the others are applied to its result.
+        // Without addFirst the caller adds the rotated first element itself, so it is taken out here.
+        auto parts   = FindRotationComposition(static_cast<int32_t>(index), M, evalKeys);
+        auto rotated = ciphertext->Clone();
+        if (!parts.empty()) {
+            usint firstIndex = FindAutomorphismIndex2nComplex(parts[0], M);
+            std::shared_ptr<std::vector<DCRTPoly>> ba =
+                algo->EvalFastKeySwitchCore(digits, evalKeys.at(firstIndex), ciphertext->GetElements()[0].GetParams());
+            (*ba)[0] += ciphertext->GetElements()[0];
+
+            std::vector<usint> vec(N);
+            PrecomputeAutoMap(N, firstIndex, &vec);
+            rotated->SetElements(
+                {(*ba)[0].AutomorphismTransform(firstIndex, vec), (*ba)[1].AutomorphismTransform(firstIndex, vec)});
+            for (size_t i = 1; i < parts.size(); ++i)
+                rotated = EvalAutomorphism(rotated, FindAutomorphismIndex2nComplex(parts[i], M), evalKeys);
+        }
+        if (!addFirst) {
+            std::vector<usint> vec(N);
+            PrecomputeAutoMap(N, autoIndex, &vec);
+            rotated->GetElements()[0] -= ciphertext->GetElements()[0].AutomorphismTransform(autoIndex, vec);
+        }
+        return algo->KeySwitchExt(rotated, true);
     }
     auto evalKey = evalKeyIterator->second;
 
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
     const auto paramsQl             = cv[0].GetParams();
 
-    auto algo = cc->GetScheme();
-
     std::shared_ptr<std::vector<DCRTPoly>> cTilda = algo->EvalFastKeySwitchCoreExt(digits, evalKey, paramsQl);
 
     if (addFirst) {
@@ -490,6 +519,85 @@ Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalFastRotationExt(ConstCiphertext<DCRT
     return result;
 }
 
+Ciphertext<DCRTPoly> LeveledSHECKKSRNS::EvalRotateAndAccumulate(
+    ConstCiphertext<DCRTPoly> ciphertext, const std::vector<int32_t>& indices,
+    const std::vector<ConstPlaintext>& weights, const std::map<usint, EvalKey<DCRTPoly>>& evalKeys) const {
+    if (indices.empty())
+        OPENFHE_THROW("The list of rotation indices is empty");
+    if (indices.size() != weights.size())
+        OPENFHE_THROW("The number of weights [" + std::to_string(weights.size()) +
+                      "] does not match the number of rotation indices [" + std::to_string(indices.size()) + "]");
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersCKKSRNS>(ciphertext->GetCryptoParameters());
+    if (cryptoParams->GetKeySwitchTechnique() != HYBRID)
+        OPENFHE_THROW("EvalRotateAndAccumulate is only supported for HYBRID key switching");
+
+    const auto cc = ciphertext->GetCryptoContext();
+    auto algo     = cc->GetScheme();
+
+    // the weights are multiplied in directly, so a ciphertext of degree 2 is rescaled first, as in EvalMult
+    Ciphertext<DCRTPoly> ct = ciphertext->Clone();
+    if (cryptoParams->GetScalingTechnique() != FIXEDMANUAL && ct->GetNoiseScaleDeg() == 2)
+        ModReduceInternalInPlace(ct, BASE_NUM_LEVELS_TO_DROP);
+
+    size_t sizeQl         = ct->GetElements()[0].GetNumOfElements();
+    const auto& paramsQlP = cryptoParams->GetParamsQlP(sizeQl - 1);
+    size_t sizeQlP        = paramsQlP->GetParams().size();
+
+    // the digit decomposition is shared by all nonzero rotations
+    std::shared_ptr<std::vector<DCRTPoly>> digits;
+    if (std::any_of(indices.begin(), indices.end(), [](int32_t index) { return index != 0; }))
+        digits = EvalFastRotationPrecompute(ct);
+
+    // every weight is multiplied in at the level of the ciphertext, so all of them must carry the scaling factor
+    // of that level; it is computed once, as in MakeCKKSPackedPlaintext(), and weights with another one are
+    // re-encoded
+    size_t noiseScaleDeg = weights[0]->GetNoiseScaleDeg();
+    uint32_t level       = ct->GetLevel();
+    double scalingFactor = (cryptoParams->GetScalingTechnique() == FLEXIBLEAUTOEXT && level == 0) ?
+                               cryptoParams->GetScalingFactorRealBig(level) :
+                               std::pow(cryptoParams->GetScalingFactorReal(level), noiseScaleDeg);
+
+    DCRTPoly acc0(paramsQlP, Format::EVALUATION, true);
+    DCRTPoly acc1(paramsQlP, Format::EVALUATION, true);
+
+    for (size_t i = 0; i < indices.size(); i++) {
+        const auto& weight = weights[i];
+        if (weight->GetNoiseScaleDeg() != noiseScaleDeg)
+            OPENFHE_THROW("All weights must be encoded with the same scaling degree");
+
+        // P * rot(ct) in the extended basis; index 0 needs no key switching
+        Ciphertext<DCRTPoly> rotated = (indices[i] == 0) ?
+                                           algo->KeySwitchExt(ct, true) :
+                                           EvalFastRotationExt(ct, indices[i], digits, true, evalKeys);
+
+        DCRTPoly w;
+        if (weight->GetElement<DCRTPoly>().GetNumOfElements() == sizeQlP &&
+            weight->GetScalingFactor() == scalingFactor) {
+            w = weight->GetElement<DCRTPoly>();
+        }
+        else {
+            w = cc->MakeCKKSPackedPlaintext(weight->GetCKKSPackedValue(), noiseScaleDeg, level, paramsQlP,
+                                            weight->GetSlots())
+                    ->GetElement<DCRTPoly>();
+        }
+        w.SetFormat(Format::EVALUATION);
+
+        const std::vector<DCRTPoly>& rv = rotated->GetElements();
+        acc0 += rv[0] * w;
+        acc1 += rv[1] * w;
+    }
+
+    Ciphertext<DCRTPoly> accumulated = ct->CloneZero();
+    accumulated->SetElements({std::move(acc0), std::move(acc1)});
+
+    // a single ModDown for all rotations
+    Ciphertext<DCRTPoly> result = algo->KeySwitchDown(accumulated);
+    result->SetNoiseScaleDeg(ct->GetNoiseScaleDeg() + noiseScaleDeg);
+    result->SetScalingFactor(ct->GetScalingFactor() * scalingFactor);
+    return result;
+}
+
 Ciphertext<DCRTPoly> LeveledSHECKKSRNS::MultByInteger(ConstCiphertext<DCRTPoly> ciphertext, uint64_t integer) const {
     const std::vector<DCRTPoly>& cv = ciphertext->GetElements();
 
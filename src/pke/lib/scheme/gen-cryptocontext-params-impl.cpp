@@ -76,6 +76,7 @@ namespace lbcrypto {
         SET_TO_SCHEME_DEFAULT(SCHEME, numAdversarialQueries);           \
         SET_TO_SCHEME_DEFAULT(SCHEME, thresholdNumOfParties);           \
         SET_TO_SCHEME_DEFAULT(SCHEME, interactiveBootCompressionLevel); \
+        SET_TO_SCHEME_DEFAULT(SCHEME, compressEvalKeys);                \
     }
 void Params::SetToDefaults(SCHEME scheme) {
     switch (scheme) {
@@ -196,7 +197,8 @@ std::ostream& operator<<(std::ostream& os, const Params& obj) {
         << "; statisticalSecurity: " << obj.statisticalSecurity
         << "; numAdversarialQueries: " << obj.numAdversarialQueries
         << "; thresholdNumOfParties: " << obj.thresholdNumOfParties
-        << "; interactiveBootCompressionLevel: " << obj.interactiveBootCompressionLevel;
+        << "; interactiveBootCompressionLevel: " << obj.interactiveBootCompressionLevel
+        << "; compressEvalKeys: " << obj.compressEvalKeys;
 
     return os;
 }
@@ -35,6 +35,13 @@
 #include "cryptocontext.h"
 #include "schemebase/base-scheme.h"
 
+#include "utils/vectorpool.h"
+
+#include <algorithm>
+#include <limits>
+#include <set>
+#include <utility>
+
 namespace lbcrypto {
 
 /////////////////////////////////////////
@@ -490,11 +497,21 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalFastRotation(
 
     usint autoIndex = FindAutomorphismIndex(index, m);
 
-    auto evalKeyMap = cc->GetEvalAutomorphismKeyMap(ciphertext->GetKeyTag());
+    // holding the registered map instead of copying it keeps it alive if the keys are replaced meanwhile
+    auto evalKeys          = cc->GetEvalAutomorphismKeyMapPtr(ciphertext->GetKeyTag());
+    const auto& evalKeyMap = *evalKeys;
     // verify if the key autoIndex exists in the evalKeyMap
     auto evalKeyIterator = evalKeyMap.find(autoIndex);
     if (evalKeyIterator == evalKeyMap.end()) {
-        OPENFHE_THROW("EvalKey for index [" + std::to_string(autoIndex) + "] is not found.");
+        // a rotation without a dedicated key is composed from the base set: the first part reuses the digits,
+        // the others are applied to its result one after another
+        auto parts = FindRotationComposition(static_cast<int32_t>(index), m, evalKeyMap);
+        if (parts.empty())
+            return ciphertext->Clone();
+        auto result = EvalFastRotation(ciphertext, parts[0], m, digits);
+        for (size_t i = 1; i < parts.size(); ++i)
+            result = EvalAutomorphism(result, FindAutomorphismIndex(parts[i], m), evalKeyMap);
+        return result;
     }
     auto evalKey = evalKeyIterator->second;
 
@@ -545,8 +562,171 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalAtIndex(ConstCiphertext<Element
     usint M = ciphertext->GetCryptoParameters()->GetElementParams()->GetCyclotomicOrder();
 
     uint32_t autoIndex = FindAutomorphismIndex(index, M);
+    if (evalKeyMap.find(autoIndex) != evalKeyMap.end())
+        return EvalAutomorphism(ciphertext, autoIndex, evalKeyMap);
+
+    // no dedicated key: compose the rotation from the keys that are available
+    auto parts = FindRotationComposition(index, M, evalKeyMap);
+    if (parts.empty())
+        return ciphertext->Clone();
+
+    Ciphertext<Element> result = EvalAutomorphism(ciphertext, FindAutomorphismIndex(parts[0], M), evalKeyMap);
+    for (size_t i = 1; i < parts.size(); ++i)
+        result = EvalAutomorphism(result, FindAutomorphismIndex(parts[i], M), evalKeyMap);
+    return result;
+}
+
+namespace {
+
+// rotations form a cyclic group of order m/4, so every rotation equals one in [0, m/4)
+int32_t ReduceRotation(int64_t index, int32_t order) {
+    return static_cast<int32_t>(((index % order) + order) % order);
+}
+
+// the lowest digit of the non-adjacent form of x != 0: +-2^k, chosen so that x minus the digit has
+// at least two trailing zero bits more than x
+int64_t LowestSignedDigit(int64_t x) {
+    int64_t power = x & -x;
+    return ((x / power) & 3) == 1 ? power : -power;
+}
+
+// the number of key switchings needed to compose a rotation from the signed powers of two
+uint32_t SignedDigitCount(int32_t rotation, int32_t order) {
+    uint32_t best = std::numeric_limits<uint32_t>::max();
+    for (int64_t x : {int64_t(rotation), int64_t(rotation) - order}) {
+        uint32_t count = 0;
+        for (; x != 0; x -= LowestSignedDigit(x))
+            ++count;
+        best = std::min(best, count);
+    }
+    return best;
+}
+
+}  // namespace
+
+template <class Element>
+std::vector<int32_t> LeveledSHEBase<Element>::FindRotationComposition(
+    int32_t index, uint32_t m, const std::map<usint, EvalKey<Element>>& evalKeyMap) const {
+    const int32_t order = m / 4;
+    auto hasKey         = [&](int32_t rotation) {
+        return evalKeyMap.find(FindAutomorphismIndex(rotation, m)) != evalKeyMap.end();
+    };
+
+    std::vector<int32_t> best;
+    const int32_t rotation = ReduceRotation(index, order);
+    if (rotation == 0)
+        return best;
+
+    // the rotation is split into signed powers of two (the non-adjacent form of either the rotation or
+    // the rotation minus m/4), so that both +2^k and -2^k keys are used and at most about half of the
+    // bits cost a key switching; a stored key for the part that remains ends the split early.
+    // Key sets without the negative powers fall back to the positive powers of two.
+    bool found = false;
+    auto consider = [&](std::vector<int32_t>&& parts) {
+        if (!found || parts.size() < best.size())
+            best = std::move(parts);
+        found = true;
+    };
+    for (int64_t remaining : {int64_t(rotation), int64_t(rotation) - order}) {
+        std::vector<int32_t> parts;
+        while (remaining != 0 && !hasKey(ReduceRotation(remaining, order))) {
+            int32_t digit = ReduceRotation(LowestSignedDigit(remaining), order);
+            if (!hasKey(digit))
+                break;
+            parts.push_back(digit);
+            remaining -= LowestSignedDigit(remaining);
+        }
+        if (remaining != 0) {
+            if (!hasKey(ReduceRotation(remaining, order)))
+                continue;
+            parts.push_back(ReduceRotation(remaining, order));
+        }
+        consider(std::move(parts));
+    }
+
+    std::vector<int32_t> parts;
+    int32_t remaining = rotation;
+    while (remaining > 0 && !hasKey(remaining)) {
+        // split off the highest power of two
+        int32_t step = 1;
+        while (step <= remaining / 2)
+            step <<= 1;
+        if (!hasKey(step))
+            break;
+        parts.push_back(step);
+        remaining -= step;
+    }
+    if (remaining > 0 && hasKey(remaining)) {
+        parts.push_back(remaining);
+        consider(std::move(parts));
+    }
 
-    return EvalAutomorphism(ciphertext, autoIndex, evalKeyMap);
+    if (!found)
+        OPENFHE_THROW("EvalKey for index [" + std::to_string(FindAutomorphismIndex(index, m)) + "] is not found.");
+
+    return best;
+}
+
+template <class Element>
+std::vector<int32_t> LeveledSHEBase<Element>::PlanRotationKeys(const std::vector<int32_t>& indexList, uint32_t m,
+                                                               uint64_t keySize, uint64_t memoryBudget) {
+    const int32_t order = m / 4;
+
+    // the base set: the signed powers of two, from which every rotation is composed with at most
+    // about log2(m/4)/2 key switchings; the rotations by m/8 and -m/8 are the same
+    std::vector<int32_t> planned;
+    std::set<int32_t> covered;
+    for (int32_t step = 1; step < order; step <<= 1) {
+        for (int32_t rotation : {step, order - step}) {
+            if (covered.insert(rotation).second)
+                planned.push_back(rotation);
+        }
+    }
+    // the conjugation key is part of the base set as well
+    uint64_t used = (planned.size() + 1) * keySize;
+
+    // a dedicated key for a rotation saves one key switching per extra signed power of two in it
+    std::vector<std::pair<uint32_t, int32_t>> candidates;
+    for (int32_t index : indexList) {
+        int32_t rotation = ReduceRotation(index, order);
+        if (rotation == 0 || !covered.insert(rotation).second)
+            continue;
+        candidates.emplace_back(SignedDigitCount(rotation, order) - 1, rotation);
+    }
+    std::stable_sort(candidates.begin(), candidates.end(),
+                     [](const std::pair<uint32_t, int32_t>& a, const std::pair<uint32_t, int32_t>& b) {
+                         return a.first > b.first;
+                     });
+
+    for (const auto& candidate : candidates) {
+        if (used + keySize > memoryBudget)
+            break;
+        planned.push_back(candidate.second);
+        used += keySize;
+    }
+    return planned;
+}
+
+template <class Element>
+std::shared_ptr<std::map<usint, EvalKey<Element>>> LeveledSHEBase<Element>::EvalAtIndexBaseKeyGen(
+    const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList, uint64_t memoryBudget) const {
+    usint M = privateKey->GetCryptoParameters()->GetElementParams()->GetCyclotomicOrder();
+
+    // the size of one key is measured on the rotation by 1, which belongs to the base set anyway
+    auto evalKeys    = EvalAtIndexKeyGen(nullptr, privateKey, {1});
+    const auto& b    = evalKeys->begin()->second->GetBVector();
+    uint64_t keySize = 2 * b.size() * b[0].GetNumOfElements() * b[0].GetRingDimension() * sizeof(NativeInteger);
+
+    auto planned = PlanRotationKeys(indexList, M, keySize, memoryBudget);
+    planned.erase(std::remove(planned.begin(), planned.end(), 1), planned.end());
+
+    auto rotationKeys = EvalAtIndexKeyGen(nullptr, privateKey, planned);
+    evalKeys->insert(rotationKeys->begin(), rotationKeys->end());
+
+    auto conjKey = EvalAutomorphismKeyGen(privateKey, {M - 1});
+    evalKeys->insert(conjKey->begin(), conjKey->end());
+
+    return evalKeys;
 }
 
 /////////////////////////////////////////
@@ -688,6 +868,7 @@ void LeveledSHEBase<Element>::EvalSubCoreInPlace(Ciphertext<Element>& ciphertext
 template <class Element>
 Ciphertext<Element> LeveledSHEBase<Element>::EvalMultCore(ConstCiphertext<Element> ciphertext1,
                                                           ConstCiphertext<Element> ciphertext2) const {
+    VectorPoolScope poolScope;
     VerifyNumOfTowers(ciphertext1, ciphertext2);
     Ciphertext<Element> result = ciphertext1->CloneZero();
 
@@ -730,6 +911,7 @@ Ciphertext<Element> LeveledSHEBase<Element>::EvalMultCore(ConstCiphertext<Elemen
 
 template <class Element>
 Ciphertext<Element> LeveledSHEBase<Element>::EvalSquareCore(ConstCiphertext<Element> ciphertext) const {
+    VectorPoolScope poolScope;
     Ciphertext<Element> result = ciphertext->CloneZero();
 
     const std::vector<Element>& cv = ciphertext->GetElements();
@@ -101,6 +101,7 @@ KeyPair<Element> MultipartyBase<Element>::MultipartyKeyGen(CryptoContext<Element
             s = Element(dgg, paramsPK, Format::EVALUATION);
             break;
         case UNIFORM_TERNARY:
+        case SPARSE_ENCAPSULATED:
             s = Element(tug, paramsPK, Format::EVALUATION);
             break;
         case SPARSE_TERNARY:
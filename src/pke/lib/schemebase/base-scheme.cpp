@@ -102,6 +102,19 @@ std::shared_ptr<std::map<usint, EvalKey<Element>>> SchemeBase<Element>::EvalAtIn
     return evalKeyMap;
 }
 
+template <typename Element>
+std::shared_ptr<std::map<usint, EvalKey<Element>>> SchemeBase<Element>::EvalAtIndexBaseKeyGen(
+    const PrivateKey<Element> privateKey, const std::vector<int32_t>& indexList, uint64_t memoryBudget) const {
+    VerifyLeveledSHEEnabled(__func__);
+    if (!privateKey)
+        OPENFHE_THROW("Input private key is nullptr");
+
+    auto evalKeyMap = m_LeveledSHE->EvalAtIndexBaseKeyGen(privateKey, indexList, memoryBudget);
+    for (auto& key : *evalKeyMap)
+        key.second->SetKeyTag(privateKey->GetKeyTag());
+    return evalKeyMap;
+}
+
 template <typename Element>
 Ciphertext<Element> SchemeBase<Element>::ComposedEvalMult(ConstCiphertext<Element> ciphertext1,
                                                           ConstCiphertext<Element> ciphertext2,
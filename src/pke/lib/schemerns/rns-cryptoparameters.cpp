@@ -174,6 +174,20 @@ void CryptoParametersRNS::PrecomputeCRTTables(KeySwitchTechnique ksTech, Scaling
 
         m_paramsQP = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduliQP, rootsQP);
 
+        // Pre-compute the bases Q^(l) and Q^(l)*P for every level, so that key switching
+        // does not have to rebuild them on each call
+        m_paramsQlHybrid.resize(sizeQ);
+        m_paramsQlP.resize(sizeQ);
+        for (size_t l = 0; l < sizeQ; l++) {
+            std::vector<NativeInteger> moduliQl(moduliQ.begin(), moduliQ.begin() + l + 1);
+            std::vector<NativeInteger> rootsQl(rootsQ.begin(), rootsQ.begin() + l + 1);
+            m_paramsQlHybrid[l] = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduliQl, rootsQl);
+
+            moduliQl.insert(moduliQl.end(), moduliP.begin(), moduliP.end());
+            rootsQl.insert(rootsQl.end(), rootsP.begin(), rootsP.end());
+            m_paramsQlP[l] = std::make_shared<ILDCRTParams<BigInteger>>(2 * n, moduliQl, rootsQl);
+        }
+
         // Pre-compute CRT::FFT values for P
         ChineseRemainderTransformFTT<NativeVector>().PreCompute(rootsP, 2 * n, moduliP);
 
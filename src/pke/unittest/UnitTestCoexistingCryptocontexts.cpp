@@ -37,6 +37,11 @@
 #include "UnitTestUtils.h"
 #include "include/gtest/gtest.h"
 
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
 using namespace lbcrypto;
 
 class UTGENERAL_CRYPTOCONTEXTS : public ::testing::Test {
@@ -114,3 +119,99 @@ TEST_F(UTGENERAL_CRYPTOCONTEXTS, coexisting_ckks_cryptocontexts) {
     EXPECT_TRUE(checkEquality(values, results->GetRealPackedValue()))
         << "static data for the first cryptocontext may be overriden";
 }
+
+TEST_F(UTGENERAL_CRYPTOCONTEXTS, concurrent_eval_key_maps) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(1);
+    parameters.SetScalingModSize(40);
+    parameters.SetRingDim(16);
+    parameters.SetBatchSize(8);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    KeyPair<DCRTPoly> keys = cc->KeyGen();
+    cc->EvalRotateKeyGen(keys.secretKey, {1});
+    const size_t registeredTags = CryptoContextImpl<DCRTPoly>::GetAllEvalAutomorphismKeys().size();
+
+    std::vector<double> values = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+    auto ciphertext            = cc->Encrypt(keys.publicKey, cc->MakeCKKSPackedPlaintext(values));
+
+    // readers rotate with their keys while keys of other tags (and new indices of their own tag)
+    // are inserted and cleared
+    std::atomic<bool> failed{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&]() {
+            for (int i = 0; i < 20; ++i) {
+                Plaintext result;
+                cc->Decrypt(keys.secretKey, cc->EvalRotate(ciphertext, 1), &result);
+                result->SetLength(values.size());
+                if (std::abs(result->GetRealPackedValue()[0] - values[1]) > 0.01)
+                    failed = true;
+            }
+        });
+    }
+    for (int i = 0; i < 4; ++i) {
+        KeyPair<DCRTPoly> tenant = cc->KeyGen();
+        cc->EvalMultKeyGen(tenant.secretKey);
+        cc->EvalRotateKeyGen(tenant.secretKey, {1, 2});
+        cc->EvalRotateKeyGen(keys.secretKey, {i + 2});
+        CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys(tenant.secretKey->GetKeyTag());
+        CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys(tenant.secretKey->GetKeyTag());
+    }
+    for (auto& reader : readers)
+        reader.join();
+
+    EXPECT_FALSE(failed) << "EvalRotate fails while the key maps are modified";
+    EXPECT_EQ(cc->GetEvalAutomorphismKeyMap(keys.secretKey->GetKeyTag())->size(), 5u)
+        << "rotation keys inserted concurrently are lost";
+    EXPECT_EQ(CryptoContextImpl<DCRTPoly>::GetAllEvalAutomorphismKeys().size(), registeredTags)
+        << "cleared rotation keys are still registered";
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+}
+
+TEST_F(UTGENERAL_CRYPTOCONTEXTS, held_eval_key_map_outlives_clear) {
+    CCParams<CryptoContextCKKSRNS> parameters;
+    parameters.SetMultiplicativeDepth(1);
+    parameters.SetScalingModSize(40);
+    parameters.SetRingDim(16);
+    parameters.SetBatchSize(8);
+    parameters.SetSecurityLevel(HEStd_NotSet);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+    cc->Enable(ADVANCEDSHE);
+
+    KeyPair<DCRTPoly> keys = cc->KeyGen();
+    cc->EvalSumKeyGen(keys.secretKey);
+    const std::string& keyTag = keys.secretKey->GetKeyTag();
+
+    // a held map is a snapshot: neither inserting new indices nor clearing the tag changes or frees it
+    auto held             = cc->GetEvalAutomorphismKeyMap(keyTag);
+    const size_t heldSize = held->size();
+    cc->EvalRotateKeyGen(keys.secretKey, {3});
+    EXPECT_EQ(held->size(), heldSize) << "a held key map changed when keys were inserted";
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys(keyTag);
+    EXPECT_EQ(held->size(), heldSize) << "a held key map changed when its tag was cleared";
+    for (const auto& [index, key] : *held)
+        EXPECT_TRUE(key != nullptr) << "key " << index << " of a held map was freed";
+
+    // the keys that were held can be registered again and used
+    CryptoContextImpl<DCRTPoly>::InsertEvalAutomorphismKey(std::make_shared<std::map<usint, EvalKey<DCRTPoly>>>(*held),
+                                                           keyTag);
+    std::vector<double> values = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+    auto ciphertext            = cc->Encrypt(keys.publicKey, cc->MakeCKKSPackedPlaintext(values));
+    Plaintext result;
+    cc->Decrypt(keys.secretKey, cc->EvalSum(ciphertext, 8), &result);
+    EXPECT_NEAR(result->GetRealPackedValue()[0], 36.0, 0.01) << "EvalSum with re-registered keys fails";
+
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+}
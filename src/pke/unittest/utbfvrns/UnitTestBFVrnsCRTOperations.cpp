@@ -34,6 +34,8 @@
 #include "gtest/gtest.h"
 #include "gen-cryptocontext.h"
 #include "scheme/bfvrns/gen-cryptocontext-bfvrns.h"
+#include "keyswitch/keyswitch-hybrid.h"
+#include "key/evalkeyrelin.h"
 #include "UnitTestCCParams.h"
 #include "UnitTestCryptoContext.h"
 #include "UnitTestUtils.h"
@@ -415,6 +417,206 @@ TEST_F(UTBFVRNS_CRT, BFVrns_SwitchCRTBasis) {
     EXPECT_EQ(A0, B0) << "SwitchCRTBasis produced incorrect results";
 }
 
+TEST_F(UTBFVRNS_CRT, BFVrns_KeySwitchHybridNTTCount) {
+    CCParams<CryptoContextBFVRNS> parameters;
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetMultiplicativeDepth(4);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetNumLargeDigits(3);
+    parameters.SetSecurityLevel(SecurityLevel::HEStd_NotSet);
+    parameters.SetRingDim(1024);
+
+    CryptoContext<DCRTPoly> cryptoContext = GenCryptoContext(parameters);
+    cryptoContext->Enable(PKE);
+    cryptoContext->Enable(KEYSWITCH);
+    cryptoContext->Enable(LEVELEDSHE);
+
+    KeyPair<DCRTPoly> keyPair = cryptoContext->KeyGen();
+    cryptoContext->EvalMultKeyGen(keyPair.secretKey);
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cryptoContext->GetCryptoParameters());
+    uint64_t sizeQ    = cryptoParams->GetElementParams()->GetParams().size();
+    uint64_t sizeP    = cryptoParams->GetParamsP()->GetParams().size();
+    uint64_t numPartQ = cryptoParams->GetNumberOfQPartitions();
+
+    std::vector<int64_t> vectorOfInts1 = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<int64_t> vectorOfInts2 = {8, 7, 6, 5, 4, 3, 2, 1};
+    std::vector<int64_t> expectedResult(vectorOfInts1.size());
+    for (size_t i = 0; i < expectedResult.size(); ++i)
+        expectedResult[i] = vectorOfInts1[i] * vectorOfInts2[i];
+
+    auto ciphertext1 = cryptoContext->Encrypt(keyPair.publicKey, cryptoContext->MakePackedPlaintext(vectorOfInts1));
+    auto ciphertext2 = cryptoContext->Encrypt(keyPair.publicKey, cryptoContext->MakePackedPlaintext(vectorOfInts2));
+
+    KeySwitchHYBRID::ResetThreadStats();
+    auto ciphertextMul12 = cryptoContext->EvalMult(ciphertext1, ciphertext2);
+    KeySwitchStats stats = KeySwitchHYBRID::GetThreadStats();
+
+    EXPECT_EQ(1u, stats.modUps);
+    EXPECT_EQ(sizeQ, stats.inverseNTTs) << "every tower of the input should be transformed exactly once";
+    EXPECT_EQ(numPartQ * (sizeQ + sizeP) - sizeQ, stats.forwardNTTs)
+        << "only the towers generated by the basis extension should be transformed";
+
+    Plaintext plaintextMultResult;
+    cryptoContext->Decrypt(keyPair.secretKey, ciphertextMul12, &plaintextMultResult);
+    plaintextMultResult->SetLength(expectedResult.size());
+    EXPECT_EQ(expectedResult, plaintextMultResult->GetPackedValue()) << "key switching produced incorrect results";
+}
+
+TEST_F(UTBFVRNS_CRT, BFVrns_KeySwitchHybridBatch) {
+    CCParams<CryptoContextBFVRNS> parameters;
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetMultiplicativeDepth(4);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetNumLargeDigits(3);
+    parameters.SetSecurityLevel(SecurityLevel::HEStd_NotSet);
+    parameters.SetRingDim(1024);
+
+    CryptoContext<DCRTPoly> cryptoContext = GenCryptoContext(parameters);
+    cryptoContext->Enable(PKE);
+    cryptoContext->Enable(KEYSWITCH);
+    cryptoContext->Enable(LEVELEDSHE);
+
+    KeyPair<DCRTPoly> keyPair = cryptoContext->KeyGen();
+    cryptoContext->EvalMultKeyGen(keyPair.secretKey);
+    auto relinKey = cryptoContext->GetEvalMultKeyVector(keyPair.secretKey->GetKeyTag())[0];
+
+    const size_t batch = 5;
+    std::vector<std::vector<int64_t>> expected(batch);
+    std::vector<Ciphertext<DCRTPoly>> ciphertexts(batch);
+    std::vector<Ciphertext<DCRTPoly>> reference(batch);
+    for (size_t k = 0; k < batch; ++k) {
+        std::vector<int64_t> vectorOfInts1 = {1, 2, 3, 4, 5, 6, 7, 8};
+        std::vector<int64_t> vectorOfInts2 = {8, 7, 6, 5, 4, 3, 2, 1};
+        expected[k].resize(vectorOfInts1.size());
+        for (size_t i = 0; i < vectorOfInts1.size(); ++i) {
+            vectorOfInts1[i] += k;
+            expected[k][i] = vectorOfInts1[i] * vectorOfInts2[i];
+        }
+        auto ciphertext1 = cryptoContext->Encrypt(keyPair.publicKey, cryptoContext->MakePackedPlaintext(vectorOfInts1));
+        auto ciphertext2 = cryptoContext->Encrypt(keyPair.publicKey, cryptoContext->MakePackedPlaintext(vectorOfInts2));
+        ciphertexts[k]   = cryptoContext->EvalMultNoRelin(ciphertext1, ciphertext2);
+        reference[k]     = ciphertexts[k]->Clone();
+        cryptoContext->RelinearizeInPlace(reference[k]);
+    }
+
+    cryptoContext->KeySwitchBatchInPlace(ciphertexts, relinKey);
+
+    for (size_t k = 0; k < batch; ++k) {
+        ASSERT_EQ(2u, ciphertexts[k]->GetElements().size());
+        EXPECT_EQ(reference[k]->GetElements()[0], ciphertexts[k]->GetElements()[0])
+            << "batched key switching differs from relinearization";
+        EXPECT_EQ(reference[k]->GetElements()[1], ciphertexts[k]->GetElements()[1])
+            << "batched key switching differs from relinearization";
+
+        Plaintext plaintextMultResult;
+        cryptoContext->Decrypt(keyPair.secretKey, ciphertexts[k], &plaintextMultResult);
+        plaintextMultResult->SetLength(expected[k].size());
+        EXPECT_EQ(expected[k], plaintextMultResult->GetPackedValue())
+            << "batched key switching produced incorrect results";
+    }
+}
+
+TEST_F(UTBFVRNS_CRT, BFVrns_KeySwitchHybridMontgomery) {
+    CCParams<CryptoContextBFVRNS> parameters;
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetMultiplicativeDepth(4);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetNumLargeDigits(3);
+    parameters.SetSecurityLevel(SecurityLevel::HEStd_NotSet);
+    parameters.SetRingDim(1024);
+
+    CryptoContext<DCRTPoly> cryptoContext = GenCryptoContext(parameters);
+    cryptoContext->Enable(PKE);
+    cryptoContext->Enable(KEYSWITCH);
+    cryptoContext->Enable(LEVELEDSHE);
+
+    KeyPair<DCRTPoly> keyPair = cryptoContext->KeyGen();
+    cryptoContext->EvalMultKeyGen(keyPair.secretKey);
+    auto relinKey = cryptoContext->GetEvalMultKeyVector(keyPair.secretKey->GetKeyTag())[0];
+
+    std::vector<int64_t> vectorOfInts1 = {1, 2, 3, 4, 5, 6, 7, 8};
+    std::vector<int64_t> vectorOfInts2 = {8, 7, 6, 5, 4, 3, 2, 1};
+    std::vector<int64_t> expected(vectorOfInts1.size());
+    for (size_t i = 0; i < vectorOfInts1.size(); ++i)
+        expected[i] = vectorOfInts1[i] * vectorOfInts2[i];
+
+    auto ciphertext1 = cryptoContext->Encrypt(keyPair.publicKey, cryptoContext->MakePackedPlaintext(vectorOfInts1));
+    auto ciphertext2 = cryptoContext->Encrypt(keyPair.publicKey, cryptoContext->MakePackedPlaintext(vectorOfInts2));
+    auto product     = cryptoContext->EvalMultNoRelin(ciphertext1, ciphertext2);
+
+    auto reference = product->Clone();
+    cryptoContext->RelinearizeInPlace(reference);
+    std::vector<Ciphertext<DCRTPoly>> referenceBatch = {product->Clone(), product->Clone()};
+    cryptoContext->KeySwitchBatchInPlace(referenceBatch, relinKey);
+
+    EXPECT_FALSE(relinKey->HasMontgomeryForm());
+    EXPECT_THROW(relinKey->GetMontgomeryBVector(), OpenFHEException);
+    relinKey->EnableMontgomeryForm();
+    ASSERT_TRUE(relinKey->HasMontgomeryForm());
+
+    auto result = product->Clone();
+    cryptoContext->RelinearizeInPlace(result);
+    EXPECT_EQ(reference->GetElements(), result->GetElements())
+        << "key switching with the Montgomery form of the key differs from the standard path";
+
+    std::vector<Ciphertext<DCRTPoly>> batch = {product->Clone(), product->Clone()};
+    cryptoContext->KeySwitchBatchInPlace(batch, relinKey);
+    for (size_t k = 0; k < batch.size(); ++k) {
+        EXPECT_EQ(referenceBatch[k]->GetElements(), batch[k]->GetElements())
+            << "batched key switching with the Montgomery form of the key differs from the standard path";
+    }
+
+    Plaintext plaintextMultResult;
+    cryptoContext->Decrypt(keyPair.secretKey, result, &plaintextMultResult);
+    plaintextMultResult->SetLength(expected.size());
+    EXPECT_EQ(expected, plaintextMultResult->GetPackedValue())
+        << "key switching with the Montgomery form of the key produced incorrect results";
+
+    // copies do not carry the Montgomery form, and modifying a key drops it
+    auto copy = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(
+        *std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(relinKey));
+    EXPECT_FALSE(copy->HasMontgomeryForm());
+    copy->EnableMontgomeryForm();
+    copy->ClearKeys();
+    EXPECT_FALSE(copy->HasMontgomeryForm());
+}
+
+TEST_F(UTBFVRNS_CRT, BFVrns_KeySwitchHybridParamsQl) {
+    CCParams<CryptoContextBFVRNS> parameters;
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetMultiplicativeDepth(4);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetNumLargeDigits(3);
+    parameters.SetSecurityLevel(SecurityLevel::HEStd_NotSet);
+    parameters.SetRingDim(1024);
+
+    CryptoContext<DCRTPoly> cryptoContext = GenCryptoContext(parameters);
+
+    const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cryptoContext->GetCryptoParameters());
+    const auto& paramsQ     = cryptoParams->GetElementParams()->GetParams();
+    const auto& paramsP     = cryptoParams->GetParamsP()->GetParams();
+    size_t sizeQ            = paramsQ.size();
+    size_t sizeP            = paramsP.size();
+
+    for (size_t l = 0; l < sizeQ; l++) {
+        const auto& paramsQl  = cryptoParams->GetParamsQlHybrid(l);
+        const auto& paramsQlP = cryptoParams->GetParamsQlP(l);
+        ASSERT_EQ(l + 1, paramsQl->GetParams().size());
+        ASSERT_EQ(l + 1 + sizeP, paramsQlP->GetParams().size());
+        EXPECT_EQ(paramsQ[0]->GetCyclotomicOrder(), paramsQlP->GetCyclotomicOrder());
+        for (size_t i = 0; i <= l; i++) {
+            EXPECT_EQ(paramsQ[i]->GetModulus(), paramsQl->GetParams()[i]->GetModulus());
+            EXPECT_EQ(paramsQ[i]->GetModulus(), paramsQlP->GetParams()[i]->GetModulus());
+            EXPECT_EQ(paramsQ[i]->GetRootOfUnity(), paramsQlP->GetParams()[i]->GetRootOfUnity());
+        }
+        for (size_t j = 0; j < sizeP; j++) {
+            EXPECT_EQ(paramsP[j]->GetModulus(), paramsQlP->GetParams()[l + 1 + j]->GetModulus());
+        }
+    }
+    EXPECT_THROW(cryptoParams->GetParamsQlHybrid(sizeQ), OpenFHEException);
+}
+
 // TESTING POLYNOMIAL MULTIPLICATION - ONE TERM IS CONSTANT POLYNOMIAL
 TEST_F(UTBFVRNS_CRT, BFVrns_Mult_by_Constant) {
     CCParams<CryptoContextBFVRNS> parameters;
@@ -35,6 +35,12 @@
 #include "scheme/bfvrns/bfvrns-ser.h"
 #include "scheme/bfvrns/gen-cryptocontext-bfvrns.h"
 #include "gen-cryptocontext.h"
+#include "key/evalkeyrelin.h"
+#include "key/evalkeystore.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
 
 using namespace lbcrypto;
 
@@ -69,3 +75,132 @@ TEST_F(UTBFVRNS_SER, BFVRNS_SERIAL) {
 
     UnitTestContext<DCRTPoly>(cc);
 }
+
+TEST_F(UTBFVRNS_SER, BFVRNS_SERIAL_COMPRESSED_EVAL_KEYS) {
+    CCParams<CryptoContextBFVRNS> parameters;
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetMultiplicativeDepth(2);
+    parameters.SetKeySwitchTechnique(HYBRID);
+    parameters.SetCompressEvalKeys(true);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    KeyPair<DCRTPoly> kp = cc->KeyGen();
+    cc->EvalMultKeyGen(kp.secretKey);
+
+    auto ek = std::dynamic_pointer_cast<EvalKeyRelinImpl<DCRTPoly>>(
+        cc->GetEvalMultKeyVector(kp.secretKey->GetKeyTag())[0]);
+    ASSERT_TRUE(ek != nullptr);
+    EXPECT_EQ(ek->GetASeed().size(), EVAL_KEY_SEED_SIZE) << "eval key is not compressed";
+    EXPECT_EQ(EvalKeyRelinImpl<DCRTPoly>::ExpandAVector(ek->GetASeed(), ek->GetBVector()[0].GetParams(),
+                                                        ek->GetBVector().size()),
+              ek->GetAVector())
+        << "seed does not reproduce the \"a\" part";
+
+    // the same key without the seed is serialized in full
+    auto full = std::make_shared<EvalKeyRelinImpl<DCRTPoly>>(cc);
+    full->SetAVector(ek->GetAVector());
+    full->SetBVector(ek->GetBVector());
+    full->SetKeyTag(ek->GetKeyTag());
+
+    std::stringstream sCompressed, sFull;
+    Serial::Serialize(std::static_pointer_cast<EvalKeyImpl<DCRTPoly>>(ek), sCompressed, SerType::BINARY);
+    Serial::Serialize(std::static_pointer_cast<EvalKeyImpl<DCRTPoly>>(full), sFull, SerType::BINARY);
+    EXPECT_LT(sCompressed.str().size(), 0.6 * sFull.str().size()) << "compressed eval key is not smaller";
+
+    std::vector<int64_t> vals = {1, 2, 3, 4, 5, 6, 7, 8};
+    Plaintext pt              = cc->MakePackedPlaintext(vals);
+    auto ct                   = cc->Encrypt(kp.publicKey, pt);
+
+    // reload the key and use it: "a" is regenerated from the seed on first use
+    std::stringstream sKeys;
+    EXPECT_EQ(CryptoContextImpl<DCRTPoly>::SerializeEvalMultKey(sKeys, SerType::BINARY, kp.secretKey->GetKeyTag()),
+              true);
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    EXPECT_EQ(CryptoContextImpl<DCRTPoly>::DeserializeEvalMultKey(sKeys, SerType::BINARY), true);
+
+    auto loaded = cc->GetEvalMultKeyVector(kp.secretKey->GetKeyTag())[0];
+    EXPECT_TRUE(*loaded == *ek) << "deserialized compressed eval key does not match";
+
+    Plaintext result;
+    cc->Decrypt(kp.secretKey, cc->EvalMult(ct, ct), &result);
+    result->SetLength(vals.size());
+    std::vector<int64_t> expected(vals.size());
+    for (size_t i = 0; i < vals.size(); ++i)
+        expected[i] = vals[i] * vals[i];
+    EXPECT_EQ(result->GetPackedValue(), expected) << "EvalMult with a deserialized compressed key fails";
+}
+
+#if NATIVEINT == 64
+TEST_F(UTBFVRNS_SER, BFVRNS_COMPRESSED_EVAL_KEY_EXPANSION) {
+    // the expansion of a seed is fixed by the BLAKE2 stream alone, so these values hold on every platform
+    const NativeInteger q("1152921504606830593");
+    auto params = std::make_shared<ILDCRTParams<BigInteger>>(16, std::vector<NativeInteger>{q},
+                                                             std::vector<NativeInteger>{NativeInteger(1)});
+    auto a = EvalKeyRelinImpl<DCRTPoly>::ExpandAVector({1, 2, 3, 4, 5, 6, 7, 8}, params, 1);
+
+    const NativeVector& values = a[0].GetElementAtIndex(0).GetValues();
+    EXPECT_EQ(values[0], NativeInteger("568499645894744879"));
+    EXPECT_EQ(values[1], NativeInteger("273699637078090716"));
+    EXPECT_EQ(values[2], NativeInteger("1058068115967654820"));
+    EXPECT_EQ(values[3], NativeInteger("846592828492716763"));
+}
+#endif
+
+TEST_F(UTBFVRNS_SER, BFVRNS_EVAL_KEY_STORE) {
+    CCParams<CryptoContextBFVRNS> parameters;
+    parameters.SetPlaintextModulus(65537);
+    parameters.SetMultiplicativeDepth(2);
+
+    CryptoContext<DCRTPoly> cc = GenCryptoContext(parameters);
+    cc->Enable(PKE);
+    cc->Enable(KEYSWITCH);
+    cc->Enable(LEVELEDSHE);
+
+    KeyPair<DCRTPoly> kp = cc->KeyGen();
+    cc->EvalMultKeyGen(kp.secretKey);
+    cc->EvalRotateKeyGen(kp.secretKey, {1, -2});
+
+    const std::string& keyTag  = kp.secretKey->GetKeyTag();
+    const std::string filename = ::testing::TempDir() + "bfvrns_eval_key_store.bin";
+    EvalKeyStore::Write(filename, keyTag);
+
+    auto multKey = cc->GetEvalMultKeyVector(keyTag)[0];
+    CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+    CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+    EvalKeyStore::Load(filename);
+    std::remove(filename.c_str());
+
+    auto loaded = cc->GetEvalMultKeyVector(keyTag)[0];
+    EXPECT_TRUE(*loaded == *multKey) << "EvalMult key loaded from the store does not match";
+    const auto* arena = loaded->GetBVector()[0].GetAllElements()[0].GetArena();
+    ASSERT_NE(arena, nullptr);
+    EXPECT_TRUE(arena->IsView()) << "EvalMult key loaded from the store is not used in place";
+    EXPECT_EQ(cc->GetEvalAutomorphismKeyMap(keyTag)->size(), 2u) << "rotation keys are missing from the store";
+
+    std::vector<int64_t> vals = {1, 2, 3, 4, 5, 6, 7, 8};
+    auto ct                   = cc->Encrypt(kp.publicKey, cc->MakePackedPlaintext(vals));
+
+    Plaintext result;
+    cc->Decrypt(kp.secretKey, cc->EvalMult(ct, ct), &result);
+    result->SetLength(vals.size());
+    std::vector<int64_t> expected(vals.size());
+    for (size_t i = 0; i < vals.size(); ++i)
+        expected[i] = vals[i] * vals[i];
+    EXPECT_EQ(result->GetPackedValue(), expected) << "EvalMult with a key from the store fails";
+
+    cc->Decrypt(kp.secretKey, cc->EvalRotate(ct, -2), &result);
+    result->SetLength(vals.size());
+    EXPECT_EQ(result->GetPackedValue(), std::vector<int64_t>({0, 0, 1, 2, 3, 4, 5, 6}))
+        << "EvalRotate with a key from the store fails";
+
+    // the store is mapped copy-on-write, so the values of a loaded key can be written in place
+    auto& b0              = const_cast<DCRTPoly&>(loaded->GetBVector()[0]);
+    const DCRTPoly before = b0;
+    b0.SwitchFormat();
+    b0.SwitchFormat();
+    EXPECT_EQ(b0, before) << "in-place NTTs of a key from the store fail";
+}
@@ -41,7 +41,9 @@
 #include "cryptocontext-ser.h"
 #include "scheme/ckksrns/ckksrns-ser.h"
 
+#include <cstdio>
 #include <iostream>
+#include <string>
 #include <vector>
 #include "gtest/gtest.h"
 #include <cxxabi.h>
@@ -58,6 +60,9 @@ enum TEST_CASE_TYPE {
     BOOTSTRAP_ITERATIVE,
     BOOTSTRAP_NUM_TOWERS,
     BOOTSTRAP_SERIALIZE,
+    BOOTSTRAP_PRECOM_STORE,
+    BOOTSTRAP_LAZY,
+    BOOTSTRAP_BATCH,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -84,6 +89,15 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case BOOTSTRAP_SERIALIZE:
             typeName = "BOOTSTRAP_SERIALIZE";
             break;
+        case BOOTSTRAP_PRECOM_STORE:
+            typeName = "BOOTSTRAP_PRECOM_STORE";
+            break;
+        case BOOTSTRAP_LAZY:
+            typeName = "BOOTSTRAP_LAZY";
+            break;
+        case BOOTSTRAP_BATCH:
+            typeName = "BOOTSTRAP_BATCH";
+            break;
         default:
             typeName = "UNKNOWN";
             break;
@@ -151,6 +165,8 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_FULL, "07", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
     { BOOTSTRAP_FULL, "08", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
 #endif
+    { BOOTSTRAP_FULL, "09", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,      FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_FULL, "10", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,      FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
     // ==========================================
     // TestType,     Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
     { BOOTSTRAP_FULL, "11", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
@@ -163,6 +179,8 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_FULL, "17", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
     { BOOTSTRAP_FULL, "18", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
 #endif
+    { BOOTSTRAP_FULL, "19", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,      FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
+    { BOOTSTRAP_FULL, "20", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,      FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 3 },  { 0, 0 }, RDIM/2 },
     // ==========================================
     // TestType,      Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
     { BOOTSTRAP_EDGE, "01", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 0, 0 }, RDIM/4 },
@@ -199,6 +217,7 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_SPARSE, "07", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 8, 8 }, 8 },
     { BOOTSTRAP_SPARSE, "08", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FLEXIBLEAUTOEXT, NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 8, 8 }, 8 },
 #endif
+    { BOOTSTRAP_SPARSE, "09", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,      FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 8, 8 }, 8 },
     // ==========================================
     // TestType,        Descr, Scheme,          RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
     { BOOTSTRAP_SPARSE, "11", {CKKSRNS_SCHEME,  RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 }, 8 },
@@ -312,6 +331,20 @@ static std::vector<TEST_CASE_UTCKKSRNS_BOOT> testCases = {
     { BOOTSTRAP_SERIALIZE, "04", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/2 },
     { BOOTSTRAP_SERIALIZE, "05", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 4, 4 },   RDIM/2 },
     { BOOTSTRAP_SERIALIZE, "06", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 4, 4 },   RDIM/2 },
+    { BOOTSTRAP_SERIALIZE, "07", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,      FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/2 },
+    // ==========================================
+    // TestType,              Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,       Slots
+    { BOOTSTRAP_PRECOM_STORE, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 1, 1 },  { 32, 32 }, RDIM/2 },
+    { BOOTSTRAP_PRECOM_STORE, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 },   RDIM/2 },
+    // ==========================================
+    // TestType,      Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,      MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_LAZY, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 3, 2 },  { 0, 0 }, RDIM/2 },
+    { BOOTSTRAP_LAZY, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,  DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 }, 8 },
+    // ==========================================
+    // TestType,       Descr, Scheme,         RDim, MultDepth,  SModSize,     DSize, BatchSz, SecKeyDist,          MaxRelinSkDeg, FModSize,  SecLvl,       KSTech, ScalTech,        LDigits,      PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, LvlBudget, Dim1,     Slots
+    { BOOTSTRAP_BATCH, "01", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    UNIFORM_TERNARY,     DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 }, RDIM/2 },
+    { BOOTSTRAP_BATCH, "02", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_TERNARY,      DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDMANUAL,     NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 }, 8 },
+    { BOOTSTRAP_BATCH, "03", {CKKSRNS_SCHEME, RDIM, MULT_DEPTH, SMODSIZE,     DFLT,  DFLT,    SPARSE_ENCAPSULATED, DFLT,          FMODSIZE,  HEStd_NotSet, HYBRID, FIXEDAUTO,       NUM_LRG_DIGS, DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   { 2, 2 },  { 0, 0 }, RDIM/2 },
     // ==========================================
 };
 // clang-format on
@@ -352,7 +385,8 @@ protected:
         try {
             CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
 
-            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots, 0, true,
+                                   testData.testCaseType == BOOTSTRAP_LAZY);
 
             auto keyPair = cc->KeyGen();
             cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
@@ -654,6 +688,28 @@ protected:
             ccInit->EvalMultKeyGen(keyPairInit.secretKey);
             ccInit->EvalBootstrapKeyGen(keyPairInit.secretKey, testData.slots);
             ccInit->EvalBootstrapKeyGen(keyPairInit.secretKey, testData.slots / 2);
+
+            const bool encapsulated = (testData.params.secretKeyDist == SPARSE_ENCAPSULATED);
+            if (encapsulated) {
+                // the encapsulation keys are kept apart from the automorphism keys; the dense-to-sparse key
+                // only has q_0 and one prime that is not in Q*P
+                const auto keyTag = keyPairInit.secretKey->GetKeyTag();
+                auto keyMap       = ccInit->GetEvalAutomorphismKeyMap(keyTag);
+                EXPECT_TRUE(keyMap->find(0) == keyMap->end() && keyMap->find(2) == keyMap->end())
+                    << failmsg << " encapsulation keys are stored as automorphism keys";
+
+                auto encapsulationKeys = ccInit->GetEvalEncapsulationKeyVector(keyTag);
+                EXPECT_EQ(encapsulationKeys.size(), size_t(CKKS_ENCAPSULATION_KEYS::TOTAL_ELEMENTS)) << failmsg;
+                const auto& denseToSparse = encapsulationKeys[CKKS_ENCAPSULATION_KEYS::DENSE_TO_SPARSE];
+                const auto& towers        = denseToSparse->GetBVector()[0].GetParams()->GetParams();
+                const auto cryptoParams =
+                    std::dynamic_pointer_cast<CryptoParametersRNS>(ccInit->GetCryptoParameters());
+                ASSERT_EQ(towers.size(), 2u) << failmsg << " dense-to-sparse key is not over {q_0, p}";
+                EXPECT_EQ(towers[0]->GetModulus(), cryptoParams->GetElementParams()->GetParams()[0]->GetModulus())
+                    << failmsg;
+                for (const auto& tower : cryptoParams->GetParamsQP()->GetParams())
+                    EXPECT_NE(towers[1]->GetModulus(), tower->GetModulus()) << failmsg << " auxiliary prime is in Q*P";
+            }
             //==============================================================
             // Serialize all necessary objects
             std::stringstream cc_stream;
@@ -670,6 +726,13 @@ protected:
 
             std::stringstream evalMultKey_stream;
             CryptoContextImpl<DCRTPoly>::SerializeEvalMultKey(evalMultKey_stream, SerType::BINARY);
+
+            std::stringstream encapsulationKey_stream;
+            if (encapsulated) {
+                EXPECT_TRUE(CryptoContextImpl<DCRTPoly>::SerializeEvalEncapsulationKey(encapsulationKey_stream,
+                                                                                        SerType::BINARY))
+                    << failmsg;
+            }
             //====================================================================================================
             // Removed the serialized objects from the memory
             CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
@@ -686,6 +749,8 @@ protected:
             Serial::Deserialize(keyPair.publicKey, publicKey_stream, SerType::BINARY);
             CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey(automorphismKey_stream, SerType::BINARY);
             CryptoContextImpl<DCRTPoly>::DeserializeEvalMultKey(evalMultKey_stream, SerType::BINARY);
+            if (encapsulated)
+                CryptoContextImpl<DCRTPoly>::DeserializeEvalEncapsulationKey(encapsulationKey_stream, SerType::BINARY);
 
             cc->EvalBootstrapPrecompute(testData.slots);
             cc->EvalBootstrapPrecompute(testData.slots / 2);
@@ -732,6 +797,167 @@ protected:
             std::string name("EMSCRIPTEN_UNKNOWN");
 #else
             std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_Bootstrap_PrecomStore(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                        const std::string& failmsg = std::string()) {
+        try {
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalSumKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+
+            CryptoContext<Element> ccInit(UnitTestGenerateContext(testData.params));
+            ccInit->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+            ccInit->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots / 2);
+
+            auto keyPairInit = ccInit->KeyGen();
+            ccInit->EvalMultKeyGen(keyPairInit.secretKey);
+            ccInit->EvalBootstrapKeyGen(keyPairInit.secretKey, testData.slots);
+            ccInit->EvalBootstrapKeyGen(keyPairInit.secretKey, testData.slots / 2);
+
+            const std::string filename =
+                ::testing::TempDir() + "ckksrns_bootstrap_precom_" + testData.description + ".bin";
+            ccInit->SaveBootstrapPrecomputation(filename);
+            //==============================================================
+            std::stringstream cc_stream;
+            Serial::Serialize(ccInit, cc_stream, SerType::BINARY);
+
+            std::stringstream secretKey_stream;
+            Serial::Serialize(keyPairInit.secretKey, secretKey_stream, SerType::BINARY);
+
+            std::stringstream publicKey_stream;
+            Serial::Serialize(keyPairInit.publicKey, publicKey_stream, SerType::BINARY);
+
+            std::stringstream automorphismKey_stream;
+            CryptoContextImpl<DCRTPoly>::SerializeEvalAutomorphismKey(automorphismKey_stream, SerType::BINARY);
+
+            std::stringstream evalMultKey_stream;
+            CryptoContextImpl<DCRTPoly>::SerializeEvalMultKey(evalMultKey_stream, SerType::BINARY);
+
+            CryptoContextImpl<DCRTPoly>::ClearEvalMultKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalSumKeys();
+            CryptoContextImpl<DCRTPoly>::ClearEvalAutomorphismKeys();
+            CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+            //====================================================================================================
+            // the precomputations are loaded instead of being recomputed by EvalBootstrapPrecompute
+            CryptoContext<Element> cc;
+            Serial::Deserialize(cc, cc_stream, SerType::BINARY);
+
+            KeyPair<Element> keyPair;
+            Serial::Deserialize(keyPair.secretKey, secretKey_stream, SerType::BINARY);
+            Serial::Deserialize(keyPair.publicKey, publicKey_stream, SerType::BINARY);
+            CryptoContextImpl<DCRTPoly>::DeserializeEvalAutomorphismKey(automorphismKey_stream, SerType::BINARY);
+            CryptoContextImpl<DCRTPoly>::DeserializeEvalMultKey(evalMultKey_stream, SerType::BINARY);
+
+            cc->LoadBootstrapPrecomputation(filename);
+            //====================================================================================================
+            for (uint32_t slots : {testData.slots, testData.slots / 2}) {
+                std::vector<std::complex<double>> input(
+                    Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, slots));
+                size_t encodedLength = input.size();
+
+                Plaintext plaintext  = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, slots);
+                auto ciphertext      = cc->Encrypt(keyPair.publicKey, plaintext);
+                auto ciphertextAfter = cc->EvalBootstrap(ciphertext);
+
+                Plaintext result;
+                cc->Decrypt(keyPair.secretKey, ciphertextAfter, &result);
+                result->SetLength(encodedLength);
+                plaintext->SetLength(encodedLength);
+                checkEquality(result->GetCKKSPackedValue(), plaintext->GetCKKSPackedValue(), eps,
+                              failmsg + " Bootstrapping with loaded precomputations for " + std::to_string(slots) +
+                                  " slots fails");
+            }
+            //====================================================================================================
+            // the file is rejected by contexts with other moduli or another secret key distribution
+            UnitTestCCParams otherModuli(testData.params);
+            otherModuli.multiplicativeDepth += 1;
+            UnitTestCCParams otherSecret(testData.params);
+            otherSecret.secretKeyDist =
+                (testData.params.secretKeyDist == UNIFORM_TERNARY) ? SPARSE_TERNARY : UNIFORM_TERNARY;
+            for (const auto& params : {otherModuli, otherSecret}) {
+                // the secret key distribution is not part of the context lookup, so a cached context would be reused
+                CryptoContextFactory<DCRTPoly>::ReleaseAllContexts();
+                CryptoContext<Element> ccOther(UnitTestGenerateContext(params));
+                EXPECT_THROW(ccOther->LoadBootstrapPrecomputation(filename), OpenFHEException)
+                    << failmsg << " precomputations loaded into a context with " << params;
+            }
+            std::remove(filename.c_str());
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_Bootstrap_Batch(const TEST_CASE_UTCKKSRNS_BOOT& testData,
+                                  const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            cc->EvalBootstrapSetup(testData.levelBudget, testData.dim1, testData.slots);
+
+            auto keyPair = cc->KeyGen();
+            cc->EvalBootstrapKeyGen(keyPair.secretKey, testData.slots);
+            cc->EvalMultKeyGen(keyPair.secretKey);
+
+            const std::vector<std::vector<std::complex<double>>> inputs = {
+                Fill({0.111111, 0.222222, 0.333333, 0.444444, 0.555555, 0.666666, 0.777777, 0.888888}, testData.slots),
+                Fill({-0.5, 0.25, -0.125, 0.0625}, testData.slots),
+                Fill({0.3, -0.7}, testData.slots),
+            };
+
+            std::vector<Ciphertext<Element>> ciphertexts;
+            for (const auto& input : inputs) {
+                Plaintext plaintext = cc->MakeCKKSPackedPlaintext(input, 1, MULT_DEPTH - 1, nullptr, testData.slots);
+                ciphertexts.push_back(cc->Encrypt(keyPair.publicKey, plaintext));
+            }
+
+            auto ciphertextsAfter = cc->EvalBootstrapBatch(ciphertexts);
+            ASSERT_EQ(ciphertextsAfter.size(), inputs.size()) << failmsg;
+
+            // every ciphertext of the batch is refreshed, and the results are in the order of the input
+            for (size_t i = 0; i < inputs.size(); ++i) {
+                Plaintext result;
+                cc->Decrypt(keyPair.secretKey, ciphertextsAfter[i], &result);
+                result->SetLength(inputs[i].size());
+                checkEquality(result->GetCKKSPackedValue(), inputs[i], eps,
+                              failmsg + " Batched bootstrapping fails for ciphertext " + std::to_string(i));
+            }
+
+            EXPECT_TRUE(cc->EvalBootstrapBatch({}).empty()) << failmsg;
+
+            // a missing key is reported as an exception, also when the ciphertexts are bootstrapped in parallel
+            CryptoContextImpl<Element>::ClearEvalAutomorphismKeys(keyPair.secretKey->GetKeyTag());
+            EXPECT_THROW(cc->EvalBootstrapBatch(ciphertexts), OpenFHEException) << failmsg;
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
 #endif
             std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
             // make it fail
@@ -749,6 +975,7 @@ TEST_P(UTCKKSRNS_BOOT, CKKSRNS) {
         case BOOTSTRAP_FULL:
         case BOOTSTRAP_EDGE:
         case BOOTSTRAP_SPARSE:
+        case BOOTSTRAP_LAZY:
             UnitTest_Bootstrap(test, test.buildTestName());
             break;
         case BOOTSTRAP_KEY_SWITCH:
@@ -763,6 +990,12 @@ TEST_P(UTCKKSRNS_BOOT, CKKSRNS) {
         case BOOTSTRAP_SERIALIZE:
             UnitTest_Bootstrap_Serialize(test, test.buildTestName());
             break;
+        case BOOTSTRAP_PRECOM_STORE:
+            UnitTest_Bootstrap_PrecomStore(test, test.buildTestName());
+            break;
+        case BOOTSTRAP_BATCH:
+            UnitTest_Bootstrap_Batch(test, test.buildTestName());
+            break;
         default:
             break;
     }
@@ -37,6 +37,7 @@
 #include "UnitTestCryptoContext.h"
 
 #include <iostream>
+#include <limits>
 #include <vector>
 #include "gtest/gtest.h"
 #include <cxxabi.h>
@@ -50,6 +51,8 @@ enum TEST_CASE_TYPE {
     EVAL_SUM_PACKED_ARRAY,
     EVAL_SUM_ROWS,
     EVAL_SUM_COLS,
+    EVAL_ROTATE_AND_ACCUMULATE,
+    EVAL_AT_INDEX_BASE_KEYS,
 };
 
 static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
@@ -67,6 +70,12 @@ static std::ostream& operator<<(std::ostream& os, const TEST_CASE_TYPE& type) {
         case EVAL_SUM_COLS:
             typeName = "EVAL_SUM_COLS";
             break;
+        case EVAL_ROTATE_AND_ACCUMULATE:
+            typeName = "EVAL_ROTATE_AND_ACCUMULATE";
+            break;
+        case EVAL_AT_INDEX_BASE_KEYS:
+            typeName = "EVAL_AT_INDEX_BASE_KEYS";
+            break;
         default:
             typeName = "UNKNOWN_UTCKKSRNS_AUTOMORPHISM";
             break;
@@ -195,6 +204,17 @@ static std::vector<TEST_CASE_UTCKKSRNS_AUTOMORPHISM> testCasesUTCKKSRNS_AUTOMORP
     // ==========================================
     // TestType,    Descr,  Scheme,         RDim,     MultDepth,  SModSize, DSize,BatchSz,    SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,  KSTech, ScalTech, LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Error,               indexList
     { EVAL_SUM_COLS, "01", {CKKSRNS_SCHEME, RING_DIM, DFLT,       DFLT,     DFLT, RING_DIM/2, DFLT,       DFLT,          DFLT,     SEC_LVL, DFLT,   DFLT,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS },
+    // ==========================================
+    // TestType,                 Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize,BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,  KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Error,               indexList
+    { EVAL_ROTATE_AND_ACCUMULATE, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH + 1, SMODSIZE, DFLT, BATCH,   DFLT,       DFLT,          DFLT,     SEC_LVL, DFLT,   FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS },
+    { EVAL_ROTATE_AND_ACCUMULATE, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH + 1, SMODSIZE, DFLT, BATCH,   DFLT,       DFLT,          DFLT,     SEC_LVL, DFLT,   FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS },
+#if NATIVEINT != 128
+    { EVAL_ROTATE_AND_ACCUMULATE, "03", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH + 1, SMODSIZE, DFLT, BATCH,   DFLT,       DFLT,          DFLT,     SEC_LVL, DFLT,   FLEXIBLEAUTO,    DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS },
+#endif
+    // ==========================================
+    // TestType,              Descr, Scheme,         RDim,     MultDepth,  SModSize, DSize,BatchSz, SecKeyDist, MaxRelinSkDeg, FModSize, SecLvl,  KSTech, ScalTech,        LDigits, PtMod, StdDev, EvalAddCt, KSCt, MultTech, EncTech, PREMode, Error,               indexList
+    { EVAL_AT_INDEX_BASE_KEYS, "01", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DFLT, BATCH,   DFLT,       DFLT,          DFLT,     SEC_LVL, DFLT,   FIXEDMANUAL,     DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS },
+    { EVAL_AT_INDEX_BASE_KEYS, "02", {CKKSRNS_SCHEME, RING_DIM, MULT_DEPTH, SMODSIZE, DFLT, BATCH,   DFLT,       DFLT,          DFLT,     SEC_LVL, DFLT,   FIXEDAUTO,       DFLT,    DFLT,  DFLT,   DFLT,      DFLT, DFLT,     DFLT,    DFLT},   SUCCESS },
 };
 // clang-format on
 //===========================================================================================================
@@ -465,6 +485,154 @@ protected:
             std::string name("EMSCRIPTEN_UNKNOWN");
 #else
             std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_EvalRotateAndAccumulate(const TEST_CASE_UTCKKSRNS_AUTOMORPHISM& testData,
+                                          const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+
+            const std::vector<int32_t> indices{0, 1, 2, -3};
+            const std::vector<std::vector<double>> weightValues{{1.0, 0.5, 0.0, -1.0, 2.0, 0.25, 1.0, -0.5},
+                                                                {0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5, 0.5},
+                                                                {-1.0, 0.0, 1.0, 0.0, -1.0, 0.0, 1.0, 0.0},
+                                                                {0.125, 0.25, 0.375, 0.5, 0.625, 0.75, 0.875, 1.0}};
+            cc->EvalAtIndexKeyGen(kp.secretKey, indices);
+
+            const auto cryptoParams = std::dynamic_pointer_cast<CryptoParametersRNS>(cc->GetCryptoParameters());
+            size_t sizeQ = cryptoParams->GetElementParams()->GetParams().size();
+
+            // the last weight is encoded in the extended basis directly, the others are re-encoded
+            std::vector<ConstPlaintext> weights;
+            for (size_t i = 0; i < weightValues.size() - 1; i++)
+                weights.push_back(cc->MakeCKKSPackedPlaintext(weightValues[i]));
+            weights.push_back(
+                cc->MakeCKKSPackedPlaintext(weightValues.back(), 1, 0, cryptoParams->GetParamsQlP(sizeQ - 1)));
+
+            const int32_t slots = BATCH;
+            std::vector<std::complex<double>> expected(slots);
+            for (size_t i = 0; i < indices.size(); i++) {
+                for (int32_t j = 0; j < slots; j++) {
+                    int32_t src = ((j + indices[i]) % slots + slots) % slots;
+                    expected[j] += weightValues[i][j] * vector8Complex[src];
+                }
+            }
+
+            auto ciphertext = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vector8Complex));
+            auto result     = cc->EvalRotateAndAccumulate(ciphertext, indices, weights);
+
+            Plaintext ptResult;
+            cc->Decrypt(kp.secretKey, result, &ptResult);
+            ptResult->SetLength(BATCH);
+            checkEquality(ptResult->GetCKKSPackedValue(), expected, EPSILON_HIGH,
+                          failmsg + " EvalRotateAndAccumulate fails - result is incorrect");
+
+            // one level down the last weight has the right basis but the scaling factor of level 0, so it is
+            // re-encoded like the others instead of being mixed with weights scaled for level 1
+            weights.back() =
+                cc->MakeCKKSPackedPlaintext(weightValues.back(), 1, 0, cryptoParams->GetParamsQlP(sizeQ - 2));
+            auto ciphertext1 = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vector8Complex, 1, 1));
+            cc->Decrypt(kp.secretKey, cc->EvalRotateAndAccumulate(ciphertext1, indices, weights), &ptResult);
+            ptResult->SetLength(BATCH);
+            checkEquality(ptResult->GetCKKSPackedValue(), expected, EPSILON_HIGH,
+                          failmsg + " EvalRotateAndAccumulate fails for a ciphertext below the top level");
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
+#endif
+            std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+    }
+
+    void UnitTest_EvalAtIndexBaseKeys(const TEST_CASE_UTCKKSRNS_AUTOMORPHISM& testData,
+                                      const std::string& failmsg = std::string()) {
+        try {
+            CryptoContext<Element> cc(UnitTestGenerateContext(testData.params));
+
+            KeyPair<Element> kp = cc->KeyGen();
+
+            // none of these rotations gets a dedicated key with a zero budget
+            const std::vector<int32_t> indices{3, 5, -7, 6};
+            cc->EvalAtIndexBaseKeyGen(kp.secretKey, indices);
+
+            uint32_t M = cc->GetCyclotomicOrder();
+            auto planned =
+                LeveledSHEBase<Element>::PlanRotationKeys(indices, M, 1, std::numeric_limits<uint64_t>::max());
+            // +2^k and -2^k for every power of two below m/4; the rotations by m/8 and -m/8 are the same
+            const size_t baseSize = 2 * (GetMSB(M / 4) - 1) - 1;
+            // -7 is the rotation by 1 and 6 the rotation by -2, both are already in the base set
+            EXPECT_EQ(planned.size(), baseSize + 2) << failmsg << " PlanRotationKeys fails";
+            auto baseOnly = LeveledSHEBase<Element>::PlanRotationKeys(indices, M, 1, 0);
+            EXPECT_EQ(baseOnly.size(), baseSize) << failmsg << " PlanRotationKeys ignores the budget";
+
+            // indices outside (-m/4, m/4) are reduced modulo m/4 before planning and composing
+            const int32_t order = M / 4;
+            const std::vector<int32_t> wrapped{3 + order, -3 - 2 * order, -7 - order, 2 * order};
+            auto plannedWrapped =
+                LeveledSHEBase<Element>::PlanRotationKeys(wrapped, M, 1, std::numeric_limits<uint64_t>::max());
+            // 3 + order and -3 - 2 * order get one key each, the others reduce to rotations by 1 and 0
+            EXPECT_EQ(plannedWrapped.size(), baseSize + 2) << failmsg << " PlanRotationKeys fails to reduce";
+            for (int32_t rotation : plannedWrapped)
+                EXPECT_TRUE(rotation > 0 && rotation < order) << failmsg << " planned rotation " << rotation;
+
+            auto ciphertext = cc->Encrypt(kp.publicKey, cc->MakeCKKSPackedPlaintext(vector8Complex));
+
+            const int32_t slots = BATCH;
+            std::vector<int32_t> evaluated(indices);
+            evaluated.insert(evaluated.end(), wrapped.begin(), wrapped.end());
+            for (int32_t index : evaluated) {
+                std::vector<std::complex<double>> expected(slots);
+                for (int32_t j = 0; j < slots; j++)
+                    expected[j] = vector8Complex[((j + index) % slots + slots) % slots];
+
+                Plaintext ptResult;
+                cc->Decrypt(kp.secretKey, cc->EvalAtIndex(ciphertext, index), &ptResult);
+                ptResult->SetLength(BATCH);
+                checkEquality(ptResult->GetCKKSPackedValue(), expected, EPSILON_HIGH,
+                              failmsg + " EvalAtIndex with composed keys fails for index " + std::to_string(index));
+            }
+
+            // hoisted rotations in the extended basis fall back to composition as well
+            std::vector<ConstPlaintext> weights(indices.size(),
+                                                cc->MakeCKKSPackedPlaintext(std::vector<double>(BATCH, 1.0)));
+            std::vector<std::complex<double>> expected(slots);
+            for (int32_t index : indices)
+                for (int32_t j = 0; j < slots; j++)
+                    expected[j] += vector8Complex[((j + index) % slots + slots) % slots];
+
+            Plaintext ptResult;
+            cc->Decrypt(kp.secretKey, cc->EvalRotateAndAccumulate(ciphertext, indices, weights), &ptResult);
+            ptResult->SetLength(BATCH);
+            checkEquality(ptResult->GetCKKSPackedValue(), expected, EPSILON_HIGH,
+                          failmsg + " EvalRotateAndAccumulate with composed keys fails");
+        }
+        catch (std::exception& e) {
+            std::cerr << "Exception thrown from " << __func__ << "(): " << e.what() << std::endl;
+            // make it fail
+            EXPECT_TRUE(0 == 1) << failmsg;
+        }
+        catch (...) {
+#if defined EMSCRIPTEN
+            std::string name("EMSCRIPTEN_UNKNOWN");
+#else
+            std::string name(demangle(__cxxabiv1::__cxa_current_exception_type()->name()));
 #endif
             std::cerr << "Unknown exception of type \"" << name << "\" thrown from " << __func__ << "()" << std::endl;
             // make it fail
@@ -490,6 +658,12 @@ TEST_P(UTCKKSRNS_AUTOMORPHISM, Automorphism) {
         case EVAL_SUM_COLS:
             UnitTest_EvalSumCols(test, test.buildTestName());
             break;
+        case EVAL_ROTATE_AND_ACCUMULATE:
+            UnitTest_EvalRotateAndAccumulate(test, test.buildTestName());
+            break;
+        case EVAL_AT_INDEX_BASE_KEYS:
+            UnitTest_EvalAtIndexBaseKeys(test, test.buildTestName());
+            break;
         default:
             break;
     }
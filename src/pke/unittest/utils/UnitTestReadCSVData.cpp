@@ -1,3 +1,4 @@
+#include <cxxabi.h>
 //==================================================================================
 // BSD 2-Clause License
 //
@@ -71,7 +71,7 @@ public:
             if (pr.passed())
                 continue;
 
-            internal::ColoredPrintf(internal::COLOR_GREEN, "[ RUN      ] ");
+            printf("[ RUN      ] ");
             printf("%s.%s\n", test_info.test_case_name(), test_info.name());
             fflush(stdout);
 
@@ -81,7 +81,7 @@ public:
 
             cout << pr.summary() << endl;
 
-            internal::ColoredPrintf(internal::COLOR_RED, "[  FAILED  ] ");
+            printf("[  FAILED  ] ");
             printf("%s.%s\n", test_info.test_case_name(), test_info.name());
             fflush(stdout);
             internal::PrintFullTestCommentIfPresent(test_info);
@@ -111,7 +111,7 @@ public:
                 if (!test_info.should_run() || test_info.result()->Passed()) {
                     continue;
                 }
-                internal::ColoredPrintf(internal::COLOR_RED, "[  FAILED  ] ");
+                printf("[  FAILED  ] ");
                 printf("%s.%s", test_case.name(), test_info.name());
                 internal::PrintFullTestCommentIfPresent(test_info);
                 printf("\n");